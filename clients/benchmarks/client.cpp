@@ -29,14 +29,22 @@
 #include "hipblaslt_data.hpp"
 #include "hipblaslt_datatype2string.hpp"
 #include "hipblaslt_parse_data.hpp"
+#include "hipblaslt_trace.hpp"
 #include "utility.hpp"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 #include "frequency_monitor.hpp"
@@ -243,10 +251,160 @@ void hipblaslt_print_version(void)
     hipblaslt_cout << "hipBLASLt git version: " << git_version << std::endl;
 }
 
-int main(int argc, char* argv[])
+// Library and device information attached to every structured log record
+void hipblaslt_set_log_provenance(int device_id)
+{
+    int                    version;
+    char                   git_version[128];
+    hipDeviceProp_t        props;
+    hipblaslt_local_handle handle;
+    hipblasLtGetVersion(handle, &version);
+    hipblasLtGetGitRevision(handle, &git_version[0]);
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, device_id));
+
+    ArgumentModel_set_log_provenance({{"hipblaslt_version", std::to_string(version)},
+                                      {"hipblaslt_git_version", git_version},
+                                      {"device_id", std::to_string(device_id)},
+                                      {"device_name", props.name},
+                                      {"arch", props.gcnArchName},
+                                      {"cu_count", std::to_string(props.multiProcessorCount)}});
+}
+
+// Command line options reproducing a problem of a shape trace
+std::vector<std::string> trace_record_to_options(const hipblaslt_trace_record& r)
+{
+    std::vector<std::string> options;
+    auto option = [&](const char* name, std::string value) {
+        options.push_back(name);
+        options.push_back(std::move(value));
+    };
+    auto type = [](int32_t t) { return std::string(hip_datatype_to_string(hipDataType(t))); };
+
+    option("--api_method", r.flags & HIPBLASLT_TRACE_CPP_API ? "cpp" : "c");
+    option("-m", std::to_string(r.m));
+    option("-n", std::to_string(r.n));
+    option("-k", std::to_string(r.k));
+    option("--batch_count", std::to_string(r.batch_count));
+    option("--lda", std::to_string(r.lda));
+    option("--ldb", std::to_string(r.ldb));
+    option("--ldc", std::to_string(r.ldc));
+    option("--ldd", std::to_string(r.ldd));
+    option("--stride_a", std::to_string(r.stride_a));
+    option("--stride_b", std::to_string(r.stride_b));
+    option("--stride_c", std::to_string(r.stride_c));
+    option("--stride_d", std::to_string(r.stride_d));
+    option("--alpha", std::to_string(r.alpha));
+    option("--beta", std::to_string(r.beta));
+    option("--transA", r.flags & HIPBLASLT_TRACE_TRANS_A ? "T" : "N");
+    option("--transB", r.flags & HIPBLASLT_TRACE_TRANS_B ? "T" : "N");
+    option("--a_type", type(r.a_type));
+    option("--b_type", type(r.b_type));
+    option("--c_type", type(r.c_type));
+    option("--d_type", type(r.d_type));
+    option("--scale_type", type(r.scale_type));
+    option("--compute_type", hipblas_computetype_to_string(hipblasComputeType_t(r.compute_type)));
+    option("--scaleA", std::to_string(r.scale_a));
+    option("--scaleB", std::to_string(r.scale_b));
+    option("--activation_type",
+           r.activation == HIPBLASLT_TRACE_ACTIVATION_RELU   ? "relu"
+           : r.activation == HIPBLASLT_TRACE_ACTIVATION_GELU ? "gelu"
+                                                             : "none");
+    if(r.flags & HIPBLASLT_TRACE_USE_E)
+    {
+        options.push_back("--use_e");
+        option("--lde", std::to_string(r.lde));
+        option("--stride_e", std::to_string(r.stride_e));
+    }
+    if(r.flags & HIPBLASLT_TRACE_BIAS)
+    {
+        options.push_back("--bias_vector");
+        option("--bias_type", type(r.bias_type));
+        option("--bias_source", r.bias_source == 0 ? "a" : r.bias_source == 1 ? "b" : "d");
+    }
+    if(r.flags & HIPBLASLT_TRACE_SCALE_ALPHA_VEC)
+        options.push_back("--scaleAlpha_vector");
+    if(r.flags & HIPBLASLT_TRACE_GRADIENT)
+        options.push_back("--gradient");
+    if(r.splitk)
+        option("--splitk", std::to_string(r.splitk));
+    if(r.wgm)
+        option("--wgm", std::to_string(r.wgm));
+    return options;
+}
+
+// Reads the problems of a --problems file, either a shape trace written with
+// HIPBLASLT_TRACE_FILE or a text file of hipblaslt-bench command lines such as the
+// HIPBLASLT_LOG_MASK=32 bench log. Repeated problems are kept once.
+bool read_problem_list(const std::string& path, std::vector<std::vector<std::string>>& problems)
+{
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+    {
+        hipblaslt_cerr << "Cannot open problem list " << path << std::endl;
+        return false;
+    }
+
+    std::set<std::vector<std::string>> seen;
+    auto add = [&](std::vector<std::string> options) {
+        if(!options.empty() && seen.insert(options).second)
+            problems.push_back(std::move(options));
+    };
+
+    hipblaslt_trace_header header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if(file && memcmp(header.magic, HIPBLASLT_TRACE_MAGIC, sizeof(HIPBLASLT_TRACE_MAGIC)) == 0)
+    {
+        if(header.version != HIPBLASLT_TRACE_VERSION
+           || header.record_size != sizeof(hipblaslt_trace_record))
+        {
+            hipblaslt_cerr << path << " has trace version " << header.version
+                           << ", expected version " << HIPBLASLT_TRACE_VERSION << std::endl;
+            return false;
+        }
+        hipblaslt_trace_record record;
+        uint64_t               dropped = 0;
+        while(file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        {
+            if(record.flags & HIPBLASLT_TRACE_DROPPED)
+            {
+                dropped += record.m;
+                continue;
+            }
+            // The bench has no dgelu epilogue
+            if(record.activation == HIPBLASLT_TRACE_ACTIVATION_DGELU)
+                continue;
+            add(trace_record_to_options(record));
+        }
+        if(dropped)
+            hipblaslt_cerr << path << " is incomplete, the library dropped " << dropped
+                           << " calls while recording it" << std::endl;
+        return true;
+    }
+
+    file.clear();
+    file.seekg(0);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        size_t pos = line.find("hipblaslt-bench ");
+        if(pos == std::string::npos)
+            continue;
+        std::istringstream       tokens(line.substr(pos + strlen("hipblaslt-bench ")));
+        std::vector<std::string> options;
+        for(std::string token; tokens >> token;)
+        {
+            // The library logs scaleC/scaleD, which the bench has no option for
+            if(token != "--scaleC" && token != "--scaleD")
+                options.push_back(token);
+        }
+        add(std::move(options));
+    }
+    return true;
+}
+
+int run_bench_command(int argc, char* argv[], bool print_info)
 try
 {
-    fix_batch(argc, argv);
     Arguments   arg;
     std::string function;
     std::string precision;
@@ -269,6 +427,11 @@ try
     int         flags             = 0;
     bool        datafile          = hipblaslt_parse_data(argc, argv);
     bool        log_function_name = false;
+    std::string output_format;
+    std::string output_file;
+    std::string problems_file;
+    std::string devices_list;
+    std::string tuning_report;
     bool        any_stride        = false;
 
     int         api_method      = 0;
@@ -289,7 +452,8 @@ try
         bool tuning_success = tuning_path_compare_git_version(tuningEnv);
         if(tuning_success)
         {
-            hipblaslt_cout << "HIPBLASLT_TUNING_FILE is the correct setting." << std::endl;
+            if(print_info)
+                hipblaslt_cout << "HIPBLASLT_TUNING_FILE is the correct setting." << std::endl;
         }
         else
             return 1;
@@ -525,6 +689,15 @@ try
          bool_switch(&log_function_name)->default_value(false),
          "Function name precedes other items.")
 
+        ("output_format",
+         value<std::string>(&output_format)->default_value("text"),
+         "Format of the result records. Options: text, json (one object per line), csv. "
+         "Structured records carry the full problem, solution, timing and device information.")
+
+        ("output_file",
+         value<std::string>(&output_file)->default_value(""),
+         "Write json or csv records to this file instead of replacing the text output.")
+
         ("function_filter",
          value<std::string>(&filter),
          "Simple strstr filter on function name only without wildcards")
@@ -564,6 +737,57 @@ try
         value<bool>(&arg.flush)->default_value(tuningEnv ? true : false),
         "Flush icache, only works for gemm.")
 
+        ("timing_stats",
+         value<bool>(&arg.timing_stats)->default_value(false),
+         "Time every hot iteration with GPU events and report median, p5/p95, stddev and the 95% "
+         "confidence interval. The median is used as the reported time.")
+
+        ("timing_ci",
+         value<float>(&arg.timing_ci)->default_value(0.0),
+         "With --timing_stats, keep running rounds of iters hot calls until the 95% confidence "
+         "interval half-width is below this fraction of the median, e.g. 0.01. 0 means one round.")
+
+        ("timing_budget_ms",
+         value<float>(&arg.timing_budget_ms)->default_value(1000.0),
+         "With --timing_ci, stop adding rounds after this much wall time (ms) per solution.")
+
+        ("print_roofline",
+         bool_switch(&arg.print_roofline)->default_value(false),
+         "Print the roofline time, efficiency and bound estimated by the heuristic next to the "
+         "measured time of each solution.")
+
+        ("deterministic",
+         bool_switch(&arg.deterministic)->default_value(false),
+         "Only use solutions whose results are bitwise identical from run to run.")
+
+        ("audit_determinism",
+         value<int32_t>(&arg.audit_determinism)->default_value(0),
+         "Run each timed solution this many more times and report whether D is bitwise identical "
+         "across the runs, with the throughput of the best deterministic solution. 0 is off.")
+
+        ("problems",
+         value<std::string>(&problems_file),
+         "File of problems to run one after another: hipblaslt-bench command lines (e.g. a "
+         "HIPBLASLT_LOG_MASK=32 log) or a HIPBLASLT_TRACE_FILE shape trace. Options given on this "
+         "command line override those of the file. With --devices, give one list for all devices "
+         "or one --problems per device.")
+
+        ("devices",
+         value<std::string>(&devices_list),
+         "Run on several devices at once, 'all' or a comma separated list of device ids, with one "
+         "host thread and its own streams per device. Prints the throughput and clocks of every "
+         "device and of the node at the end.")
+
+        ("tuning_report",
+         value<std::string>(&tuning_report)->default_value(""),
+         "Write one csv line per tuned problem with the default and the best solution and the "
+         "speedup, and print a summary at the end.")
+
+        ("tuning_budget_ms",
+         value<float>(&arg.tuning_budget_ms)->default_value(0.0),
+         "Wall time budget (ms) for trying the solutions of one problem. The default heuristic "
+         "solution is always timed first. 0 means no limit.")
+
         ("help,h", "produces this help message")
 
         ("version", "Prints the version number");
@@ -580,7 +804,8 @@ try
         return 0;
     }
 
-    hipblaslt_print_version();
+    if(print_info)
+        hipblaslt_print_version();
 
     if(vm.find("version") != vm.end())
     {
@@ -670,8 +895,20 @@ try
         return 1;
     }
 
-    // transfer local variable state
-    ArgumentModel_set_log_function_name(log_function_name);
+    // transfer local variable state; --log_function_name is applied by main, before the
+    // threads of --devices start
+    if(output_format == "text")
+        ArgumentModel_set_log_format(ArgumentModel_log_format_t::text, "");
+    else if(output_format == "json")
+        ArgumentModel_set_log_format(ArgumentModel_log_format_t::json, output_file);
+    else if(output_format == "csv")
+        ArgumentModel_set_log_format(ArgumentModel_log_format_t::csv, output_file);
+    else
+    {
+        hipblaslt_cerr << "Invalid output format: " << output_format << std::endl;
+        return 1;
+    }
+    ArgumentModel_set_tuning_report(tuning_report);
 
     // Fill in the sizes to arguments
     size_t length = 1;
@@ -740,6 +977,8 @@ try
     if(device_count <= device_id)
         throw std::invalid_argument("Invalid Device ID");
     set_device(device_id);
+    if(output_format != "text")
+        hipblaslt_set_log_provenance(device_id);
 
     FrequencyMonitor& freq_monitor = getFrequencyMonitor();
     freq_monitor.set_device_id(device_id);
@@ -846,6 +1085,9 @@ try
         throw std::invalid_argument(
             "Valid value for --skip_slow_solution_ratio is in range (0.0 ~ 1.0).");
 
+    if(arg.tuning_budget_ms < 0)
+        throw std::invalid_argument("Invalid value for --tuning_budget_ms");
+
     if(verify)
     {
         arg.norm_check     = 1;
@@ -881,3 +1123,228 @@ catch(const std::invalid_argument& exp)
     hipblaslt_cerr << exp.what() << std::endl;
     return -1;
 }
+
+// Run the problems one after another, each as a separate bench command. The options of
+// args and extra override those of the problem; an empty problem runs args alone.
+int run_problem_list(std::vector<std::vector<std::string>> problems,
+                     const std::vector<char*>&             args,
+                     std::vector<std::string>              extra,
+                     const std::string&                    prefix,
+                     bool                                  print_info)
+{
+    int status = 0;
+    for(size_t p = 0; p < problems.size(); ++p)
+    {
+        if(!problems[p].empty())
+            hipblaslt_cout << prefix << "Problem " << p + 1 << " of " << problems.size()
+                           << std::endl;
+        std::vector<char*> problem_args{args[0]};
+        for(auto& option : problems[p])
+            problem_args.push_back(&option[0]);
+        problem_args.insert(problem_args.end(), args.begin() + 1, args.end());
+        for(auto& option : extra)
+            problem_args.push_back(&option[0]);
+        problem_args.push_back(nullptr);
+        status |= run_bench_command(
+            int(problem_args.size() - 1), problem_args.data(), print_info && p == 0);
+    }
+    return status;
+}
+
+// Parse the device list of --devices, "all" or comma separated device ids
+bool parse_device_list(const std::string& list, std::vector<int>& devices)
+{
+    int count = 0;
+    if(hipGetDeviceCount(&count) != hipSuccess || count == 0)
+    {
+        hipblaslt_cerr << "No devices found" << std::endl;
+        return false;
+    }
+    if(list == "all")
+    {
+        for(int d = 0; d < count; d++)
+            devices.push_back(d);
+        return true;
+    }
+
+    std::istringstream tokens(list);
+    for(std::string token; std::getline(tokens, token, ',');)
+    {
+        char* end;
+        long  device = strtol(token.c_str(), &end, 10);
+        if(token.empty() || *end || device < 0 || device >= count
+           || std::find(devices.begin(), devices.end(), device) != devices.end())
+        {
+            hipblaslt_cerr << "Invalid --devices entry '" << token << "', " << count
+                           << " devices are visible" << std::endl;
+            return false;
+        }
+        devices.push_back(int(device));
+    }
+    return !devices.empty();
+}
+
+// --devices: run the problem lists on several devices at once from one host thread per
+// device. Every thread creates its own handle and streams through the regular bench path;
+// the threads start timing together once all device contexts exist.
+int run_multi_device(const std::vector<int>&                                      devices,
+                     const std::vector<std::vector<std::vector<std::string>>>& lists,
+                     const std::vector<char*>&                                    args)
+{
+    struct device_run
+    {
+        int                                   status = 0;
+        std::string                           name;
+        std::chrono::steady_clock::time_point begin;
+        double                                wall_ms = 0;
+        ArgumentModel_totals                  totals;
+    };
+    std::vector<device_run>  runs(devices.size());
+    std::vector<std::thread> threads;
+    std::mutex               mutex;
+    std::condition_variable  start;
+    size_t                   ready = 0;
+
+    for(size_t d = 0; d < devices.size(); d++)
+    {
+        threads.emplace_back([&, d]() {
+            hipDeviceProp_t props;
+            CHECK_HIP_ERROR(hipSetDevice(devices[d]));
+            CHECK_HIP_ERROR(hipGetDeviceProperties(&props, devices[d]));
+            runs[d].name = std::string(props.name) + " " + props.gcnArchName;
+
+            // Setup, initialization and warm-up run at their own pace; every device starts
+            // its first timed loop when all devices reached theirs, or finished without one
+            runs[d].begin = std::chrono::steady_clock::now();
+            ArgumentModel_set_timing_start_hook([&, d]() {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if(++ready == devices.size())
+                        start.notify_all();
+                    else
+                        start.wait(lock, [&] { return ready == devices.size(); });
+                }
+                runs[d].begin = std::chrono::steady_clock::now();
+            });
+
+            runs[d].status = run_problem_list(lists.size() == 1 ? lists[0] : lists[d],
+                                              args,
+                                              {"--device", std::to_string(devices[d])},
+                                              "Device " + std::to_string(devices[d]) + ": ",
+                                              d == 0);
+            ArgumentModel_timing_start();
+            runs[d].wall_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - runs[d].begin)
+                                  .count();
+            runs[d].totals = ArgumentModel_get_totals();
+            freeFrequencyMonitor();
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    // Throughput of a device is its work over its GPU time; the devices ran concurrently,
+    // so the node throughput is their sum
+    int    status     = 0;
+    bool   clocks     = false;
+    double node_gflop = 0, node_gflops = 0, node_wall_ms = 0;
+    hipblaslt_cout << "\nMulti-device summary\n"
+                   << "device,name,problems,gflop,gpu-us,Gflops,wall-ms,avg-lowest-freq,avg-MCLK"
+                   << std::endl;
+    for(size_t d = 0; d < devices.size(); d++)
+    {
+        auto&  t      = runs[d].totals;
+        double gflops = t.gpu_us > 0 ? t.gflop / t.gpu_us * 1e6 : 0;
+        hipblaslt_cout << devices[d] << "," << runs[d].name << "," << t.problems << "," << t.gflop
+                       << "," << t.gpu_us << "," << gflops << "," << runs[d].wall_ms << ",";
+        if(t.clock_samples)
+            hipblaslt_cout << t.sysclk_mhz / t.clock_samples << ","
+                           << t.memclk_mhz / t.clock_samples;
+        else
+            hipblaslt_cout << "-,-";
+        hipblaslt_cout << std::endl;
+
+        status |= runs[d].status;
+        clocks |= t.clock_samples > 0;
+        node_gflop += t.gflop;
+        node_gflops += gflops;
+        node_wall_ms = std::max(node_wall_ms, runs[d].wall_ms);
+    }
+    hipblaslt_cout << "all," << devices.size() << " devices,-," << node_gflop << ",-,"
+                   << node_gflops << "," << node_wall_ms << ",-,-" << std::endl;
+    if(!clocks)
+        hipblaslt_cout << "Set HIPBLASLT_BENCH_FREQ=1 for the device clocks" << std::endl;
+    return status;
+}
+
+int main(int argc, char* argv[])
+{
+    fix_batch(argc, argv);
+
+    // --problems and --devices are handled here, every problem of a list is a separate bench
+    // command
+    std::vector<std::string> problem_files;
+    std::string              devices_list;
+    std::vector<char*>       args;
+    for(int i = 0; i < argc; ++i)
+    {
+        if(i > 0 && !strcmp(argv[i], "--problems") && i + 1 < argc)
+            problem_files.push_back(argv[++i]);
+        else if(i > 0 && !strcmp(argv[i], "--devices") && i + 1 < argc)
+            devices_list = argv[++i];
+        else
+            args.push_back(argv[i]);
+    }
+    ArgumentModel_set_log_function_name(std::any_of(
+        args.begin() + 1, args.end(), [](char* a) { return !strcmp(a, "--log_function_name"); }));
+
+    // One list for every device, or one list per device
+    std::vector<std::vector<std::vector<std::string>>> lists;
+    for(auto& file : problem_files)
+    {
+        lists.emplace_back();
+        if(!read_problem_list(file, lists.back()))
+            return 1;
+    }
+    if(lists.empty())
+        lists.push_back({{}});
+
+    int status = 0;
+    if(devices_list.empty())
+    {
+        if(lists.size() > 1)
+        {
+            hipblaslt_cerr << "Several --problems lists need --devices" << std::endl;
+            return 1;
+        }
+        if(problem_files.empty())
+            status = run_bench_command(argc, argv, true);
+        else
+            status = run_problem_list(lists[0], args, {}, "", true);
+    }
+    else
+    {
+        for(auto arg : args)
+        {
+            if(!strcmp(arg, "--device") || !strcmp(arg, "--yaml") || !strcmp(arg, "--data"))
+            {
+                hipblaslt_cerr << arg << " cannot be combined with --devices" << std::endl;
+                return 1;
+            }
+        }
+        std::vector<int> devices;
+        if(!parse_device_list(devices_list, devices))
+            return 1;
+        if(lists.size() != 1 && lists.size() != devices.size())
+        {
+            hipblaslt_cerr << "Give one --problems list for all devices or one per device, "
+                           << devices.size() << " devices but " << lists.size() << " lists"
+                           << std::endl;
+            return 1;
+        }
+        status = run_multi_device(devices, lists, args);
+    }
+
+    ArgumentModel_print_tuning_summary(hipblaslt_cout);
+    return status;
+}
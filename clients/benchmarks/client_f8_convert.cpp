@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <hipblaslt/hipblaslt.h>
+#include <hipblaslt_f8_convert.hpp>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+void printUsage(char* programName)
+{
+    std::cout << "Usage: " << programName << " <options>\n"
+              << "options:\n"
+              << "\t-h, --help\t\t\tShow this help message\n"
+              << "\t-n, --n\t\t\t\tNumber of elements, default is 67108864\n"
+              << "\t-i, --iters\t\t\tNumber of timed iterations, default is 10\n"
+              << "\t--stochastic\t\t\tAlso time stochastic rounding encode\n";
+}
+
+int parseArgs(int argc, char** argv, size_t& n, int& iters, bool& stochastic)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if(arg.at(0) == '-')
+        {
+            if((arg == "-h") || (arg == "--help"))
+            {
+                return EXIT_FAILURE;
+            }
+            else if(arg == "-n" || arg == "--n")
+            {
+                n = std::stoul(argv[++i]);
+            }
+            else if(arg == "-i" || arg == "--iters")
+            {
+                iters = std::stoi(argv[++i]);
+            }
+            else if(arg == "--stochastic")
+            {
+                stochastic = true;
+            }
+        }
+        else
+        {
+            std::cerr << "error with " << arg << std::endl;
+            std::cerr << "option must start with - or --" << std::endl << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+template <typename Func>
+double timeGBps(Func&& func, size_t bytes, int iters)
+{
+    func(); // warm up, also builds the decode tables
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iters; i++)
+        func();
+    auto   stop = std::chrono::steady_clock::now();
+    double us   = std::chrono::duration<double, std::micro>(stop - start).count() / iters;
+    return bytes / us / 1e3;
+}
+
+void printResult(const char* type, const char* direction, const char* path, double gbps)
+{
+    std::cout << std::setw(12) << type << std::setw(10) << direction << std::setw(14) << path
+              << std::setw(12) << std::fixed << std::setprecision(2) << gbps << " GB/s"
+              << std::endl;
+}
+
+template <typename T>
+void benchType(const char* name,
+               size_t      n,
+               int         iters,
+               bool        stochastic,
+               const std::vector<float>&    src,
+               const std::vector<uint32_t>& rng)
+{
+    std::vector<T>     f8(n);
+    std::vector<float> back(n);
+    const size_t       bytes = n * (sizeof(float) + sizeof(T));
+
+    // Element-wise constructor and conversion operator, as used before the bulk API
+    printResult(name,
+                "encode",
+                "elementwise",
+                timeGBps(
+                    [&] {
+                        for(size_t i = 0; i < n; i++)
+                            f8[i] = T(src[i]);
+                    },
+                    bytes,
+                    iters));
+    printResult(name,
+                "decode",
+                "elementwise",
+                timeGBps(
+                    [&] {
+                        for(size_t i = 0; i < n; i++)
+                            back[i] = float(f8[i]);
+                    },
+                    bytes,
+                    iters));
+
+    printResult(name,
+                "decode",
+                "table",
+                timeGBps([&] { hipblaslt_f8_to_float(f8.data(), back.data(), n); }, bytes, iters));
+
+    for(auto isa : {hipblaslt_f8_cvt_isa::scalar, hipblaslt_f8_cvt_isa::avx2, hipblaslt_f8_cvt_isa::avx512})
+    {
+        if(hipblaslt_f8_set_cvt_isa(isa) != isa)
+            continue;
+        printResult(name,
+                    "encode",
+                    hipblaslt_f8_cvt_isa_to_string(isa),
+                    timeGBps([&] { hipblaslt_float_to_f8(src.data(), f8.data(), n); }, bytes, iters));
+        if(stochastic)
+            printResult(name,
+                        "encode_sr",
+                        hipblaslt_f8_cvt_isa_to_string(isa),
+                        timeGBps([&] { hipblaslt_float_to_f8(src.data(), f8.data(), n, rng.data()); },
+                                 bytes + n * sizeof(uint32_t),
+                                 iters));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t n          = 64 << 20;
+    int    iters      = 10;
+    bool   stochastic = false;
+
+    if(parseArgs(argc, argv, n, iters, stochastic))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Values spread over the whole f8 range, including denormals and saturating values
+    std::vector<float>    src(n);
+    std::vector<uint32_t> rng(n);
+    std::mt19937          gen(69069);
+    std::uniform_real_distribution<float> exponent(-20.f, 20.f);
+    for(size_t i = 0; i < n; i++)
+    {
+        src[i] = std::exp2(exponent(gen)) * ((gen() & 1) ? 1.f : -1.f);
+        rng[i] = gen();
+    }
+
+    auto defaultIsa = hipblaslt_f8_get_cvt_isa();
+    std::cout << "elements: " << n << ", iterations: " << iters
+              << ", default encode path: " << hipblaslt_f8_cvt_isa_to_string(defaultIsa)
+              << std::endl;
+
+    benchType<hipblaslt_f8_fnuz>("f8_fnuz", n, iters, stochastic, src, rng);
+    hipblaslt_f8_set_cvt_isa(defaultIsa);
+    benchType<hipblaslt_bf8_fnuz>("bf8_fnuz", n, iters, stochastic, src, rng);
+    hipblaslt_f8_set_cvt_isa(defaultIsa);
+
+    return EXIT_SUCCESS;
+}
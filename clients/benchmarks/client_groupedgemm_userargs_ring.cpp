@@ -0,0 +1,300 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Measures the per-step host overhead of a MoE style grouped gemm whose sizes change every
+// step. Each step routes a random number of tokens to every expert and runs the group with
+// new UserArguments, either copied from the host every step, written into the host slot of
+// a GroupedGemmUserArgsRing, or filled on the device by the ring from a route.
+
+#include <chrono>
+#include <cstdlib>
+#include <hip/hip_runtime.h>
+#include <hipblaslt/hipblaslt-ext.hpp>
+#include <hipblaslt/hipblaslt.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef CHECK_HIP_ERROR
+#define CHECK_HIP_ERROR(error)                    \
+    if(error != hipSuccess)                       \
+    {                                             \
+        fprintf(stderr,                           \
+                "Hip error: '%s'(%d) at %s:%d\n", \
+                hipGetErrorString(error),         \
+                error,                            \
+                __FILE__,                         \
+                __LINE__);                        \
+        exit(EXIT_FAILURE);                       \
+    }
+#endif
+
+#ifndef CHECK_HIPBLASLT_ERROR
+#define CHECK_HIPBLASLT_ERROR(error)                                                      \
+    if(error != HIPBLAS_STATUS_SUCCESS)                                                   \
+    {                                                                                     \
+        fprintf(stderr, "hipBLASLt error(Err=%d) at %s:%d\n", error, __FILE__, __LINE__); \
+        fprintf(stderr, "\n");                                                            \
+        exit(EXIT_FAILURE);                                                               \
+    }
+#endif
+
+void printUsage(char* programName)
+{
+    std::cout << "Usage: " << programName << " <options>\n"
+              << "options:\n"
+              << "\t-h, --help\t\t\tShow this help message\n"
+              << "\t-e, --experts\t\t\tNumber of experts (gemms), default is 8\n"
+              << "\t-t, --tokens\t\t\tTokens routed per step, default is 4096\n"
+              << "\t-n\t\t\t\tSize n of every expert, default is 1024\n"
+              << "\t-k\t\t\t\tSize k of every expert, default is 1024\n"
+              << "\t-s, --steps\t\t\tSteps per mode, default is 1000\n"
+              << "\t-d, --depth\t\t\tRing depth, default is 2\n";
+}
+
+int parseArgs(int      argc,
+              char**   argv,
+              int64_t& experts,
+              int64_t& tokens,
+              int64_t& n,
+              int64_t& k,
+              int&     steps,
+              size_t&  depth)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if(arg.at(0) == '-')
+        {
+            if((arg == "-h") || (arg == "--help"))
+            {
+                return EXIT_FAILURE;
+            }
+            else if(arg == "-e" || arg == "--experts")
+            {
+                experts = std::stol(argv[++i]);
+            }
+            else if(arg == "-t" || arg == "--tokens")
+            {
+                tokens = std::stol(argv[++i]);
+            }
+            else if(arg == "-n")
+            {
+                n = std::stol(argv[++i]);
+            }
+            else if(arg == "-k")
+            {
+                k = std::stol(argv[++i]);
+            }
+            else if(arg == "-s" || arg == "--steps")
+            {
+                steps = std::stoi(argv[++i]);
+            }
+            else if(arg == "-d" || arg == "--depth")
+            {
+                depth = std::stoul(argv[++i]);
+            }
+        }
+        else
+        {
+            std::cerr << "error with " << arg << std::endl;
+            std::cerr << "option must start with - or --" << std::endl << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Random split of tokens over the experts, one row of experts sizes per step
+std::vector<uint32_t> makeRoutes(int64_t experts, int64_t tokens, int steps)
+{
+    std::mt19937                       gen(42);
+    std::uniform_int_distribution<int> pick(0, experts - 1);
+    std::vector<uint32_t>              routes(steps * experts, 0);
+    for(int s = 0; s < steps; s++)
+        for(int64_t t = 0; t < tokens; t++)
+            routes[s * experts + pick(gen)]++;
+    return routes;
+}
+
+struct StepTime
+{
+    double hostUs; // time spent in the calls of a step
+    double wallUs; // time per step including the device
+};
+
+template <typename Step>
+StepTime timeSteps(int steps, hipStream_t stream, Step&& step)
+{
+    step(0); // warm up
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+    double host  = 0;
+    auto   start = std::chrono::steady_clock::now();
+    for(int s = 0; s < steps; s++)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        step(s);
+        host += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin)
+                    .count();
+    }
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    double wall
+        = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+              .count();
+    return {host / steps, wall / steps};
+}
+
+int main(int argc, char** argv)
+{
+    int64_t experts = 8;
+    int64_t tokens  = 4096;
+    int64_t n       = 1024;
+    int64_t k       = 1024;
+    int     steps   = 1000;
+    size_t  depth   = 2;
+
+    if(parseArgs(argc, argv, experts, tokens, n, k, steps, depth) || experts <= 0 || tokens <= 0
+       || steps <= 0)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    hipblasLtHandle_t handle;
+    hipStream_t       stream;
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    // Every expert gets buffers for all tokens, so only m changes from step to step
+    std::vector<int64_t>                     m(experts, tokens), nv(experts, n), kv(experts, k);
+    std::vector<int64_t>                     batch(experts, 1);
+    std::vector<hipblaslt_ext::GemmEpilogue> epilogue(experts);
+    std::vector<hipblaslt_ext::GemmInputs>   inputs(experts);
+    std::vector<void*>                       buffers;
+    float                                    alpha = 1.0f, beta = 0.0f;
+    for(int64_t i = 0; i < experts; i++)
+    {
+        void *a, *b, *d;
+        CHECK_HIP_ERROR(hipMalloc(&a, tokens * k * sizeof(hipblasLtHalf)));
+        CHECK_HIP_ERROR(hipMalloc(&b, k * n * sizeof(hipblasLtHalf)));
+        CHECK_HIP_ERROR(hipMalloc(&d, tokens * n * sizeof(hipblasLtHalf)));
+        buffers.insert(buffers.end(), {a, b, d});
+        inputs[i].a     = a;
+        inputs[i].b     = b;
+        inputs[i].c     = d;
+        inputs[i].d     = d;
+        inputs[i].alpha = &alpha;
+        inputs[i].beta  = &beta;
+    }
+
+    hipblaslt_ext::GroupedGemm groupedGemm(handle,
+                                           HIPBLAS_OP_N,
+                                           HIPBLAS_OP_N,
+                                           HIP_R_16F,
+                                           HIP_R_16F,
+                                           HIP_R_16F,
+                                           HIP_R_16F,
+                                           HIPBLAS_COMPUTE_32F);
+    CHECK_HIPBLASLT_ERROR(groupedGemm.setProblem(m, nv, kv, batch, epilogue, inputs));
+
+    uint64_t                      workspaceSize = 32 * 1024 * 1024;
+    void*                         workspace;
+    hipblaslt_ext::GemmPreference pref;
+    pref.setMaxWorkspaceBytes(workspaceSize);
+    CHECK_HIP_ERROR(hipMalloc(&workspace, workspaceSize));
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+    CHECK_HIPBLASLT_ERROR(groupedGemm.algoGetHeuristic(1, pref, heuristicResult));
+    if(heuristicResult.empty())
+    {
+        std::cerr << "No Solution found!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    CHECK_HIPBLASLT_ERROR(groupedGemm.initialize(heuristicResult[0].algo, workspace, true, stream));
+
+    auto      routes = makeRoutes(experts, tokens, steps);
+    uint32_t* dRoutes;
+    CHECK_HIP_ERROR(hipMalloc(&dRoutes, routes.size() * sizeof(uint32_t)));
+    CHECK_HIP_ERROR(hipMemcpy(
+        dRoutes, routes.data(), routes.size() * sizeof(uint32_t), hipMemcpyHostToDevice));
+
+    // Baseline: default arguments patched on the host and copied before every run
+    std::vector<hipblaslt_ext::UserArguments> hostArgs(experts);
+    hipblaslt_ext::UserArguments*             dArgs;
+    CHECK_HIPBLASLT_ERROR(groupedGemm.getDefaultValueForDeviceUserArguments(hostArgs.data()));
+    CHECK_HIP_ERROR(hipMalloc(&dArgs, experts * sizeof(hipblaslt_ext::UserArguments)));
+    auto copied = timeSteps(steps, stream, [&](int s) {
+        for(int64_t i = 0; i < experts; i++)
+            hostArgs[i].m = routes[s * experts + i];
+        CHECK_HIP_ERROR(hipMemcpy(dArgs,
+                                  hostArgs.data(),
+                                  experts * sizeof(hipblaslt_ext::UserArguments),
+                                  hipMemcpyHostToDevice));
+        CHECK_HIPBLASLT_ERROR(groupedGemm.run(dArgs, stream));
+    });
+
+    hipblaslt_ext::GroupedGemmUserArgsRing ring(groupedGemm, depth);
+    CHECK_HIPBLASLT_ERROR(ring.initialize(stream));
+    auto ringHost = timeSteps(steps, stream, [&](int s) {
+        auto args = ring.hostArgs();
+        for(int64_t i = 0; i < experts; i++)
+            args[i].m = routes[s * experts + i];
+        CHECK_HIPBLASLT_ERROR(ring.run(stream));
+    });
+
+    // The route already lives on the device, as if written by a router kernel
+    auto ringRoute = timeSteps(steps, stream, [&](int s) {
+        hipblaslt_ext::GroupedGemmRoute route;
+        route.m = dRoutes + s * experts;
+        CHECK_HIPBLASLT_ERROR(ring.run(route, stream));
+    });
+
+    std::cout << "experts: " << experts << ", tokens: " << tokens << ", n: " << n << ", k: " << k
+              << ", steps: " << steps << ", depth: " << ring.depth() << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(12) << "mode" << std::setw(14) << "host us/step" << std::setw(14)
+              << "wall us/step" << std::endl;
+    std::cout << std::setw(12) << "copy" << std::setw(14) << copied.hostUs << std::setw(14)
+              << copied.wallUs << std::endl;
+    std::cout << std::setw(12) << "ring host" << std::setw(14) << ringHost.hostUs
+              << std::setw(14) << ringHost.wallUs << std::endl;
+    std::cout << std::setw(12) << "ring route" << std::setw(14) << ringRoute.hostUs
+              << std::setw(14) << ringRoute.wallUs << std::endl;
+
+    CHECK_HIP_ERROR(hipFree(dArgs));
+    CHECK_HIP_ERROR(hipFree(dRoutes));
+    CHECK_HIP_ERROR(hipFree(workspace));
+    for(auto buffer : buffers)
+        CHECK_HIP_ERROR(hipFree(buffer));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+    return EXIT_SUCCESS;
+}
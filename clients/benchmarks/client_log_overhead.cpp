@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Measures the host overhead of library logging per API call. The benchmark re-runs
+// itself with logging off, with synchronous writes and with the asynchronous writer,
+// since the logging mode is read from the environment once per process.
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <hipblaslt/hipblaslt.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+void printUsage(char* programName)
+{
+    std::cout << "Usage: " << programName << " <options>\n"
+              << "options:\n"
+              << "\t-h, --help\t\t\tShow this help message\n"
+              << "\t-i, --iters\t\t\tIterations per thread, default is 100000\n"
+              << "\t-t, --threads\t\t\tNumber of calling threads, default is 1\n"
+              << "\t--log_file\t\t\tLog destination, default is /dev/null\n";
+}
+
+int parseArgs(int          argc,
+              char**       argv,
+              int&         iters,
+              int&         threads,
+              std::string& logFile,
+              bool&        child)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if(arg.at(0) == '-')
+        {
+            if((arg == "-h") || (arg == "--help"))
+            {
+                return EXIT_FAILURE;
+            }
+            else if(arg == "-i" || arg == "--iters")
+            {
+                iters = std::stoi(argv[++i]);
+            }
+            else if(arg == "-t" || arg == "--threads")
+            {
+                threads = std::stoi(argv[++i]);
+            }
+            else if(arg == "--log_file")
+            {
+                logFile = argv[++i];
+            }
+            else if(arg == "--child")
+            {
+                child = true;
+            }
+        }
+        else
+        {
+            std::cerr << "error with " << arg << std::endl;
+            std::cerr << "option must start with - or --" << std::endl << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Every iteration makes four API calls which are logged in api mode
+constexpr int callsPerIter = 4;
+
+void logCalls(int iters)
+{
+    for(int i = 0; i < iters; i++)
+    {
+        hipblasLtMatrixLayout_t layout;
+        hipblasLtMatmulDesc_t   desc;
+        hipblasLtMatrixLayoutCreate(&layout, HIP_R_16F, 128, 128, 128);
+        hipblasLtMatrixLayoutDestroy(layout);
+        hipblasLtMatmulDescCreate(&desc, HIPBLAS_COMPUTE_32F, HIP_R_32F);
+        hipblasLtMatmulDescDestroy(desc);
+    }
+}
+
+// Run the calls on all threads and print the host time per call
+int runChild(int iters, int threads)
+{
+    logCalls(1); // warm up, also opens the log
+
+    std::vector<std::thread> workers;
+    auto                     start = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; t++)
+        workers.emplace_back(logCalls, iters);
+    for(auto& w : workers)
+        w.join();
+    auto stop = std::chrono::steady_clock::now();
+
+    // Wall time per call, as seen by each calling thread
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count()
+                / (double(iters) * callsPerIter);
+    std::cout << ns << std::endl;
+    return EXIT_SUCCESS;
+}
+
+double runMode(const std::string& exe,
+               int                iters,
+               int                threads,
+               const std::string& logFile,
+               const char*        mask,
+               const char*        async)
+{
+    unsetenv("HIPBLASLT_LOG_LEVEL");
+    setenv("HIPBLASLT_LOG_MASK", mask, 1);
+    setenv("HIPBLASLT_LOG_ASYNC", async, 1);
+    // Every thread gets its own ring; size it for all of the thread's calls so that no record
+    // is dropped and the asynchronous timing covers every record
+    setenv("HIPBLASLT_LOG_ASYNC_DEPTH", std::to_string((iters + 1) * callsPerIter).c_str(), 1);
+    setenv("HIPBLASLT_LOG_FILE", logFile.c_str(), 1);
+
+    std::string cmd = "'" + exe + "' --child -i " + std::to_string(iters) + " -t "
+                      + std::to_string(threads);
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if(!pipe)
+        return -1;
+    double ns = -1;
+    if(fscanf(pipe, "%lf", &ns) != 1)
+        ns = -1;
+    pclose(pipe);
+    return ns;
+}
+
+int main(int argc, char** argv)
+{
+    int         iters   = 100000;
+    int         threads = 1;
+    std::string logFile = "/dev/null";
+    bool        child   = false;
+
+    if(parseArgs(argc, argv, iters, threads, logFile, child))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(child)
+        return runChild(iters, threads);
+
+    char    exe[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if(len <= 0)
+    {
+        std::cerr << "cannot find own executable" << std::endl;
+        return EXIT_FAILURE;
+    }
+    exe[len] = '\0';
+
+    std::cout << "threads: " << threads << ", iterations: " << iters << ", log: " << logFile
+              << std::endl;
+
+    double off   = runMode(exe, iters, threads, logFile, "0", "0");
+    double sync  = runMode(exe, iters, threads, logFile, "16", "0");
+    double async = runMode(exe, iters, threads, logFile, "16", "1");
+    if(off < 0 || sync < 0 || async < 0)
+    {
+        std::cerr << "benchmark run failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << "logging" << std::setw(14) << "ns/call" << std::setw(14)
+              << "overhead" << std::endl;
+    std::cout << std::setw(8) << "off" << std::setw(14) << off << std::setw(14) << 0.0
+              << std::endl;
+    std::cout << std::setw(8) << "sync" << std::setw(14) << sync << std::setw(14) << sync - off
+              << std::endl;
+    std::cout << std::setw(8) << "async" << std::setw(14) << async << std::setw(14)
+              << async - off << std::endl;
+
+    return EXIT_SUCCESS;
+}
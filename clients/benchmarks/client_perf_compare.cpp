@@ -0,0 +1,373 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Compares two hipblaslt-bench result files written with --output_format json, typically a
+// baseline recorded with one library version and a run of the same suite (for example
+// perf_regression.yaml) with another. Problems are matched on their arguments. A problem
+// regresses when it is slower by more than the threshold and the difference is larger than
+// the combined 95% confidence intervals of the two medians, so runs with --timing_stats
+// are needed for the significance test; without them only the threshold applies.
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// std::stod accepts a numeric prefix and throws on anything else; cells must be a whole number
+bool parseNumber(const std::string& text, double& value)
+{
+    char* end = nullptr;
+    value     = std::strtod(text.c_str(), &end);
+    return !text.empty() && end == text.c_str() + text.size() && std::isfinite(value);
+}
+
+void printUsage(char* programName)
+{
+    std::cout << "Usage: " << programName << " <options> baseline-file current-file\n"
+              << "options:\n"
+              << "\t-h, --help\t\t\tShow this help message\n"
+              << "\t--threshold\t\t\tSmallest relative change that is reported, default is 0.05\n"
+              << "\t--all\t\t\t\tPrint every problem, not only regressions and improvements\n"
+              << "The exit code is 1 when a problem regressed or is missing from current-file.\n";
+}
+
+int parseArgs(int          argc,
+              char**       argv,
+              std::string& baselineFile,
+              std::string& currentFile,
+              double&      threshold,
+              bool&        all)
+{
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if(arg.at(0) == '-')
+        {
+            if((arg == "-h") || (arg == "--help"))
+            {
+                return EXIT_FAILURE;
+            }
+            else if(arg == "--threshold" && i + 1 < argc)
+            {
+                if(!parseNumber(argv[++i], threshold) || threshold < 0)
+                {
+                    std::cerr << "error with --threshold " << argv[i] << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            else if(arg == "--all")
+            {
+                all = true;
+            }
+            else
+            {
+                std::cerr << "error with " << arg << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            files.push_back(arg);
+        }
+    }
+
+    if(files.size() != 2 || threshold < 0)
+        return EXIT_FAILURE;
+    baselineFile = files[0];
+    currentFile  = files[1];
+    return EXIT_SUCCESS;
+}
+
+using Record = std::map<std::string, std::string>;
+
+// Parse one line of the JSON output, a flat object of string and number values
+bool parseRecord(const std::string& line, Record& record)
+{
+    size_t pos  = 0;
+    auto   skip = [&]() {
+        while(pos < line.size() && isspace(static_cast<unsigned char>(line[pos])))
+            pos++;
+    };
+    auto string = [&](std::string& out) {
+        if(line[pos++] != '"')
+            return false;
+        for(; pos < line.size() && line[pos] != '"'; pos++)
+        {
+            if(line[pos] == '\\' && pos + 1 < line.size())
+                pos++;
+            out += line[pos];
+        }
+        return pos++ < line.size();
+    };
+
+    skip();
+    if(pos >= line.size() || line[pos++] != '{')
+        return false;
+    while(true)
+    {
+        std::string name, value;
+        skip();
+        if(pos >= line.size() || !string(name))
+            return false;
+        skip();
+        if(pos >= line.size() || line[pos++] != ':')
+            return false;
+        skip();
+        if(pos >= line.size())
+            return false;
+        if(line[pos] == '"')
+        {
+            if(!string(value))
+                return false;
+        }
+        else
+        {
+            while(pos < line.size() && line[pos] != ',' && line[pos] != '}')
+                value += line[pos++];
+            while(!value.empty() && isspace(static_cast<unsigned char>(value.back())))
+                value.pop_back();
+        }
+        record[name] = value;
+        skip();
+        if(pos >= line.size())
+            return false;
+        if(line[pos] == '}')
+            return true;
+        if(line[pos++] != ',')
+            return false;
+    }
+}
+
+// Arguments that select a different gemm. Everything else in a record describes the result,
+// the solution or the run, and may change between versions without changing the problem.
+const std::vector<std::string>& problemFields()
+{
+    static const std::vector<std::string> fields = {
+        "function", "transA", "transB", "grouped_gemm", "batch_count", "m", "n", "k", "lda",
+        "ldb", "ldc", "ldd", "stride_a", "stride_b", "stride_c", "stride_d", "a_type", "b_type",
+        "c_type", "d_type", "compute_type", "beta", "scaleA", "scaleB", "scaleC", "scaleD",
+        "amaxD", "activation_type", "bias_vector", "bias_type"};
+    return fields;
+}
+
+struct Result
+{
+    std::string label;
+    double      us       = 0;
+    double      ci95     = 0; // 0 when the run had no --timing_stats
+    std::string solution = "-";
+    std::string kernel;
+    bool        winner = false;
+};
+
+// Read the results of a file keyed by problem. When several solutions of a problem were
+// timed the winner is kept, otherwise the first (heuristic) solution.
+bool readResults(const std::string&             file,
+                 std::vector<std::string>&      order,
+                 std::map<std::string, Result>& results,
+                 Record&                        provenance)
+{
+    std::ifstream in(file);
+    if(!in)
+    {
+        std::cerr << "Cannot open " << file << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t      lineNo = 0;
+    while(std::getline(in, line))
+    {
+        lineNo++;
+        if(line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        Record record;
+        if(!parseRecord(line, record))
+        {
+            std::cerr << file << ":" << lineNo
+                      << ": not a hipblaslt-bench json record, use --output_format json"
+                      << std::endl;
+            return false;
+        }
+        if(!record.count("us"))
+            continue;
+
+        // The arguments of the problem form the key
+        std::string key;
+        for(auto& name : problemFields())
+            if(record.count(name))
+                key += name + "=" + record[name] + " ";
+
+        Result r;
+        for(auto name : {"function", "transA", "transB", "m", "n", "k", "batch_count", "a_type",
+                         "c_type", "compute_type", "beta", "activation_type", "bias_vector"})
+            if(record.count(name))
+                r.label += (r.label.empty() ? "" : " ") + std::string(name) + "=" + record[name];
+        if(!parseNumber(record.count("us-median") ? record["us-median"] : record["us"], r.us))
+        {
+            std::cerr << file << ":" << lineNo << ": skipping record without a numeric time"
+                      << std::endl;
+            continue;
+        }
+        if(!record.count("us-ci95") || !parseNumber(record["us-ci95"], r.ci95))
+            r.ci95 = 0;
+        r.winner = record.count("winner") && record["winner"] == "1";
+        if(record.count("solution_index"))
+            r.solution = record["solution_index"];
+        if(record.count("kernel_name"))
+            r.kernel = record["kernel_name"];
+
+        auto it = results.find(key);
+        if(it == results.end())
+        {
+            order.push_back(key);
+            results[key] = r;
+        }
+        else if(r.winner && !it->second.winner)
+        {
+            it->second = r;
+        }
+
+        for(auto name : {"hipblaslt_git_version", "device_name", "arch", "cu_count"})
+            if(record.count(name))
+                provenance[name] = record[name];
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string baselineFile, currentFile;
+    double      threshold = 0.05;
+    bool        all       = false;
+
+    if(parseArgs(argc, argv, baselineFile, currentFile, threshold, all))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string>      baseOrder, currentOrder;
+    std::map<std::string, Result> base, current;
+    Record                        baseInfo, currentInfo;
+    if(!readResults(baselineFile, baseOrder, base, baseInfo)
+       || !readResults(currentFile, currentOrder, current, currentInfo))
+        return EXIT_FAILURE;
+
+    std::cout << "baseline: " << baselineFile << " " << baseInfo["hipblaslt_git_version"] << " "
+              << baseInfo["device_name"] << " " << baseInfo["arch"] << "\n"
+              << "current:  " << currentFile << " " << currentInfo["hipblaslt_git_version"]
+              << " " << currentInfo["device_name"] << " " << currentInfo["arch"] << std::endl;
+    if(baseInfo["arch"] != currentInfo["arch"] || baseInfo["cu_count"] != currentInfo["cu_count"])
+        std::cout << "warning: the files were recorded on different devices" << std::endl;
+
+    size_t compared = 0, regressions = 0, improvements = 0, changedSolutions = 0, missing = 0;
+    double logRatioSum = 0;
+    bool   noStats     = false;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for(auto& key : baseOrder)
+    {
+        const Result& b  = base[key];
+        auto          it = current.find(key);
+        if(it == current.end())
+        {
+            std::cout << "MISSING     " << b.label << std::endl;
+            missing++;
+            continue;
+        }
+        const Result& c = it->second;
+        if(b.us <= 0 || c.us <= 0)
+            continue;
+
+        compared++;
+        logRatioSum += std::log(c.us / b.us);
+        noStats |= b.ci95 <= 0 || c.ci95 <= 0;
+
+        double change      = c.us / b.us - 1;
+        bool   significant = std::abs(c.us - b.us) > std::sqrt(b.ci95 * b.ci95 + c.ci95 * c.ci95);
+        bool   changed     = b.solution != c.solution;
+        changedSolutions += changed;
+
+        const char* status = "";
+        if(change > threshold && significant)
+        {
+            status = "REGRESSION  ";
+            regressions++;
+        }
+        else if(change < -threshold && significant)
+        {
+            status = "IMPROVEMENT ";
+            improvements++;
+        }
+        else if(all)
+            status = "SAME        ";
+        else
+            continue;
+
+        std::cout << status << b.label << "\n    " << b.us << " us -> " << c.us << " us ("
+                  << std::showpos << change * 100 << std::noshowpos << "%)";
+        if(b.ci95 > 0 || c.ci95 > 0)
+            std::cout << ", ci95 " << b.ci95 << " / " << c.ci95 << " us";
+        std::cout << "\n    solution " << b.solution;
+        if(changed)
+            std::cout << " -> " << c.solution << "\n    kernel   " << b.kernel << "\n          ->"
+                      << " " << c.kernel;
+        else
+            std::cout << " (unchanged)";
+        std::cout << std::endl;
+    }
+
+    size_t added = 0;
+    for(auto& key : currentOrder)
+        added += base.count(key) == 0;
+
+    std::cout << "\n"
+              << compared << " problems compared, " << regressions << " regressions, "
+              << improvements << " improvements, " << changedSolutions
+              << " with a changed solution";
+    if(missing)
+        std::cout << ", " << missing << " missing from " << currentFile;
+    if(added)
+        std::cout << ", " << added << " only in " << currentFile;
+    std::cout << std::endl;
+    if(compared)
+        std::cout << "geometric mean time ratio current/baseline: " << std::setprecision(4)
+                  << std::exp(logRatioSum / compared) << std::endl;
+    if(noStats)
+        std::cout << "note: some results have no confidence interval, run hipblaslt-bench with "
+                     "--timing_stats for the significance test"
+                  << std::endl;
+
+    return regressions || missing ? EXIT_FAILURE : EXIT_SUCCESS;
+}
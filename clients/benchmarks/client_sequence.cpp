@@ -34,6 +34,7 @@
 
 #include "hipblaslt_datatype2string.hpp"
 #include "hipblaslt_test.hpp"
+#include "timing_stats.hpp"
 #include "utility.hpp"
 
 extern "C" __global__ void flush_icache()
@@ -261,6 +262,9 @@ public:
     uint32_t iters              = 10;
     int64_t  max_workspace_size = 128 * 1024 * 1024;
     bool     graph_mode         = false;
+    bool     timing_stats       = false;
+    double   timing_ci          = 0;
+    double   timing_budget_ms   = 1000;
 };
 
 class LayerConfigIO
@@ -287,6 +291,9 @@ namespace llvm
                 io.mapOptional("Iter", lc.iters);
                 io.mapOptional("MaxWorkspaceSize", lc.max_workspace_size);
                 io.mapOptional("UseGraphMode", lc.graph_mode);
+                io.mapOptional("TimingStats", lc.timing_stats);
+                io.mapOptional("TimingCI", lc.timing_ci);
+                io.mapOptional("TimingBudgetMs", lc.timing_budget_ms);
             }
         };
         template <>
@@ -543,17 +550,8 @@ int main(int argc, char** argv)
         }
     }
 
-    CHECK_HIP_ERROR(hipEventSynchronize(event_gpu_time_start));
-    CHECK_HIP_ERROR(hipEventRecord(event_gpu_time_start, stream));
-    hipGraph_t graph = NULL;
-    if(rv.gs.graph_mode)
-    {
-        hipStreamCaptureMode mode = hipStreamCaptureModeGlobal;
-        CHECK_HIP_ERROR(hipStreamBeginCapture(stream, mode));
-    }
-
-    for(int i = 0; i < iters; i++)
-    {
+    // One pass over the layers, using rotating block i
+    auto run_sequence = [&](int i) {
         for(size_t gemmIdx = 0; gemmIdx < layer.size(); gemmIdx++)
         {
             switch(layer[gemmIdx].type)
@@ -568,30 +566,83 @@ int main(int argc, char** argv)
                 break;
             }
         }
-    }
+    };
 
-    if(rv.gs.graph_mode)
+    hipGraph_t graph = NULL;
+    if(rv.gs.timing_stats)
     {
-        CHECK_HIP_ERROR(hipStreamEndCapture(stream, &graph));
-    }
-    CHECK_HIP_ERROR(hipEventRecord(event_gpu_time_end, stream));
-    CHECK_HIP_ERROR(hipEventSynchronize(event_gpu_time_end));
+        // Every pass is timed on its own, in graph mode as a graph per rotating block
+        std::vector<hipGraphExec_t> graph_execs;
+        if(rv.gs.graph_mode)
+        {
+            for(int b = 0; b < block_count; b++)
+            {
+                hipGraph_t block_graph;
+                CHECK_HIP_ERROR(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+                run_sequence(b);
+                CHECK_HIP_ERROR(hipStreamEndCapture(stream, &block_graph));
+                graph_execs.emplace_back();
+                CHECK_HIP_ERROR(
+                    hipGraphInstantiate(&graph_execs.back(), block_graph, nullptr, nullptr, 0));
+                CHECK_HIP_ERROR(hipGraphDestroy(block_graph));
+            }
+        }
 
-    if(rv.gs.graph_mode)
+        hipblaslt_timing_stats stats;
+        int                    calls;
+        CHECK_HIP_ERROR(hipblaslt_time_iterations(
+            stream, iters, rv.gs.timing_ci, rv.gs.timing_budget_ms, stats, calls, [&](int i) {
+                if(graph_execs.empty())
+                    run_sequence(i);
+                else
+                    CHECK_HIP_ERROR(hipGraphLaunch(graph_execs[i % block_count], stream));
+            }));
+        for(auto graph_exec : graph_execs)
+            CHECK_HIP_ERROR(hipGraphExecDestroy(graph_exec));
+
+        std::cout << "Time: " << stats.median << std::endl;
+        std::cout << "us-median,us-p5,us-p95,us-stddev,us-ci95,samples,outliers" << std::endl
+                  << stats.median << "," << stats.p5 << "," << stats.p95 << "," << stats.stddev
+                  << "," << stats.ci95 << "," << stats.samples << "," << stats.outliers
+                  << std::endl;
+    }
+    else
     {
-        hipGraphExec_t graph_exec = NULL;
-        CHECK_HIP_ERROR(hipGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0));
         CHECK_HIP_ERROR(hipEventSynchronize(event_gpu_time_start));
         CHECK_HIP_ERROR(hipEventRecord(event_gpu_time_start, stream));
-        hipGraphLaunch(graph_exec, stream);
+        if(rv.gs.graph_mode)
+        {
+            hipStreamCaptureMode mode = hipStreamCaptureModeGlobal;
+            CHECK_HIP_ERROR(hipStreamBeginCapture(stream, mode));
+        }
+
+        for(int i = 0; i < iters; i++)
+            run_sequence(i);
+
+        if(rv.gs.graph_mode)
+        {
+            CHECK_HIP_ERROR(hipStreamEndCapture(stream, &graph));
+        }
         CHECK_HIP_ERROR(hipEventRecord(event_gpu_time_end, stream));
         CHECK_HIP_ERROR(hipEventSynchronize(event_gpu_time_end));
-        CHECK_HIP_ERROR(hipGraphExecDestroy(graph_exec));
+
+        if(rv.gs.graph_mode)
+        {
+            hipGraphExec_t graph_exec = NULL;
+            CHECK_HIP_ERROR(hipGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0));
+            CHECK_HIP_ERROR(hipEventSynchronize(event_gpu_time_start));
+            CHECK_HIP_ERROR(hipEventRecord(event_gpu_time_start, stream));
+            hipGraphLaunch(graph_exec, stream);
+            CHECK_HIP_ERROR(hipEventRecord(event_gpu_time_end, stream));
+            CHECK_HIP_ERROR(hipEventSynchronize(event_gpu_time_end));
+            CHECK_HIP_ERROR(hipGraphExecDestroy(graph_exec));
+        }
+        float gpu_time_ms;
+        CHECK_HIP_ERROR(
+            hipEventElapsedTime(&gpu_time_ms, event_gpu_time_start, event_gpu_time_end));
+        auto gpu_time_used = gpu_time_ms * 1000; // ms to us
+        std::cout << "Time: " << gpu_time_used / iters << std::endl;
     }
-    float gpu_time_ms;
-    CHECK_HIP_ERROR(hipEventElapsedTime(&gpu_time_ms, event_gpu_time_start, event_gpu_time_end));
-    auto gpu_time_used = gpu_time_ms * 1000; // ms to us
-    std::cout << "Time: " << gpu_time_used / iters << std::endl;
 
     // Print kernel info
     if(rv.gs.print_kernel_info)
@@ -0,0 +1,538 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Replays a binary shape trace recorded with HIPBLASLT_TRACE_FILE. In calls mode every
+// recorded gemm is re-executed in the original order, on one stream per recorded stream
+// and with the recorded gaps between submissions. In shapes mode each unique problem is
+// timed on its own and reported with its call count and share of the total GPU time.
+
+#include "auxiliary.hpp"
+#include "datatype_interface.hpp"
+#include "hipblaslt_trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <hip/hip_runtime.h>
+#include <hipblaslt/hipblaslt-ext.hpp>
+#include <hipblaslt/hipblaslt.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef CHECK_HIP_ERROR
+#define CHECK_HIP_ERROR(error)                    \
+    if(error != hipSuccess)                       \
+    {                                             \
+        fprintf(stderr,                           \
+                "Hip error: '%s'(%d) at %s:%d\n", \
+                hipGetErrorString(error),         \
+                error,                            \
+                __FILE__,                         \
+                __LINE__);                        \
+        exit(EXIT_FAILURE);                       \
+    }
+#endif
+
+#ifndef CHECK_HIPBLASLT_ERROR
+#define CHECK_HIPBLASLT_ERROR(error)                                                      \
+    if(error != HIPBLAS_STATUS_SUCCESS)                                                   \
+    {                                                                                     \
+        fprintf(stderr, "hipBLASLt error(Err=%d) at %s:%d\n", error, __FILE__, __LINE__); \
+        fprintf(stderr, "\n");                                                            \
+        exit(EXIT_FAILURE);                                                               \
+    }
+#endif
+
+void printUsage(char* programName)
+{
+    std::cout << "Usage: " << programName << " <options> trace-file\n"
+              << "options:\n"
+              << "\t-h, --help\t\t\tShow this help message\n"
+              << "\t--mode\t\t\t\tcalls: replay every call in order, shapes: time each unique\n"
+              << "\t\t\t\t\tproblem. Default is calls\n"
+              << "\t--no_gaps\t\t\tIn calls mode, submit without the recorded gaps\n"
+              << "\t--heuristic\t\t\tIgnore the recorded solution index and use the heuristic,\n"
+              << "\t\t\t\t\tfor example when comparing library versions\n"
+              << "\t--cold_iters\t\t\tWarm up iterations per problem, default is 10\n"
+              << "\t--max_iters\t\t\tIn shapes mode, cap the timed calls per problem, default is\n"
+              << "\t\t\t\t\tthe recorded call count\n"
+              << "\t--device\t\t\tDevice to run on, default is 0\n";
+}
+
+int parseArgs(int          argc,
+              char**       argv,
+              std::string& traceFile,
+              std::string& mode,
+              bool&        noGaps,
+              bool&        heuristic,
+              int&         coldIters,
+              int&         maxIters,
+              int&         device)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if(arg.at(0) == '-')
+        {
+            if((arg == "-h") || (arg == "--help"))
+            {
+                return EXIT_FAILURE;
+            }
+            else if(arg == "--mode")
+            {
+                mode = argv[++i];
+            }
+            else if(arg == "--no_gaps")
+            {
+                noGaps = true;
+            }
+            else if(arg == "--heuristic")
+            {
+                heuristic = true;
+            }
+            else if(arg == "--cold_iters")
+            {
+                coldIters = std::stoi(argv[++i]);
+            }
+            else if(arg == "--max_iters")
+            {
+                maxIters = std::stoi(argv[++i]);
+            }
+            else if(arg == "--device")
+            {
+                device = std::stoi(argv[++i]);
+            }
+            else
+            {
+                std::cerr << "error with " << arg << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            traceFile = arg;
+        }
+    }
+
+    if(traceFile.empty() || (mode != "calls" && mode != "shapes"))
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+
+bool readTrace(const std::string&                   traceFile,
+               hipblaslt_trace_header&              header,
+               std::vector<hipblaslt_trace_record>& records,
+               uint64_t&                            dropped)
+{
+    std::ifstream file(traceFile, std::ios::binary);
+    if(!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+       || memcmp(header.magic, HIPBLASLT_TRACE_MAGIC, sizeof(HIPBLASLT_TRACE_MAGIC)) != 0)
+    {
+        std::cerr << traceFile << " is not a hipBLASLt trace" << std::endl;
+        return false;
+    }
+    if(header.version != HIPBLASLT_TRACE_VERSION
+       || header.record_size != sizeof(hipblaslt_trace_record))
+    {
+        std::cerr << traceFile << " has trace version " << header.version
+                  << ", expected version " << HIPBLASLT_TRACE_VERSION << std::endl;
+        return false;
+    }
+
+    hipblaslt_trace_record record;
+    while(file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        if(record.flags & HIPBLASLT_TRACE_DROPPED)
+            dropped += record.m;
+        else
+            records.push_back(record);
+    }
+
+    // Records are written per thread, so restore the submission order
+    std::stable_sort(records.begin(), records.end(), [](auto& a, auto& b) {
+        return a.timestamp_ns < b.timestamp_ns;
+    });
+    return true;
+}
+
+hipblasLtEpilogue_t traceEpilogue(const hipblaslt_trace_record& r)
+{
+    bool bias = r.flags & HIPBLASLT_TRACE_BIAS;
+    bool aux  = r.flags & HIPBLASLT_TRACE_USE_E;
+    switch(r.activation)
+    {
+    case HIPBLASLT_TRACE_ACTIVATION_DGELU:
+        return bias ? HIPBLASLT_EPILOGUE_DGELU_BGRAD : HIPBLASLT_EPILOGUE_DGELU;
+    case HIPBLASLT_TRACE_ACTIVATION_GELU:
+        if(aux)
+            return bias ? HIPBLASLT_EPILOGUE_GELU_AUX_BIAS : HIPBLASLT_EPILOGUE_GELU_AUX;
+        return bias ? HIPBLASLT_EPILOGUE_GELU_BIAS : HIPBLASLT_EPILOGUE_GELU;
+    case HIPBLASLT_TRACE_ACTIVATION_RELU:
+        return bias ? HIPBLASLT_EPILOGUE_RELU_BIAS : HIPBLASLT_EPILOGUE_RELU;
+    default:
+        break;
+    }
+    if(bias && (r.flags & HIPBLASLT_TRACE_GRADIENT))
+        return r.bias_source == 1 ? HIPBLASLT_EPILOGUE_BGRADB : HIPBLASLT_EPILOGUE_BGRADA;
+    return bias ? HIPBLASLT_EPILOGUE_BIAS : HIPBLASLT_EPILOGUE_DEFAULT;
+}
+
+// One unique problem of the trace with its device buffers
+struct ReplayProblem
+{
+    hipblaslt_trace_record               record;
+    size_t                               count = 0;
+    std::unique_ptr<hipblaslt_ext::Gemm> gemm;
+    std::vector<void*>                   buffers;
+    double                               alpha[2]; // large enough for any scale type
+    double                               beta[2];
+    double                               us = 0;
+
+    void* alloc(size_t bytes)
+    {
+        void* ptr = nullptr;
+        CHECK_HIP_ERROR(hipMalloc(&ptr, std::max<size_t>(bytes, 1)));
+        // 0x3c bytes are small finite values for every floating point type
+        CHECK_HIP_ERROR(hipMemset(ptr, 0x3c, std::max<size_t>(bytes, 1)));
+        buffers.push_back(ptr);
+        return ptr;
+    }
+
+    ~ReplayProblem()
+    {
+        for(auto ptr : buffers)
+            static_cast<void>(hipFree(ptr));
+    }
+};
+
+void setScalar(double* dst, double value, hipDataType type)
+{
+    switch(type)
+    {
+    case HIP_R_64F:
+        *dst = value;
+        break;
+    case HIP_R_32I:
+        *reinterpret_cast<int32_t*>(dst) = int32_t(value);
+        break;
+    case HIP_R_16F:
+        *reinterpret_cast<hipblasLtHalf*>(dst) = hipblasLtHalf(float(value));
+        break;
+    default:
+        *reinterpret_cast<float*>(dst) = float(value);
+        break;
+    }
+}
+
+// Matrix size in elements covering every batch, for a matrix of rows x cols
+size_t matrixElements(int64_t rows, int64_t cols, int64_t ld, int64_t stride, int64_t batch)
+{
+    size_t one = size_t(ld) * (cols - 1) + rows;
+    return std::max(one, size_t(stride) * (batch - 1) + one);
+}
+
+void setupProblem(hipblasLtHandle_t handle, ReplayProblem& p, bool heuristic, size_t index)
+{
+    auto& r = p.record;
+    auto  opA = (r.flags & HIPBLASLT_TRACE_TRANS_A) ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+    auto  opB = (r.flags & HIPBLASLT_TRACE_TRANS_B) ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+    auto  tA  = hipDataType(r.a_type);
+    auto  tB  = hipDataType(r.b_type);
+    auto  tC  = hipDataType(r.c_type);
+    auto  tD  = hipDataType(r.d_type);
+
+    hipblaslt_ext::GemmProblemTypeV2 problemType;
+    problemType.setOpA(opA);
+    problemType.setOpB(opB);
+    problemType.setTypeA(tA);
+    problemType.setTypeB(tB);
+    problemType.setTypeC(tC);
+    problemType.setTypeD(tD);
+    problemType.setTypeCompute(hipblasComputeType_t(r.compute_type));
+
+    hipblaslt_ext::GemmEpilogueV2 epilogue;
+    epilogue.setMode(traceEpilogue(r));
+    epilogue.setBiasDataType(hipDataType(r.bias_type));
+    if(r.flags & HIPBLASLT_TRACE_USE_E)
+    {
+        epilogue.setAuxLeadingDimension(r.lde);
+        epilogue.setAuxBatchStride(r.stride_e);
+    }
+    epilogue.setScalingAType(r.scale_a == 2 ? 1 : 0);
+    epilogue.setScalingBType(r.scale_b == 2 ? 1 : 0);
+
+    int64_t rowsA = opA == HIPBLAS_OP_N ? r.m : r.k;
+    int64_t colsA = opA == HIPBLAS_OP_N ? r.k : r.m;
+    int64_t rowsB = opB == HIPBLAS_OP_N ? r.k : r.n;
+    int64_t colsB = opB == HIPBLAS_OP_N ? r.n : r.k;
+    int64_t maxMN = std::max(r.m, r.n);
+
+    hipblaslt_ext::GemmInputsV2 inputs;
+    inputs.setA(p.alloc(matrixElements(rowsA, colsA, r.lda, r.stride_a, r.batch_count)
+                        * realDataTypeSize(tA)));
+    inputs.setB(p.alloc(matrixElements(rowsB, colsB, r.ldb, r.stride_b, r.batch_count)
+                        * realDataTypeSize(tB)));
+    inputs.setC(p.alloc(matrixElements(r.m, r.n, r.ldc, r.stride_c, r.batch_count)
+                        * realDataTypeSize(tC)));
+    inputs.setD(p.alloc(matrixElements(r.m, r.n, r.ldd, r.stride_d, r.batch_count)
+                        * realDataTypeSize(tD)));
+    if(r.flags & HIPBLASLT_TRACE_BIAS)
+        inputs.setBias(
+            p.alloc(maxMN * r.batch_count * realDataTypeSize(hipDataType(r.bias_type))));
+    if(r.flags & HIPBLASLT_TRACE_USE_E)
+        inputs.setAux(p.alloc(matrixElements(r.m, r.n, r.lde, r.stride_e, r.batch_count)
+                              * realDataTypeSize(tD)));
+    if(r.scale_a)
+        inputs.setScaleA(p.alloc(maxMN * sizeof(float)));
+    if(r.scale_b)
+        inputs.setScaleB(p.alloc(maxMN * sizeof(float)));
+    if(r.flags & HIPBLASLT_TRACE_SCALE_CD)
+    {
+        inputs.setScaleC(p.alloc(sizeof(float)));
+        inputs.setScaleD(p.alloc(sizeof(float)));
+    }
+    if(r.flags & HIPBLASLT_TRACE_SCALE_ALPHA_VEC)
+        inputs.setScaleAlphaVec(p.alloc(r.m * sizeof(float)));
+
+    setScalar(p.alpha, r.alpha, hipDataType(r.scale_type));
+    setScalar(p.beta, r.beta, hipDataType(r.scale_type));
+    inputs.setAlpha(p.alpha);
+    inputs.setBeta(p.beta);
+
+    p.gemm = std::make_unique<hipblaslt_ext::Gemm>(handle, opA, opB, tA, tB, tC, tD,
+                                                    hipblasComputeType_t(r.compute_type));
+    CHECK_HIPBLASLT_ERROR(p.gemm->setProblem(r.m,
+                                             r.n,
+                                             r.k,
+                                             r.batch_count,
+                                             r.lda,
+                                             r.ldb,
+                                             r.ldc,
+                                             r.ldd,
+                                             r.stride_a,
+                                             r.stride_b,
+                                             r.stride_c,
+                                             r.stride_d,
+                                             epilogue,
+                                             inputs,
+                                             problemType));
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> result;
+    size_t                                        workspaceSize = 0;
+    if(!heuristic && r.solution_index >= 0)
+    {
+        std::vector<int> algoIndex = {r.solution_index};
+        if(hipblaslt_ext::getAlgosFromIndex(handle, algoIndex, result) != HIPBLAS_STATUS_SUCCESS
+           || result.empty()
+           || p.gemm->isAlgoSupported(result[0].algo, workspaceSize) != HIPBLAS_STATUS_SUCCESS)
+        {
+            std::cout << "Problem " << index << ": solution index " << r.solution_index
+                      << " is not available, using the heuristic" << std::endl;
+            result.clear();
+        }
+    }
+    if(result.empty())
+    {
+        hipblaslt_ext::GemmPreferenceV2 pref;
+        pref.setMaxWorkspaceBytes(128 * 1024 * 1024);
+        CHECK_HIPBLASLT_ERROR(p.gemm->algoGetHeuristic(1, pref, result));
+        if(result.empty()
+           || p.gemm->isAlgoSupported(result[0].algo, workspaceSize) != HIPBLAS_STATUS_SUCCESS)
+        {
+            std::cerr << "Problem " << index << ": no solution found" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    void* workspace = workspaceSize ? p.alloc(workspaceSize) : nullptr;
+    CHECK_HIPBLASLT_ERROR(p.gemm->initialize(result[0].algo, workspace));
+}
+
+void printProblem(const ReplayProblem& p)
+{
+    auto& r = p.record;
+    std::cout << (r.flags & HIPBLASLT_TRACE_TRANS_A ? "T" : "N")
+              << (r.flags & HIPBLASLT_TRACE_TRANS_B ? "T" : "N") << " " << r.m << "x" << r.n
+              << "x" << r.k << "x" << r.batch_count << " "
+              << hip_datatype_to_string(hipDataType(r.a_type)) << "/"
+              << hip_datatype_to_string(hipDataType(r.d_type)) << " "
+              << hipblas_computetype_to_string(hipblasComputeType_t(r.compute_type));
+}
+
+int main(int argc, char** argv)
+{
+    std::string traceFile;
+    std::string mode      = "calls";
+    bool        noGaps    = false;
+    bool        heuristic = false;
+    int         coldIters = 10;
+    int         maxIters  = 0;
+    int         device    = 0;
+
+    if(parseArgs(argc, argv, traceFile, mode, noGaps, heuristic, coldIters, maxIters, device))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    hipblaslt_trace_header              header;
+    std::vector<hipblaslt_trace_record> records;
+    uint64_t                            dropped = 0;
+    if(!readTrace(traceFile, header, records, dropped))
+        return EXIT_FAILURE;
+    if(dropped)
+        std::cout << "Trace is incomplete: the library dropped " << dropped
+                  << " calls while recording it, e.g. raise HIPBLASLT_TRACE_DEPTH" << std::endl;
+    if(records.empty())
+    {
+        std::cout << "Trace is empty" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    CHECK_HIP_ERROR(hipSetDevice(device));
+    hipblasLtHandle_t handle;
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+
+    // Map every record to its unique problem
+    std::vector<std::unique_ptr<ReplayProblem>> problems;
+    std::vector<size_t>                         problemOf(records.size());
+    std::unordered_map<hipblaslt_trace_record,
+                       size_t,
+                       hipblaslt_trace_problem_hash,
+                       hipblaslt_trace_problem_equal>
+        problemIndex;
+    for(size_t i = 0; i < records.size(); i++)
+    {
+        auto it = problemIndex.emplace(records[i], problems.size()).first;
+        if(it->second == problems.size())
+        {
+            problems.push_back(std::make_unique<ReplayProblem>());
+            problems.back()->record = records[i];
+        }
+        problems[it->second]->count++;
+        problemOf[i] = it->second;
+    }
+
+    double traceMs = (records.back().timestamp_ns - records.front().timestamp_ns) / 1e6;
+    std::cout << "trace: " << records.size() << " calls, " << problems.size()
+              << " unique problems, " << traceMs << " ms" << std::endl;
+
+    for(size_t p = 0; p < problems.size(); p++)
+        setupProblem(handle, *problems[p], heuristic, p);
+
+    // One stream per recorded stream, in order of first use
+    std::map<uint64_t, hipStream_t> streams;
+    for(auto& r : records)
+        if(!streams.count(r.stream))
+            CHECK_HIP_ERROR(hipStreamCreate(&streams[r.stream]));
+
+    hipEvent_t start, stop;
+    CHECK_HIP_ERROR(hipEventCreate(&start));
+    CHECK_HIP_ERROR(hipEventCreate(&stop));
+
+    for(auto& p : problems)
+        for(int i = 0; i < coldIters; i++)
+            CHECK_HIPBLASLT_ERROR(p->gemm->run(streams[p->record.stream]));
+    CHECK_HIP_ERROR(hipDeviceSynchronize());
+
+    if(mode == "calls")
+    {
+        auto hostStart = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < records.size(); i++)
+        {
+            if(!noGaps)
+                std::this_thread::sleep_until(
+                    hostStart
+                    + std::chrono::nanoseconds(records[i].timestamp_ns
+                                               - records.front().timestamp_ns));
+            CHECK_HIPBLASLT_ERROR(problems[problemOf[i]]->gemm->run(streams[records[i].stream]));
+        }
+        auto submitted = std::chrono::steady_clock::now();
+        CHECK_HIP_ERROR(hipDeviceSynchronize());
+        auto finished = std::chrono::steady_clock::now();
+
+        std::cout << std::fixed << std::setprecision(3) << "replay: submitted in "
+                  << std::chrono::duration<double, std::milli>(submitted - hostStart).count()
+                  << " ms, finished in "
+                  << std::chrono::duration<double, std::milli>(finished - hostStart).count()
+                  << " ms on " << streams.size() << " streams" << std::endl;
+    }
+    else
+    {
+        double total = 0;
+        for(auto& p : problems)
+        {
+            int         iters  = maxIters > 0 ? std::min<int>(maxIters, p->count) : p->count;
+            hipStream_t stream = streams[p->record.stream];
+            CHECK_HIP_ERROR(hipEventRecord(start, stream));
+            for(int i = 0; i < iters; i++)
+                CHECK_HIPBLASLT_ERROR(p->gemm->run(stream));
+            CHECK_HIP_ERROR(hipEventRecord(stop, stream));
+            CHECK_HIP_ERROR(hipEventSynchronize(stop));
+            float ms;
+            CHECK_HIP_ERROR(hipEventElapsedTime(&ms, start, stop));
+            p->us = ms * 1000 / iters;
+            total += p->us * p->count;
+        }
+
+        std::vector<ReplayProblem*> order;
+        for(auto& p : problems)
+            order.push_back(p.get());
+        std::sort(order.begin(), order.end(), [](auto a, auto b) {
+            return a->us * a->count > b->us * b->count;
+        });
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << std::setw(10) << "calls" << std::setw(12) << "us/call" << std::setw(14)
+                  << "total-us" << std::setw(8) << "share" << "  problem" << std::endl;
+        for(auto p : order)
+        {
+            std::cout << std::setw(10) << p->count << std::setw(12) << p->us << std::setw(14)
+                      << p->us * p->count << std::setw(7) << std::setprecision(1)
+                      << 100 * p->us * p->count / total << "%  " << std::setprecision(3);
+            printProblem(*p);
+            std::cout << std::endl;
+        }
+        std::cout << "total GPU time: " << total << " us" << std::endl;
+    }
+
+    CHECK_HIP_ERROR(hipEventDestroy(start));
+    CHECK_HIP_ERROR(hipEventDestroy(stop));
+    for(auto& s : streams)
+        CHECK_HIP_ERROR(hipStreamDestroy(s.second));
+    problems.clear();
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+    return EXIT_SUCCESS;
+}
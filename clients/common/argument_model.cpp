@@ -26,6 +26,10 @@
 
 #include "argument_model.hpp"
 #include "frequency_monitor.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 
 // this should have been a member variable but due to the complex variadic template this singleton allows global control
 
@@ -41,6 +45,152 @@ bool ArgumentModel_get_log_function_name()
     return log_function_name;
 }
 
+// hipblaslt-bench --devices runs one thread per device, which share the log file. The
+// provenance names the device, so it is kept per thread.
+static std::mutex log_mutex;
+static auto       log_format = ArgumentModel_log_format_t::text;
+static std::unique_ptr<hipblaslt_internal_ostream>                   log_file;
+static thread_local std::vector<std::pair<std::string, std::string>> log_provenance;
+static std::string                                                   log_csv_header;
+static std::string                                                   log_file_path;
+static thread_local ArgumentModel_totals                             log_totals;
+
+void ArgumentModel_set_log_format(ArgumentModel_log_format_t format, const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(log_mutex);
+    // Every problem of a --problems list sets the same format again; keep appending
+    if(format == log_format && file == log_file_path)
+        return;
+    log_format    = format;
+    log_file_path = file;
+    log_csv_header.clear();
+    if(file.empty())
+        log_file.reset();
+    else
+        log_file = std::make_unique<hipblaslt_internal_ostream>(file);
+}
+
+ArgumentModel_log_format_t ArgumentModel_get_log_format()
+{
+    return log_format;
+}
+
+bool ArgumentModel_log_to_stdout()
+{
+    return log_format == ArgumentModel_log_format_t::text || log_file;
+}
+
+void ArgumentModel_set_log_provenance(std::vector<std::pair<std::string, std::string>> fields)
+{
+    log_provenance = std::move(fields);
+}
+
+// Split a comma separated list; the model only emits values which are free of commas
+static std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    size_t                   start = 0;
+    for(size_t pos; (pos = list.find(',', start)) != std::string::npos; start = pos + 1)
+        items.push_back(list.substr(start, pos - start));
+    items.push_back(list.substr(start));
+    return items;
+}
+
+static bool is_json_number(const std::string& s)
+{
+    if(s.empty())
+        return false;
+    char*       end;
+    const char* begin = s.c_str();
+    std::strtod(begin, &end);
+    // strtod accepts inf, nan and hex which are not valid JSON numbers
+    return *end == '\0' && s.find_first_of("xXnNiI") == std::string::npos;
+}
+
+static void json_string(hipblaslt_internal_ostream& os, const std::string& s)
+{
+    os << '"';
+    for(char c : s)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << ' ';
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+void ArgumentModel_log_record(const std::string&                                      names,
+                              const std::string&                                      values,
+                              const std::vector<std::pair<std::string, std::string>>& extra)
+{
+    if(log_format == ArgumentModel_log_format_t::text)
+        return;
+
+    std::vector<std::pair<std::string, std::string>> fields;
+
+    auto name_items  = split_list(names);
+    auto value_items = split_list(values);
+    if(name_items.size() != value_items.size())
+    {
+        hipblaslt_cerr << "Mismatched names and values in log record" << std::endl;
+        return;
+    }
+    for(size_t i = 0; i < name_items.size(); i++)
+        fields.emplace_back(name_items[i], value_items[i]);
+    fields.insert(fields.end(), extra.begin(), extra.end());
+    fields.insert(fields.end(), log_provenance.begin(), log_provenance.end());
+
+    std::lock_guard<std::mutex> lock(log_mutex);
+    hipblaslt_internal_ostream& os = log_file ? *log_file : hipblaslt_cout;
+    if(log_format == ArgumentModel_log_format_t::json)
+    {
+        const char* delim = "{";
+        for(auto& field : fields)
+        {
+            os << delim;
+            json_string(os, field.first);
+            os << ":";
+            if(is_json_number(field.second))
+                os << field.second;
+            else
+                json_string(os, field.second);
+            delim = ",";
+        }
+        os << "}\n";
+    }
+    else
+    {
+        // Kernel and solution names may contain commas, so CSV values are quoted when needed
+        auto csv = [](const std::string& s) {
+            if(s.find_first_of(",\"") == std::string::npos)
+                return s;
+            std::string quoted = "\"";
+            for(char c : s)
+                quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+            return quoted + "\"";
+        };
+
+        std::string header, row;
+        for(auto& field : fields)
+        {
+            header += (header.empty() ? "" : ",") + csv(field.first);
+            row += (row.empty() ? "" : ",") + csv(field.second);
+        }
+
+        // A new header is written whenever the set of columns changes
+        if(header != log_csv_header)
+        {
+            os << header << "\n";
+            log_csv_header = header;
+        }
+        os << row << "\n";
+    }
+    os.flush();
+}
+
 void ArgumentModel_log_frequencies(hipblaslt_internal_ostream& name_line,
                                    hipblaslt_internal_ostream& val_line)
 {
@@ -78,4 +228,102 @@ void ArgumentModel_log_frequencies(hipblaslt_internal_ostream& name_line,
 
     name_line << ",median-MCLK";
     val_line << "," << frequency_monitor.getMedianMEMCLK();
+
+    log_totals.clock_samples++;
+    log_totals.sysclk_mhz += frequency_monitor.getLowestAverageSYSCLK();
+    log_totals.memclk_mhz += frequency_monitor.getAverageMEMCLK();
+}
+
+void ArgumentModel_add_totals(double gflop, double gpu_us)
+{
+    log_totals.problems++;
+    log_totals.gflop += gflop;
+    log_totals.gpu_us += gpu_us;
+}
+
+ArgumentModel_totals ArgumentModel_get_totals()
+{
+    return log_totals;
+}
+
+static thread_local std::function<void()> timing_start_hook;
+
+void ArgumentModel_set_timing_start_hook(std::function<void()> hook)
+{
+    timing_start_hook = std::move(hook);
+}
+
+void ArgumentModel_timing_start()
+{
+    if(timing_start_hook)
+    {
+        auto hook         = std::move(timing_start_hook);
+        timing_start_hook = nullptr;
+        hook();
+    }
+}
+
+static std::string                    tuning_report_path;
+static std::unique_ptr<std::ofstream> tuning_report;
+static size_t                         tuning_problems    = 0;
+static double                         tuning_default_us  = 0;
+static double                         tuning_best_us     = 0;
+static double                         tuning_log_speedup = 0;
+
+void ArgumentModel_set_tuning_report(const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(log_mutex);
+    if(file == tuning_report_path)
+        return;
+    tuning_report_path = file;
+    tuning_report.reset();
+    if(file.empty())
+        return;
+    tuning_report = std::make_unique<std::ofstream>(file);
+    *tuning_report << "problem,default_solution_index,default_us,best_solution_index,best_us,"
+                      "speedup,solutions_tried,solutions_total"
+                   << std::endl;
+}
+
+bool ArgumentModel_get_tuning_report()
+{
+    return tuning_report != nullptr;
+}
+
+void ArgumentModel_log_tuning_result(const std::string& problem,
+                                     int32_t            default_index,
+                                     double             default_us,
+                                     int32_t            best_index,
+                                     double             best_us,
+                                     size_t             solutions_tried,
+                                     size_t             solutions_total)
+{
+    // The default solution is not always among the candidates, e.g. with --requested_solution
+    bool   has_default = default_us > 0 && best_us > 0;
+    double speedup     = has_default ? default_us / best_us : ArgumentLogging::NA_value;
+
+    std::lock_guard<std::mutex> lock(log_mutex);
+    if(has_default)
+    {
+        tuning_problems++;
+        tuning_default_us += default_us;
+        tuning_best_us += best_us;
+        tuning_log_speedup += std::log(speedup);
+    }
+
+    if(!tuning_report)
+        return;
+    *tuning_report << problem << "," << default_index << "," << default_us << "," << best_index
+                   << "," << best_us << "," << speedup << "," << solutions_tried << ","
+                   << solutions_total << std::endl;
+}
+
+void ArgumentModel_print_tuning_summary(hipblaslt_internal_ostream& os)
+{
+    if(!tuning_problems)
+        return;
+    os << "Tuned " << tuning_problems << " problems: default heuristic " << tuning_default_us
+       << " us, tuned " << tuning_best_us << " us, total speedup "
+       << tuning_default_us / tuning_best_us << ", geometric mean speedup "
+       << std::exp(tuning_log_speedup / tuning_problems) << std::endl;
 }
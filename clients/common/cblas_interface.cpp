@@ -25,8 +25,10 @@
  *******************************************************************************/
 #include "cblas_interface.hpp"
 #include "datatype_interface.hpp"
+#include "hipblaslt_f8_convert.hpp"
 #include "hipblaslt_vector.hpp"
 #include "utility.hpp"
+#include <algorithm>
 #include <bitset>
 #include <iostream>
 #include <omp.h>
@@ -85,7 +87,29 @@ void sat_cast_mul(TD* dst, customVector<TcCast>& src, Tc scale, size_t size)
                  || (!std::is_same<TD, hipblaslt_bf8_fnuz>::value
                      && !std::is_same<TD, hipblaslt_f8_fnuz>::value))
     {
-        if(scale != 1)
+        if constexpr(std::is_same<TcCast, float>::value && std::is_same<Tc, float>::value
+                     && (std::is_same<TD, hipblaslt_f8_fnuz>::value
+                         || std::is_same<TD, hipblaslt_bf8_fnuz>::value))
+        {
+            if(scale != 1)
+            {
+                constexpr size_t block = 4096;
+#pragma omp parallel for
+                for(size_t b = 0; b < size; b += block)
+                {
+                    float  tmp[block];
+                    size_t n = std::min(block, size - b);
+                    for(size_t i = 0; i < n; i++)
+                        tmp[i] = src[b + i] * scale;
+                    hipblaslt_float_to_f8(tmp, dst + b, n);
+                }
+            }
+            else
+            {
+                hipblaslt_float_to_f8(static_cast<float*>(src), dst, size);
+            }
+        }
+        else if(scale != 1)
         {
             for(size_t i = 0; i < size; i++)
                 dst[i] = saturate_cast<TD>(src[i] * scale);
@@ -157,10 +181,21 @@ void cast_mul(customVector<TcCast>& dst, const TiA* src, size_t size)
                      || !(std::is_same<TiA, hipblaslt_bf8>::value
                           || std::is_same<TiA, hipblaslt_f8>::value))
 #endif
-            for(size_t i = 0; i < size; i++)
+        {
+            if constexpr(std::is_same<TcCast, float>::value
+                         && (std::is_same<TiA, hipblaslt_f8_fnuz>::value
+                             || std::is_same<TiA, hipblaslt_bf8_fnuz>::value))
+            {
+                hipblaslt_f8_to_float(src, static_cast<float*>(dst), size);
+            }
+            else
             {
-                dst[i] = static_cast<TcCast>(src[i]);
+                for(size_t i = 0; i < size; i++)
+                {
+                    dst[i] = static_cast<TcCast>(src[i]);
+                }
             }
+        }
     }
 }
 
@@ -219,7 +254,23 @@ void cast_mul(customVector<TcCast>& dst,
               int64_t               k,
               size_t                size)
 {
-    if constexpr((std::is_same<TcCast, float>::value)
+    if constexpr(std::is_same<TcCast, float>::value
+                 && (std::is_same<TiA, hipblaslt_f8_fnuz>::value
+                     || std::is_same<TiA, hipblaslt_bf8_fnuz>::value))
+    {
+        // Decode in bulk, then scale the decoded values in place
+        hipblaslt_f8_to_float(A, static_cast<float*>(dst), size);
+        cast_mul<TcCast, Tc, TcCast>(dst,
+                                     static_cast<const TcCast*>(dst),
+                                     isScaleAVec,
+                                     scaleAVec,
+                                     AlphaVec,
+                                     transA,
+                                     m,
+                                     k,
+                                     size);
+    }
+    else if constexpr((std::is_same<TcCast, float>::value)
                  || (!std::is_same<TiA, hipblaslt_bf8_fnuz>::value
                      && !std::is_same<TiA, hipblaslt_f8_fnuz>::value))
     {
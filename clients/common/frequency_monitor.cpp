@@ -517,7 +517,8 @@ public:
 #endif
 };
 
-static FrequencyMonitorImp* g_FreqMonitorInstance{nullptr};
+// One monitor per host thread, so that hipblaslt-bench --devices samples every device
+static thread_local FrequencyMonitorImp* g_FreqMonitorInstance{nullptr};
 
 FrequencyMonitor& getFrequencyMonitor()
 {
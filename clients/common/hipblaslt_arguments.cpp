@@ -127,6 +127,7 @@ void Arguments::init()
     rotating                 = 0;
     use_gpu_timer            = false;
     skip_slow_solution_ratio = 0.0;
+    tuning_budget_ms         = 0.0f;
     // tuning
     gsu_vector[0] = 0;
     for(int32_t i = 1; i < MAX_SUPPORTED_NUM_PROBLEMS; i++)
@@ -141,6 +142,15 @@ void Arguments::init()
 
     print_solution_found = false;
     flush                = false;
+
+    timing_stats     = false;
+    timing_ci        = 0.0f;
+    timing_budget_ms = 1000.0f;
+
+    print_roofline = false;
+
+    deterministic     = false;
+    audit_determinism = 0;
 }
 
 // Function to print Arguments out to stream in YAML format
@@ -0,0 +1,411 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "hipblaslt_f8_convert.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define HIPBLASLT_F8_CVT_X86 1
+#endif
+
+namespace
+{
+    // Elements per OpenMP task; large enough that the parallel region pays for itself
+    constexpr size_t f8_cvt_chunk = 1 << 16;
+
+    template <typename T>
+    struct f8_traits;
+
+    // wm/we and bias of the fnuz types, see hipblaslt_hip_f8_impl::cast_to_f8
+    template <>
+    struct f8_traits<hipblaslt_f8_fnuz>
+    {
+        static constexpr int      wm      = 3;
+        static constexpr int      we      = 4;
+        static constexpr bool     simd    = true;
+        static constexpr uint32_t max_abs = 0x43700000; // 240.0f
+    };
+
+    template <>
+    struct f8_traits<hipblaslt_bf8_fnuz>
+    {
+        static constexpr int      wm      = 2;
+        static constexpr int      we      = 5;
+        static constexpr bool     simd    = true;
+        static constexpr uint32_t max_abs = 0x47600000; // 57344.0f
+    };
+
+#ifdef ROCM_USE_FLOAT8
+    template <>
+    struct f8_traits<hipblaslt_f8>
+    {
+        static constexpr bool simd = false;
+    };
+
+    template <>
+    struct f8_traits<hipblaslt_bf8>
+    {
+        static constexpr bool simd = false;
+    };
+#endif
+
+    // Constants shared by the SIMD encoders. Only valid for the fnuz types, which are the
+    // ones with negative_zero_nan = true and clip = true.
+    template <typename T>
+    struct f8_encode_consts
+    {
+        static constexpr int wm      = f8_traits<T>::wm;
+        static constexpr int we      = f8_traits<T>::we;
+        static constexpr int f8_bias = 1 << (we - 1);
+        static constexpr int drop    = 23 - wm;
+        // Rebias the f32 exponent field to the f8 one after shifting out the dropped bits
+        static constexpr uint32_t rebias = uint32_t(127 - f8_bias) << wm;
+        // Smallest f8 normal, 2^(1 - bias)
+        static constexpr uint32_t min_normal = uint32_t(128 - f8_bias) << 23;
+        // Adding 2^(24 - bias - wm) leaves an ulp equal to the f8 denormal step, so the FPU
+        // does the round to nearest even for us in the denormal range
+        static constexpr uint32_t denorm_magic = uint32_t(151 - f8_bias - wm) << 23;
+    };
+
+    template <typename T>
+    inline uint8_t f8_bits(T v)
+    {
+        uint8_t bits;
+        std::memcpy(&bits, &v, 1);
+        return bits;
+    }
+
+    template <typename T>
+    inline T f8_from_bits(uint8_t bits)
+    {
+        T v;
+        std::memcpy(&v, &bits, 1);
+        return v;
+    }
+
+    template <typename T>
+    inline uint8_t encode_scalar(float v, const uint32_t* rng, size_t i)
+    {
+        if(rng)
+            return f8_bits(T(v, T::hipblaslt_hip_f8_rounding_mode::stochastic, rng[i]));
+        return f8_bits(T(v));
+    }
+
+    template <typename T>
+    void encode_range_scalar(const float* src, uint8_t* dst, size_t size, const uint32_t* rng)
+    {
+        for(size_t i = 0; i < size; i++)
+            dst[i] = encode_scalar<T>(src[i], rng, i);
+    }
+
+#ifdef HIPBLASLT_F8_CVT_X86
+    template <typename T>
+    __attribute__((target("avx2"))) void
+        encode_range_avx2(const float* src, uint8_t* dst, size_t size, const uint32_t* rng)
+    {
+        using C = f8_encode_consts<T>;
+
+        const __m256i abs_mask   = _mm256_set1_epi32(0x7FFFFFFF);
+        const __m256i inf_bits   = _mm256_set1_epi32(0x7F7FFFFF);
+        const __m256  max_abs    = _mm256_castsi256_ps(_mm256_set1_epi32(f8_traits<T>::max_abs));
+        const __m256  min_normal = _mm256_castsi256_ps(_mm256_set1_epi32(C::min_normal));
+        const __m256  magic      = _mm256_castsi256_ps(_mm256_set1_epi32(C::denorm_magic));
+        const __m256i half_m1    = _mm256_set1_epi32((1 << (C::drop - 1)) - 1);
+        const __m256i drop_mask  = _mm256_set1_epi32((1 << C::drop) - 1);
+        const __m256i one        = _mm256_set1_epi32(1);
+        const __m256i rebias     = _mm256_set1_epi32(C::rebias);
+        const __m256i nan_code   = _mm256_set1_epi32(0x80);
+        const __m256i zero       = _mm256_setzero_si256();
+
+        size_t i = 0;
+        for(; i + 8 <= size; i += 8)
+        {
+            __m256i bits    = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+            __m256i sign    = _mm256_and_si256(_mm256_srli_epi32(bits, 24), nan_code);
+            __m256i abs     = _mm256_and_si256(bits, abs_mask);
+            __m256i special = _mm256_cmpgt_epi32(abs, inf_bits);
+
+            // Saturate before rounding; every finite value >= max_abs encodes to max_abs
+            __m256  absf   = _mm256_min_ps(_mm256_castsi256_ps(abs), max_abs);
+            __m256i absc   = _mm256_castps_si256(absf);
+            __m256  denorm = _mm256_cmp_ps(absf, min_normal, _CMP_LT_OQ);
+
+            __m256i code;
+            if(rng)
+            {
+                __m256i r = _mm256_and_si256(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rng + i)), drop_mask);
+                code = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_add_epi32(absc, r), C::drop),
+                                        rebias);
+            }
+            else
+            {
+                __m256i odd = _mm256_and_si256(_mm256_srli_epi32(absc, C::drop), one);
+                __m256i rne = _mm256_add_epi32(_mm256_add_epi32(absc, half_m1), odd);
+                code        = _mm256_sub_epi32(_mm256_srli_epi32(rne, C::drop), rebias);
+                __m256i den = _mm256_sub_epi32(
+                    _mm256_castps_si256(_mm256_add_ps(absf, magic)), _mm256_castps_si256(magic));
+                code = _mm256_blendv_epi8(code, den, _mm256_castps_si256(denorm));
+            }
+
+            // negative_zero_nan: zero never carries the sign, inf/NaN become 0x80
+            __m256i is_zero = _mm256_cmpeq_epi32(code, zero);
+            code            = _mm256_or_si256(code, _mm256_andnot_si256(is_zero, sign));
+            code            = _mm256_blendv_epi8(code, nan_code, special);
+
+            __m128i p16 = _mm_packus_epi32(_mm256_castsi256_si128(code),
+                                           _mm256_extracti128_si256(code, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(p16, p16));
+
+            // Stochastic rounding of f8 denormals shifts the mantissa before adding rng, so
+            // those lanes are redone with the scalar conversion
+            if(rng)
+            {
+                int lanes = _mm256_movemask_ps(
+                    _mm256_andnot_ps(_mm256_castsi256_ps(special), denorm));
+                while(lanes)
+                {
+                    int l          = __builtin_ctz(lanes);
+                    dst[i + l]     = encode_scalar<T>(src[i + l], rng, i + l);
+                    lanes         &= lanes - 1;
+                }
+            }
+        }
+        encode_range_scalar<T>(src + i, dst + i, size - i, rng ? rng + i : nullptr);
+    }
+
+    template <typename T>
+    __attribute__((target("avx512f"))) void
+        encode_range_avx512(const float* src, uint8_t* dst, size_t size, const uint32_t* rng)
+    {
+        using C = f8_encode_consts<T>;
+
+        const __m512i abs_mask   = _mm512_set1_epi32(0x7FFFFFFF);
+        const __m512i inf_bits   = _mm512_set1_epi32(0x7F7FFFFF);
+        const __m512  max_abs    = _mm512_castsi512_ps(_mm512_set1_epi32(f8_traits<T>::max_abs));
+        const __m512  min_normal = _mm512_castsi512_ps(_mm512_set1_epi32(C::min_normal));
+        const __m512  magic      = _mm512_castsi512_ps(_mm512_set1_epi32(C::denorm_magic));
+        const __m512i half_m1    = _mm512_set1_epi32((1 << (C::drop - 1)) - 1);
+        const __m512i drop_mask  = _mm512_set1_epi32((1 << C::drop) - 1);
+        const __m512i one        = _mm512_set1_epi32(1);
+        const __m512i rebias     = _mm512_set1_epi32(C::rebias);
+        const __m512i nan_code   = _mm512_set1_epi32(0x80);
+
+        size_t i = 0;
+        for(; i + 16 <= size; i += 16)
+        {
+            __m512i   bits    = _mm512_castps_si512(_mm512_loadu_ps(src + i));
+            __m512i   sign    = _mm512_and_si512(_mm512_srli_epi32(bits, 24), nan_code);
+            __m512i   abs     = _mm512_and_si512(bits, abs_mask);
+            __mmask16 special = _mm512_cmpgt_epi32_mask(abs, inf_bits);
+
+            __m512    absf   = _mm512_min_ps(_mm512_castsi512_ps(abs), max_abs);
+            __m512i   absc   = _mm512_castps_si512(absf);
+            __mmask16 denorm = _mm512_cmp_ps_mask(absf, min_normal, _CMP_LT_OQ);
+
+            __m512i code;
+            if(rng)
+            {
+                __m512i r = _mm512_and_si512(_mm512_loadu_si512(rng + i), drop_mask);
+                code = _mm512_sub_epi32(_mm512_srli_epi32(_mm512_add_epi32(absc, r), C::drop),
+                                        rebias);
+            }
+            else
+            {
+                __m512i odd = _mm512_and_si512(_mm512_srli_epi32(absc, C::drop), one);
+                __m512i rne = _mm512_add_epi32(_mm512_add_epi32(absc, half_m1), odd);
+                code        = _mm512_sub_epi32(_mm512_srli_epi32(rne, C::drop), rebias);
+                __m512i den = _mm512_sub_epi32(
+                    _mm512_castps_si512(_mm512_add_ps(absf, magic)), _mm512_castps_si512(magic));
+                code = _mm512_mask_blend_epi32(denorm, code, den);
+            }
+
+            __mmask16 nonzero = _mm512_test_epi32_mask(code, code);
+            code              = _mm512_mask_or_epi32(code, nonzero, code, sign);
+            code              = _mm512_mask_blend_epi32(special, code, nan_code);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm512_cvtepi32_epi8(code));
+
+            if(rng)
+            {
+                unsigned lanes = denorm & ~special;
+                while(lanes)
+                {
+                    int l          = __builtin_ctz(lanes);
+                    dst[i + l]     = encode_scalar<T>(src[i + l], rng, i + l);
+                    lanes         &= lanes - 1;
+                }
+            }
+        }
+        encode_range_scalar<T>(src + i, dst + i, size - i, rng ? rng + i : nullptr);
+    }
+#endif
+
+    hipblaslt_f8_cvt_isa f8_cvt_isa_supported()
+    {
+#ifdef HIPBLASLT_F8_CVT_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return hipblaslt_f8_cvt_isa::avx512;
+        if(__builtin_cpu_supports("avx2"))
+            return hipblaslt_f8_cvt_isa::avx2;
+#endif
+        return hipblaslt_f8_cvt_isa::scalar;
+    }
+
+    std::atomic<hipblaslt_f8_cvt_isa>& f8_cvt_isa()
+    {
+        static std::atomic<hipblaslt_f8_cvt_isa> isa{f8_cvt_isa_supported()};
+        return isa;
+    }
+
+    template <typename T>
+    void encode_range(const float* src, uint8_t* dst, size_t size, const uint32_t* rng)
+    {
+        if constexpr(f8_traits<T>::simd)
+        {
+#ifdef HIPBLASLT_F8_CVT_X86
+            switch(f8_cvt_isa().load(std::memory_order_relaxed))
+            {
+            case hipblaslt_f8_cvt_isa::avx512:
+                return encode_range_avx512<T>(src, dst, size, rng);
+            case hipblaslt_f8_cvt_isa::avx2:
+                return encode_range_avx2<T>(src, dst, size, rng);
+            default:
+                break;
+            }
+#endif
+        }
+        encode_range_scalar<T>(src, dst, size, rng);
+    }
+} // namespace
+
+hipblaslt_f8_cvt_isa hipblaslt_f8_get_cvt_isa()
+{
+    return f8_cvt_isa().load();
+}
+
+hipblaslt_f8_cvt_isa hipblaslt_f8_set_cvt_isa(hipblaslt_f8_cvt_isa isa)
+{
+    auto supported = f8_cvt_isa_supported();
+    if(static_cast<int>(isa) > static_cast<int>(supported))
+        isa = supported;
+    f8_cvt_isa().store(isa);
+    return isa;
+}
+
+const char* hipblaslt_f8_cvt_isa_to_string(hipblaslt_f8_cvt_isa isa)
+{
+    switch(isa)
+    {
+    case hipblaslt_f8_cvt_isa::scalar:
+        return "scalar";
+    case hipblaslt_f8_cvt_isa::avx2:
+        return "avx2";
+    case hipblaslt_f8_cvt_isa::avx512:
+        return "avx512";
+    }
+    return "invalid";
+}
+
+template <typename T>
+const float* hipblaslt_f8_decode_table()
+{
+    static const struct table
+    {
+        float value[256];
+        table()
+        {
+            for(int i = 0; i < 256; i++)
+                value[i] = float(f8_from_bits<T>(uint8_t(i)));
+        }
+    } t;
+    return t.value;
+}
+
+template <typename T>
+void hipblaslt_f8_to_float(const T* src, float* dst, size_t size)
+{
+    const float*   lut   = hipblaslt_f8_decode_table<T>();
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src);
+#pragma omp parallel for if(size > f8_cvt_chunk)
+    for(size_t i = 0; i < size; i++)
+        dst[i] = lut[bytes[i]];
+}
+
+template <typename T>
+void hipblaslt_float_to_f8(const float* src, T* dst, size_t size, const uint32_t* rng)
+{
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(dst);
+    if(size <= f8_cvt_chunk)
+        return encode_range<T>(src, bytes, size, rng);
+
+    size_t chunks = (size + f8_cvt_chunk - 1) / f8_cvt_chunk;
+#pragma omp parallel for
+    for(size_t c = 0; c < chunks; c++)
+    {
+        size_t begin = c * f8_cvt_chunk;
+        size_t n     = std::min(f8_cvt_chunk, size - begin);
+        encode_range<T>(src + begin, bytes + begin, n, rng ? rng + begin : nullptr);
+    }
+}
+
+template <typename T>
+void hipblaslt_half_to_f8(const hipblasLtHalf* src, T* dst, size_t size)
+{
+    // half -> float is exact, and the scalar constructor from half goes through float as well
+    constexpr size_t block = 1024;
+    size_t           chunks = (size + block - 1) / block;
+#pragma omp parallel for if(size > f8_cvt_chunk)
+    for(size_t c = 0; c < chunks; c++)
+    {
+        float  tmp[block];
+        size_t begin = c * block;
+        size_t n     = std::min(block, size - begin);
+        for(size_t i = 0; i < n; i++)
+            tmp[i] = float(src[begin + i]);
+        encode_range<T>(tmp, reinterpret_cast<uint8_t*>(dst + begin), n, nullptr);
+    }
+}
+
+#define INSTANTIATE_F8_CVT(T)                                                                  \
+    template const float* hipblaslt_f8_decode_table<T>();                                      \
+    template void         hipblaslt_f8_to_float<T>(const T* src, float* dst, size_t size);     \
+    template void         hipblaslt_float_to_f8<T>(                                            \
+        const float* src, T* dst, size_t size, const uint32_t* rng);                   \
+    template void hipblaslt_half_to_f8<T>(const hipblasLtHalf* src, T* dst, size_t size);
+
+INSTANTIATE_F8_CVT(hipblaslt_f8_fnuz)
+INSTANTIATE_F8_CVT(hipblaslt_bf8_fnuz)
+#ifdef ROCM_USE_FLOAT8
+INSTANTIATE_F8_CVT(hipblaslt_f8)
+INSTANTIATE_F8_CVT(hipblaslt_bf8)
+#endif
+
+#undef INSTANTIATE_F8_CVT
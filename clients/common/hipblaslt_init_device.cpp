@@ -47,67 +47,6 @@ void fill_batch(T* A, size_t M, size_t N, size_t lda, size_t stride, size_t batc
     fill_kernel<<<dim3(grid_size), dim3(block_size), 0, hipStreamDefault>>>(A, size, f);
 }
 
-__device__ uint32_t pseudo_random_device(size_t idx)
-{
-    // Numerical Recipes ranqd1, Chapter 7.1, ?An Even Quicker Generator, Eq. 7.1.6. parameters from Knuth and H. W. Lewis
-    auto s = idx * 1664525 + 1013904223;
-    // Run a few extra iterations to make the generators diverge
-    // in case the seeds are still poor (consecutive ints)
-    for(int i = 0; i < 3; i++)
-    {
-        // Marsaglia, G. (2003). "Xorshift RNGs". Journal of Statistical Software. 8 (14). doi:10.18637/jss.v008.i14
-        s ^= s << 13;
-        s ^= s >> 17;
-        s ^= s << 5;
-    }
-    return s;
-}
-
-/*! \brief  generate a random number in range [1,2,3,4,5,6,7,8,9,10] */
-template <typename T>
-__device__ T random_int(size_t idx)
-{
-    return T(pseudo_random_device(idx) % 10 + 1.f);
-}
-
-/*! \brief  generate a random number in range [-2,-1,0,1,2] */
-template <>
-__device__ hipblasLtHalf random_int<hipblasLtHalf>(size_t idx)
-{
-    return hipblasLtHalf(pseudo_random_device(idx) % 5 - 2.f);
-}
-
-/*! \brief  generate a random number in range [-2,-1,0,1,2] */
-template <>
-__device__ hip_bfloat16 random_int<hip_bfloat16>(size_t idx)
-{
-    return hip_bfloat16(pseudo_random_device(idx) % 5 - 2.f);
-}
-
-/*! \brief  generate a random number in range [1,2,3] */
-template <>
-__device__ int8_t random_int<int8_t>(size_t idx)
-{
-    return pseudo_random_device(idx) % 3 + 1;
-}
-
-/*! \brief  generate a random number in HPL-like [-0.5,0.5] doubles  */
-template <typename T>
-__device__ T random_hpl(size_t idx)
-{
-    auto r = pseudo_random_device(idx);
-    return T(double(r) / double(std::numeric_limits<decltype(r)>::max()) - 0.5);
-}
-
-/*! \brief  generate a random number in [-1.0,1.0] doubles  */
-template <>
-__device__ int8_t random_hpl(size_t idx)
-{
-    auto r = pseudo_random_device(idx);
-    auto v = nearbyint(double(r) / double(std::numeric_limits<decltype(r)>::max()) * 2. - 1.);
-    return int8_t(v > 127.f ? 127.f : v < -128.f ? -128.f : v);
-}
-
 template <typename T>
 void hipblaslt_init_device(ABC                      abc,
                            hipblaslt_initialization init,
@@ -119,13 +58,14 @@ void hipblaslt_init_device(ABC                      abc,
                            size_t                   stride,
                            size_t                   batch_count)
 {
+    // Tensor ids come from the same sequence as the host hipblaslt_init* routines, so after
+    // hipblaslt_seedrand() the device and host paths generate the same data
+    uint64_t seed = g_hipblaslt_counter_seed;
     if(is_nan)
     {
-        std::array<T, 100> rand_nans;
-        for(auto& r : rand_nans)
-            r = T(hipblaslt_nan_rng());
-        fill_batch(A, M, N, lda, stride, batch_count, [rand_nans](size_t idx) -> T {
-            return rand_nans[pseudo_random_device(idx) % rand_nans.size()];
+        uint32_t id = hipblaslt_next_tensor_id();
+        fill_batch(A, M, N, lda, stride, batch_count, [=](size_t idx) -> T {
+            return random_counter_nan<T>(hipblaslt_counter_rng(seed, id, idx));
         });
     }
     else
@@ -133,22 +73,26 @@ void hipblaslt_init_device(ABC                      abc,
         switch(init)
         {
         case hipblaslt_initialization::rand_int:
+        {
+            uint32_t id = hipblaslt_next_tensor_id();
             if(abc == ABC::A || abc == ABC::C)
-                fill_batch(A, M, N, lda, stride, batch_count, [](size_t idx) -> T {
-                    return random_int<T>(idx);
+                fill_batch(A, M, N, lda, stride, batch_count, [=](size_t idx) -> T {
+                    return random_counter_int<T>(hipblaslt_counter_rng(seed, id, idx));
                 });
             else if(abc == ABC::B)
             {
                 stride = std::max(lda * N, stride);
-                fill_batch(A, M, N, lda, stride, batch_count, [stride, lda](size_t idx) -> T {
+                fill_batch(A, M, N, lda, stride, batch_count, [=](size_t idx) -> T {
                     auto b     = idx / stride;
                     auto j     = (idx - b * stride) / lda;
                     auto i     = (idx - b * stride) - j * lda;
-                    auto value = random_int<T>(idx);
+                    auto r     = hipblaslt_counter_rng(seed, id, idx);
+                    auto value = random_counter_int<T>(r);
                     return (i ^ j) & 1 ? value : negate(value);
                 });
             }
-            break;
+        }
+        break;
         case hipblaslt_initialization::trig_float:
             if(abc == ABC::A || abc == ABC::C)
                 fill_batch(A, M, N, lda, stride, batch_count, [](size_t idx) -> T {
@@ -160,10 +104,13 @@ void hipblaslt_init_device(ABC                      abc,
                 });
             break;
         case hipblaslt_initialization::hpl:
-            fill_batch(A, M, N, lda, stride, batch_count, [](size_t idx) -> T {
-                return random_hpl<T>(idx);
+        {
+            uint32_t id = hipblaslt_next_tensor_id();
+            fill_batch(A, M, N, lda, stride, batch_count, [=](size_t idx) -> T {
+                return random_counter_hpl<T>(hipblaslt_counter_rng(seed, id, idx));
             });
-            break;
+        }
+        break;
         case hipblaslt_initialization::special:
             if(abc == ABC::A)
                 fill_batch(A, M, N, lda, stride, batch_count, [](size_t idx) -> T {
@@ -174,9 +121,12 @@ void hipblaslt_init_device(ABC                      abc,
                     return T(hipblasLtHalf(0.0000607967376708984375));
                 });
             else if(abc == ABC::C)
-                fill_batch(A, M, N, lda, stride, batch_count, [](size_t idx) -> T {
-                    return T(pseudo_random_device(idx) % 10 + 1.f);
+            {
+                uint32_t id = hipblaslt_next_tensor_id();
+                fill_batch(A, M, N, lda, stride, batch_count, [=](size_t idx) -> T {
+                    return T(hipblaslt_counter_rng(seed, id, idx) % 10 + 1.f);
                 });
+            }
             break;
         case hipblaslt_initialization::zero:
             fill_batch(A, M, N, lda, stride, batch_count, [](size_t idx) -> T { return T(0); });
@@ -32,6 +32,9 @@
 // argument, and print the seed on output, to ensure repeatability.
 hipblaslt_rng_t g_hipblaslt_seed(69069); // A fixed seed to start at
 
+// Key of the counter-based generator used by hipblaslt_init and hipblaslt_init_device
+uint64_t g_hipblaslt_counter_seed = 69069;
+
 // This records the main thread ID at startup
 std::thread::id g_main_thread_id = std::this_thread::get_id();
 
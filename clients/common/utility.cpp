@@ -27,6 +27,7 @@
 #include "utility.hpp"
 #include "d_vector.hpp"
 #include <chrono>
+#include <hipblaslt/hipblaslt-ext.hpp>
 #include <cstdlib>
 #include <new>
 #include <stdexcept>
@@ -241,6 +242,13 @@ hipblaslt_local_handle::hipblaslt_local_handle(const Arguments& arg)
 
     // memory guard control, with multi-threading should not change values across threads
     d_vector_set_pad_length(arg.pad);
+
+    if(arg.deterministic)
+    {
+        auto status = hipblaslt_ext::setDeterministicMode(m_handle, true);
+        if(status != HIPBLAS_STATUS_SUCCESS)
+            throw std::runtime_error(hipblas_status_to_string(status));
+    }
 }
 
 hipblaslt_local_handle::~hipblaslt_local_handle()
@@ -92,6 +92,30 @@ namespace
                 testing_aux_matmul_pref_init(arg);
             else if(!strcmp(arg.function, "aux_matmul_alg_null_matmul"))
                 testing_aux_matmul_alg_null_matmul(arg);
+            else if(!strcmp(arg.function, "aux_matmul_autotune"))
+                testing_aux_matmul_autotune(arg);
+            else if(!strcmp(arg.function, "aux_tuning_override_convert"))
+                testing_aux_tuning_override_convert(arg);
+            else if(!strcmp(arg.function, "aux_tuning_override_match"))
+                testing_aux_tuning_override_match(arg);
+            else if(!strcmp(arg.function, "aux_host_metrics"))
+                testing_aux_host_metrics(arg);
+            else if(!strcmp(arg.function, "aux_heuristic_roofline"))
+                testing_aux_heuristic_roofline(arg);
+            else if(!strcmp(arg.function, "aux_get_all_algos_stream"))
+                testing_aux_get_all_algos_stream(arg);
+            else if(!strcmp(arg.function, "aux_heuristic_cache"))
+                testing_aux_heuristic_cache(arg);
+            else if(!strcmp(arg.function, "aux_code_object_residency"))
+                testing_aux_code_object_residency(arg);
+            else if(!strcmp(arg.function, "aux_preload_profile"))
+                testing_aux_preload_profile(arg);
+            else if(!strcmp(arg.function, "aux_grouped_gemm_route"))
+                testing_aux_grouped_gemm_route(arg);
+            else if(!strcmp(arg.function, "aux_available_cus"))
+                testing_aux_available_cus(arg);
+            else if(!strcmp(arg.function, "aux_deterministic_runs"))
+                testing_aux_deterministic_runs(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -131,6 +155,18 @@ namespace
                    || !strcmp(arg.function, "aux_matmul_plan_init_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_plan_init")
                    || !strcmp(arg.function, "aux_matmul_alg_null_matmul")
+                   || !strcmp(arg.function, "aux_matmul_autotune")
+                   || !strcmp(arg.function, "aux_tuning_override_convert")
+                   || !strcmp(arg.function, "aux_tuning_override_match")
+                   || !strcmp(arg.function, "aux_host_metrics")
+                   || !strcmp(arg.function, "aux_heuristic_roofline")
+                   || !strcmp(arg.function, "aux_get_all_algos_stream")
+                   || !strcmp(arg.function, "aux_heuristic_cache")
+                   || !strcmp(arg.function, "aux_code_object_residency")
+                   || !strcmp(arg.function, "aux_preload_profile")
+                   || !strcmp(arg.function, "aux_grouped_gemm_route")
+                   || !strcmp(arg.function, "aux_available_cus")
+                   || !strcmp(arg.function, "aux_deterministic_runs")
                    || !strcmp(arg.function, "aux_matmul_pref_get_attr_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_pref_get_attr");
         }
@@ -0,0 +1,236 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "hipblaslt_f8_convert.hpp"
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <hipblaslt/hipblaslt.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Restores the encode path selected at startup when a test ends
+    struct F8CvtIsaGuard
+    {
+        hipblaslt_f8_cvt_isa saved = hipblaslt_f8_get_cvt_isa();
+        ~F8CvtIsaGuard()
+        {
+            hipblaslt_f8_set_cvt_isa(saved);
+        }
+    };
+
+    template <typename T>
+    void check_decode_exhaustive()
+    {
+        std::vector<T>     src(256);
+        std::vector<float> dst(256);
+        for(int i = 0; i < 256; i++)
+            src[i].data = uint8_t(i);
+
+        hipblaslt_f8_to_float(src.data(), dst.data(), src.size());
+
+        for(int i = 0; i < 256; i++)
+        {
+            float ref = float(src[i]);
+            EXPECT_EQ(0, std::memcmp(&ref, &dst[i], sizeof(float)))
+                << "f8 bits 0x" << std::hex << i;
+        }
+    }
+
+    // Compares against the scalar constructor. The exhaustive sweep covers every float bit
+    // pattern; the sampled one every sign and exponent with the mantissa bits around the
+    // f8 and bf8 rounding points enumerated and the sticky bits below them random.
+    template <typename T>
+    void check_encode(bool stochastic, bool exhaustive)
+    {
+        constexpr size_t      block = 1 << 20;
+        std::vector<float>    src(block);
+        std::vector<uint32_t> rng(block);
+        std::vector<T>        dst(block);
+        std::mt19937          gen(69069);
+        uint64_t              count = exhaustive ? uint64_t(1) << 32 : uint64_t(1) << 21;
+
+        for(uint64_t base = 0; base < count; base += block)
+        {
+            for(size_t i = 0; i < block; i++)
+            {
+                uint32_t bits = uint32_t(base + i);
+                if(!exhaustive)
+                    bits = (bits >> 12) << 23 | (bits & 0xfff) << 11 | (gen() & 0x7ff);
+                std::memcpy(&src[i], &bits, sizeof(float));
+                rng[i] = gen();
+            }
+
+            hipblaslt_float_to_f8(src.data(), dst.data(), block, stochastic ? rng.data() : nullptr);
+
+            size_t mismatches = 0;
+#pragma omp parallel for reduction(+ : mismatches)
+            for(size_t i = 0; i < block; i++)
+            {
+                T ref = stochastic
+                            ? T(src[i], T::hipblaslt_hip_f8_rounding_mode::stochastic, rng[i])
+                            : T(src[i]);
+                mismatches += ref.data != dst[i].data;
+            }
+            ASSERT_EQ(mismatches, 0) << "in block starting at index 0x" << std::hex << base;
+        }
+    }
+
+    template <typename T>
+    void check_half_encode_exhaustive()
+    {
+        std::vector<hipblasLtHalf> src(1 << 16);
+        std::vector<T>             dst(src.size());
+        for(size_t i = 0; i < src.size(); i++)
+        {
+            uint16_t bits = uint16_t(i);
+            std::memcpy(&src[i], &bits, sizeof(bits));
+        }
+
+        hipblaslt_half_to_f8(src.data(), dst.data(), src.size());
+
+        for(size_t i = 0; i < src.size(); i++)
+            EXPECT_EQ(T(src[i]).data, dst[i].data) << "half bits 0x" << std::hex << i;
+    }
+
+    // The smallest f8 denormal is 2^denorm_exp. Inputs below half of it round to zero, also
+    // when cast_to_f8 would shift its mantissa by 32 bits or more; the sign is dropped since
+    // the fnuz formats have no negative zero.
+    template <typename T>
+    void check_round_below_denormal(int denorm_exp)
+    {
+        for(float sign : {1.0f, -1.0f})
+        {
+            for(int e = -149; e < denorm_exp - 1; e++)
+            {
+                float x = sign * std::ldexp(1.5f, e - 1);
+                EXPECT_EQ(T(x).data, 0) << x;
+            }
+            // A tie rounds to even, anything above it to the smallest denormal
+            float half = std::ldexp(sign, denorm_exp - 1);
+            EXPECT_EQ(T(half).data, 0);
+            EXPECT_EQ(T(std::nextafter(half, 2 * half)).data, sign > 0 ? 0x01 : 0x81);
+
+            // Too small to reach the rounding bits, so even the largest rng keeps them at zero
+            for(float x : {std::ldexp(sign, -64), std::ldexp(sign, -126), sign * 1.0e-45f})
+                EXPECT_EQ(T(x, T::hipblaslt_hip_f8_rounding_mode::stochastic, 0xffffffff).data, 0)
+                    << x;
+        }
+    }
+} // namespace
+
+// GTEST_SKIP() only returns from the function it is expanded in, so this is used in the TEST
+// bodies rather than in the helpers above.
+#define F8_REQUIRE_CVT_ISA(isa)                                                              \
+    F8CvtIsaGuard guard;                                                                     \
+    if(hipblaslt_f8_set_cvt_isa(isa) != isa)                                                 \
+        GTEST_SKIP() << hipblaslt_f8_cvt_isa_to_string(isa) << " not supported on this host"
+
+TEST(F8ConvertTest, decodeF8)
+{
+    check_decode_exhaustive<hipblaslt_f8_fnuz>();
+}
+
+TEST(F8ConvertTest, decodeBF8)
+{
+    check_decode_exhaustive<hipblaslt_bf8_fnuz>();
+}
+
+TEST(F8ConvertTest, roundF8BelowDenormal)
+{
+    check_round_below_denormal<hipblaslt_f8_fnuz>(-10);
+}
+
+TEST(F8ConvertTest, roundBF8BelowDenormal)
+{
+    check_round_below_denormal<hipblaslt_bf8_fnuz>(-17);
+}
+
+TEST(F8ConvertTest, encodeF8Avx2)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx2);
+    check_encode<hipblaslt_f8_fnuz>(false, false);
+    check_encode<hipblaslt_f8_fnuz>(true, false);
+}
+
+TEST(F8ConvertTest, encodeBF8Avx2)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx2);
+    check_encode<hipblaslt_bf8_fnuz>(false, false);
+    check_encode<hipblaslt_bf8_fnuz>(true, false);
+}
+
+TEST(F8ConvertTest, encodeF8Avx512)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx512);
+    check_encode<hipblaslt_f8_fnuz>(false, false);
+    check_encode<hipblaslt_f8_fnuz>(true, false);
+}
+
+TEST(F8ConvertTest, encodeBF8Avx512)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx512);
+    check_encode<hipblaslt_bf8_fnuz>(false, false);
+    check_encode<hipblaslt_bf8_fnuz>(true, false);
+}
+
+// The exhaustive sweeps take minutes, so they are disabled by default; run them with
+// --gtest_also_run_disabled_tests --gtest_filter=*Exhaustive
+TEST(F8ConvertTest, DISABLED_encodeF8Avx2Exhaustive)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx2);
+    check_encode<hipblaslt_f8_fnuz>(false, true);
+    check_encode<hipblaslt_f8_fnuz>(true, true);
+}
+
+TEST(F8ConvertTest, DISABLED_encodeBF8Avx2Exhaustive)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx2);
+    check_encode<hipblaslt_bf8_fnuz>(false, true);
+    check_encode<hipblaslt_bf8_fnuz>(true, true);
+}
+
+TEST(F8ConvertTest, DISABLED_encodeF8Avx512Exhaustive)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx512);
+    check_encode<hipblaslt_f8_fnuz>(false, true);
+    check_encode<hipblaslt_f8_fnuz>(true, true);
+}
+
+TEST(F8ConvertTest, DISABLED_encodeBF8Avx512Exhaustive)
+{
+    F8_REQUIRE_CVT_ISA(hipblaslt_f8_cvt_isa::avx512);
+    check_encode<hipblaslt_bf8_fnuz>(false, true);
+    check_encode<hipblaslt_bf8_fnuz>(true, true);
+}
+
+TEST(F8ConvertTest, encodeFromHalf)
+{
+    check_half_encode_exhaustive<hipblaslt_f8_fnuz>();
+    check_half_encode_exhaustive<hipblaslt_bf8_fnuz>();
+}
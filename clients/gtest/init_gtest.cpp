@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "datatype_interface.hpp"
+#include "hipblaslt_init.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <hipblaslt/hipblaslt.h>
+#include <omp.h>
+#include <vector>
+
+namespace
+{
+    constexpr size_t M = 67, N = 33, lda = 71, stride = lda * N + 5, batch_count = 3;
+    constexpr size_t size = stride * batch_count;
+
+    // Restores the OpenMP thread count when a test ends
+    struct OmpThreadsGuard
+    {
+        int saved = omp_get_max_threads();
+        ~OmpThreadsGuard()
+        {
+            omp_set_num_threads(saved);
+        }
+    };
+
+    template <typename T>
+    std::vector<T> init_on_device(ABC abc, hipblaslt_initialization init, bool is_nan)
+    {
+        std::vector<T> h(size);
+        T*             d = nullptr;
+        EXPECT_EQ(hipMalloc(&d, size * sizeof(T)), hipSuccess);
+        hipblaslt_init_device(
+            abc, init, is_nan, d, M, N, lda, hipblaslt_type2datatype<T>(), stride, batch_count);
+        EXPECT_EQ(hipMemcpy(h.data(), d, size * sizeof(T), hipMemcpyDeviceToHost), hipSuccess);
+        EXPECT_EQ(hipFree(d), hipSuccess);
+        return h;
+    }
+
+    // Compares the M x N part of every batch, which is what the host routines write
+    template <typename T>
+    void expect_matrix_eq(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        size_t mismatches = 0;
+        for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
+            for(size_t j = 0; j < N; j++)
+                for(size_t i = 0; i < M; i++)
+                {
+                    size_t idx = i + j * lda + i_batch * stride;
+                    mismatches += std::memcmp(&a[idx], &b[idx], sizeof(T)) != 0;
+                }
+        EXPECT_EQ(mismatches, 0);
+    }
+
+    template <typename T>
+    void check_host_device_equal()
+    {
+        hipblaslt_seedrand();
+        auto dA = init_on_device<T>(ABC::A, hipblaslt_initialization::rand_int, false);
+        auto dB = init_on_device<T>(ABC::B, hipblaslt_initialization::rand_int, false);
+        auto dH = init_on_device<T>(ABC::C, hipblaslt_initialization::hpl, false);
+
+        hipblaslt_seedrand();
+        std::vector<T> hA(size), hB(size), hH(size);
+        hipblaslt_init(hA.data(), M, N, lda, stride, batch_count);
+        hipblaslt_init_alternating_sign(hB.data(), M, N, lda, stride, batch_count);
+        hipblaslt_init_hpl(hH.data(), M, N, lda, stride, batch_count);
+
+        expect_matrix_eq(dA, hA);
+        expect_matrix_eq(dB, hB);
+        expect_matrix_eq(dH, hH);
+
+        // NaN initialization fills the whole buffer on both paths
+        hipblaslt_seedrand();
+        auto dNan = init_on_device<T>(ABC::A, hipblaslt_initialization::rand_int, true);
+        hipblaslt_seedrand();
+        std::vector<T> hNan(size);
+        hipblaslt_init_nan(hNan.data(), size);
+        EXPECT_EQ(0, std::memcmp(dNan.data(), hNan.data(), size * sizeof(T)));
+    }
+
+    template <typename T>
+    void check_thread_count_independent()
+    {
+        OmpThreadsGuard guard;
+        std::vector<T>  ref(size), out(size);
+
+        omp_set_num_threads(1);
+        hipblaslt_seedrand();
+        hipblaslt_init(ref.data(), M, N, lda, stride, batch_count);
+
+        for(int threads : {2, 3, 8, guard.saved})
+        {
+            omp_set_num_threads(threads);
+            hipblaslt_seedrand();
+            hipblaslt_init(out.data(), M, N, lda, stride, batch_count);
+            SCOPED_TRACE(threads);
+            expect_matrix_eq(ref, out);
+        }
+    }
+} // namespace
+
+TEST(InitTest, hostDeviceEqualF32)
+{
+    check_host_device_equal<float>();
+}
+
+TEST(InitTest, hostDeviceEqualF16)
+{
+    check_host_device_equal<hipblasLtHalf>();
+}
+
+TEST(InitTest, hostDeviceEqualBF16)
+{
+    check_host_device_equal<hip_bfloat16>();
+}
+
+TEST(InitTest, hostDeviceEqualF8)
+{
+    check_host_device_equal<hipblaslt_f8_fnuz>();
+}
+
+TEST(InitTest, threadCountIndependent)
+{
+    check_thread_count_independent<float>();
+    check_thread_count_independent<hipblasLtHalf>();
+}
@@ -170,6 +170,8 @@ namespace
                     name << "_GSU" << (int)arg.gsu_vector[0];
                 if(arg.wgm_vector[0])
                     name << "_WGM" << (int)arg.wgm_vector[0];
+                if(arg.deterministic)
+                    name << "_Det";
             }
 
             return std::move(name);
@@ -31,6 +31,7 @@
 #include "hipblaslt_ostream.hpp"
 #include "hipblaslt_vector.hpp"
 #include "utility.hpp"
+#include "validate.hpp"
 #include <cstdio>
 #include <hipblaslt/hipblaslt.h>
 #include <limits>
@@ -359,6 +360,23 @@ bool allclose_check_general(char    allclose_type,
     return true;
 }
 
+/*! \brief pick the first atol/rtol pair, in the order allclose_check_general searches them,
+ *  that every element of a fused check satisfies. Returns false if there is none. */
+inline bool allclose_check_result(const hipblaslt_validate_result& result,
+                                  double&                          hipblaslt_atol,
+                                  double&                          hipblaslt_rtol)
+{
+    for(int a = 0; a < hipblaslt_allclose_num_tols; a++)
+        for(int r = 0; r < hipblaslt_allclose_num_tols; r++)
+            if(!(result.allclose_fail & (1u << (a * hipblaslt_allclose_num_tols + r))))
+            {
+                hipblaslt_atol = hipblaslt_allclose_tols[a];
+                hipblaslt_rtol = hipblaslt_allclose_tols[r];
+                return true;
+            }
+    return false;
+}
+
 bool allclose_check_general(char        allclose_type,
                             int64_t     M,
                             int64_t     N,
@@ -371,122 +389,11 @@ bool allclose_check_general(char        allclose_type,
                             double&     hipblaslt_rtol,
                             hipDataType type)
 {
-    switch(type)
-    {
-    case HIP_R_32F:
-        return allclose_check_general<float>(allclose_type,
-                                             M,
-                                             N,
-                                             lda,
-                                             stride_a,
-                                             static_cast<float*>(hCPU),
-                                             static_cast<float*>(hGPU),
-                                             batch_count,
-                                             hipblaslt_atol,
-                                             hipblaslt_rtol);
-    case HIP_R_64F:
-        return allclose_check_general<double>(allclose_type,
-                                              M,
-                                              N,
-                                              lda,
-                                              stride_a,
-                                              static_cast<double*>(hCPU),
-                                              static_cast<double*>(hGPU),
-                                              batch_count,
-                                              hipblaslt_atol,
-                                              hipblaslt_rtol);
-    case HIP_R_16F:
-        return allclose_check_general<hipblasLtHalf>(allclose_type,
-                                                     M,
-                                                     N,
-                                                     lda,
-                                                     stride_a,
-                                                     static_cast<hipblasLtHalf*>(hCPU),
-                                                     static_cast<hipblasLtHalf*>(hGPU),
-                                                     batch_count,
-                                                     hipblaslt_atol,
-                                                     hipblaslt_rtol);
-    case HIP_R_16BF:
-        return allclose_check_general<hip_bfloat16>(allclose_type,
-                                                    M,
-                                                    N,
-                                                    lda,
-                                                    stride_a,
-                                                    static_cast<hip_bfloat16*>(hCPU),
-                                                    static_cast<hip_bfloat16*>(hGPU),
-                                                    batch_count,
-                                                    hipblaslt_atol,
-                                                    hipblaslt_rtol);
-    case HIP_R_8F_E4M3_FNUZ:
-        return allclose_check_general<hipblaslt_f8_fnuz>(allclose_type,
-                                                         M,
-                                                         N,
-                                                         lda,
-                                                         stride_a,
-                                                         static_cast<hipblaslt_f8_fnuz*>(hCPU),
-                                                         static_cast<hipblaslt_f8_fnuz*>(hGPU),
-                                                         batch_count,
-                                                         hipblaslt_atol,
-                                                         hipblaslt_rtol);
-    case HIP_R_8F_E5M2_FNUZ:
-        return allclose_check_general<hipblaslt_bf8_fnuz>(allclose_type,
-                                                          M,
-                                                          N,
-                                                          lda,
-                                                          stride_a,
-                                                          static_cast<hipblaslt_bf8_fnuz*>(hCPU),
-                                                          static_cast<hipblaslt_bf8_fnuz*>(hGPU),
-                                                          batch_count,
-                                                          hipblaslt_atol,
-                                                          hipblaslt_rtol);
-#ifdef ROCM_USE_FLOAT8
-    case HIP_R_8F_E4M3:
-        return allclose_check_general<hipblaslt_f8>(allclose_type,
-                                                        M,
-                                                        N,
-                                                        lda,
-                                                        stride_a,
-                                                        static_cast<hipblaslt_f8*>(hCPU),
-                                                        static_cast<hipblaslt_f8*>(hGPU),
-                                                        batch_count,
-                                                        hipblaslt_atol,
-                                                        hipblaslt_rtol);
-    case HIP_R_8F_E5M2:
-        return allclose_check_general<hipblaslt_bf8>(allclose_type,
-                                                         M,
-                                                         N,
-                                                         lda,
-                                                         stride_a,
-                                                         static_cast<hipblaslt_bf8*>(hCPU),
-                                                         static_cast<hipblaslt_bf8*>(hGPU),
-                                                         batch_count,
-                                                         hipblaslt_atol,
-                                                         hipblaslt_rtol);
-#endif
-    case HIP_R_32I:
-        return allclose_check_general<int32_t>(allclose_type,
-                                               M,
-                                               N,
-                                               lda,
-                                               stride_a,
-                                               static_cast<int32_t*>(hCPU),
-                                               static_cast<int32_t*>(hGPU),
-                                               batch_count,
-                                               hipblaslt_atol,
-                                               hipblaslt_rtol);
-    case HIP_R_8I:
-        return allclose_check_general<hipblasLtInt8>(allclose_type,
-                                                     M,
-                                                     N,
-                                                     lda,
-                                                     stride_a,
-                                                     static_cast<hipblasLtInt8*>(hCPU),
-                                                     static_cast<hipblasLtInt8*>(hGPU),
-                                                     batch_count,
-                                                     hipblaslt_atol,
-                                                     hipblaslt_rtol);
-    default:
-        hipblaslt_cerr << "Error type in allclose_check_general" << std::endl;
-        return false;
-    }
+    if(M * N == 0)
+        return 0;
+
+    // One fused pass evaluates every atol/rtol candidate on every batch at once
+    auto result
+        = hipblaslt_validate_general(M, N, lda, stride_a, hCPU, hGPU, batch_count, 0, 0, type);
+    return allclose_check_result(result, hipblaslt_atol, hipblaslt_rtol);
 }
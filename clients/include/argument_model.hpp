@@ -27,8 +27,12 @@
 #pragma once
 
 #include "hipblaslt_arguments.hpp"
+#include "timing_stats.hpp"
 #include <fstream>
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ArgumentLogging
 {
@@ -38,9 +42,64 @@ namespace ArgumentLogging
 void ArgumentModel_set_log_function_name(bool f);
 bool ArgumentModel_get_log_function_name();
 
+enum class ArgumentModel_log_format_t
+{
+    text,
+    json, // one JSON object per line
+    csv,
+};
+
+// Structured records go to file, or replace the text output on stdout if file is empty
+void                       ArgumentModel_set_log_format(ArgumentModel_log_format_t format,
+                                                        const std::string&         file);
+ArgumentModel_log_format_t ArgumentModel_get_log_format();
+bool                       ArgumentModel_log_to_stdout();
+
+// Fields describing the run (library version, device, ...) appended to every record
+void ArgumentModel_set_log_provenance(std::vector<std::pair<std::string, std::string>> fields);
+
+// Write one structured record from the comma separated name and value lists of log_args
+void ArgumentModel_log_record(const std::string&                                      names,
+                              const std::string&                                      values,
+                              const std::vector<std::pair<std::string, std::string>>& extra);
+
 void ArgumentModel_log_frequencies(hipblaslt_internal_ostream& name_line,
                                    hipblaslt_internal_ostream& val_line);
 
+// Tuning report: one CSV row per tuned problem comparing the default heuristic solution with
+// the fastest solution found. Setting the same file again keeps appending to it.
+void ArgumentModel_set_tuning_report(const std::string& file);
+bool ArgumentModel_get_tuning_report();
+void ArgumentModel_log_tuning_result(const std::string& problem,
+                                     int32_t            default_index,
+                                     double             default_us,
+                                     int32_t            best_index,
+                                     double             best_us,
+                                     size_t             solutions_tried,
+                                     size_t             solutions_total);
+// Totals over all problems passed to ArgumentModel_log_tuning_result
+void ArgumentModel_print_tuning_summary(hipblaslt_internal_ostream& os);
+
+// Work and time of the problems run by the calling thread, for the per-device summary of
+// hipblaslt-bench --devices. Clocks are summed over the results logged while the frequency
+// monitor was enabled.
+struct ArgumentModel_totals
+{
+    size_t problems      = 0;
+    double gflop         = 0; // one call of each problem
+    double gpu_us        = 0; // one call of each problem
+    size_t clock_samples = 0;
+    double sysclk_mhz    = 0; // sum of the lowest average SYSCLK
+    double memclk_mhz    = 0; // sum of the average MEMCLK
+};
+void                 ArgumentModel_add_totals(double gflop, double gpu_us);
+ArgumentModel_totals ArgumentModel_get_totals();
+
+// The hook runs once, right before the next timed loop of the calling thread.
+// hipblaslt-bench --devices uses it to start the timed work of all devices together.
+void ArgumentModel_set_timing_start_hook(std::function<void()> hook);
+void ArgumentModel_timing_start();
+
 // ArgumentModel template has a variadic list of argument enums
 template <hipblaslt_argument... Args>
 class ArgumentModel
@@ -56,17 +115,19 @@ class ArgumentModel
     }
 
 public:
-    void log_perf(hipblaslt_internal_ostream& name_line,
-                  hipblaslt_internal_ostream& val_line,
-                  const Arguments&            arg,
-                  double                      gpu_us,
-                  double                      flush_us,
-                  double                      gflops,
-                  double                      gbytes,
-                  double                      cpu_us,
-                  double                      norm,
-                  double                      atol,
-                  double                      rtol)
+    void log_perf(hipblaslt_internal_ostream&             name_line,
+                  hipblaslt_internal_ostream&             val_line,
+                  const Arguments&                        arg,
+                  double                                  gpu_us,
+                  double                                  flush_us,
+                  double                                  gflops,
+                  double                                  gbytes,
+                  double                                  cpu_us,
+                  double                                  norm,
+                  double                                  atol,
+                  double                                  rtol,
+                  const hipblaslt_timing_stats*           timing_stats = nullptr,
+                  const hipblasLtMatmulHeuristicResult_t* estimate     = nullptr)
     {
         // requires enablement for frequency logging
         ArgumentModel_log_frequencies(name_line, val_line);
@@ -105,6 +166,28 @@ public:
         name_line << ",us";
         val_line << "," << gpu_us;
 
+        if(timing_stats)
+        {
+            // Per-call times, with the icache flush removed like gpu_us
+            double flush = flush_us > 0 ? flush_us : 0;
+            name_line << ",us-median,us-p5,us-p95,us-stddev,us-ci95,samples,outliers";
+            val_line << "," << timing_stats->median - flush << "," << timing_stats->p5 - flush
+                     << "," << timing_stats->p95 - flush << "," << timing_stats->stddev << ","
+                     << timing_stats->ci95 << "," << timing_stats->samples << ","
+                     << timing_stats->outliers;
+        }
+
+        if(estimate && estimate->predictedTimeUs > 0)
+        {
+            // Roofline estimate of the heuristic, and the fraction of it the measurement reached
+            const char* bound = estimate->boundType == HIPBLASLT_BOUND_COMPUTE  ? "compute"
+                                : estimate->boundType == HIPBLASLT_BOUND_MEMORY ? "memory"
+                                                                                : "unknown";
+            name_line << ",pred-us,pred-efficiency,bound,of-roofline";
+            val_line << "," << estimate->predictedTimeUs << "," << estimate->efficiency << ","
+                     << bound << "," << estimate->predictedTimeUs / gpu_us;
+        }
+
         if(arg.unit_check || arg.norm_check || arg.allclose_check)
         {
             if(cpu_us != ArgumentLogging::NA_value)
@@ -151,32 +234,32 @@ public:
         }
     }
 
-    void log_args(hipDataType                 Tc,
-                  hipblaslt_internal_ostream& str,
-                  size_t                      index,
-                  int32_t                     solution_index,
-                  std::string&                solution_name,
-                  std::string&                kernel_name,
-                  std::string&                archName,
-                  std::string&                cuNum,
-                  const Arguments&            arg,
-                  uint32_t                    splitK,
-                  uint32_t                    wgm,
-                  double                      gpu_us,
-                  double                      flush_us,
-                  double                      gflops,
-                  double                      gbytes = ArgumentLogging::NA_value,
-                  double                      cpu_us = ArgumentLogging::NA_value,
-                  double                      norm   = ArgumentLogging::NA_value,
-                  double                      atol   = ArgumentLogging::NA_value,
-                  double                      rtol   = ArgumentLogging::NA_value)
+    void log_args(hipDataType                             Tc,
+                  hipblaslt_internal_ostream&             str,
+                  size_t                                  index,
+                  int32_t                                 solution_index,
+                  std::string&                            solution_name,
+                  std::string&                            kernel_name,
+                  std::string&                            archName,
+                  std::string&                            cuNum,
+                  const Arguments&                        arg,
+                  uint32_t                                splitK,
+                  uint32_t                                wgm,
+                  double                                  gpu_us,
+                  double                                  flush_us,
+                  double                                  gflops,
+                  double                                  gbytes       = ArgumentLogging::NA_value,
+                  double                                  cpu_us       = ArgumentLogging::NA_value,
+                  double                                  norm         = ArgumentLogging::NA_value,
+                  double                                  atol         = ArgumentLogging::NA_value,
+                  double                                  rtol         = ArgumentLogging::NA_value,
+                  const hipblaslt_timing_stats*           timing_stats = nullptr,
+                  bool                                    winner       = false,
+                  const hipblasLtMatmulHeuristicResult_t* estimate     = nullptr)
     {
         hipblaslt_internal_ostream name_list;
         hipblaslt_internal_ostream value_list;
 
-        name_list << "[" << index << "]:";
-        value_list << "    ";
-
         if(ArgumentModel_get_log_function_name())
         {
             auto delim = ",";
@@ -254,7 +337,9 @@ public:
                      cpu_us,
                      norm,
                      atol,
-                     rtol);
+                     rtol,
+                     timing_stats,
+                     estimate);
 
         if(archName != "")
         {
@@ -265,10 +350,22 @@ public:
             const char*   tuningEnv  = getenv("HIPBLASLT_TUNING_FILE");
             std::string   tuningPath = tuningEnv;
             std::ofstream file(tuningPath, std::ios::app);
-            file << value_list << delim << archName << delim << cuNum << std::endl;
+            file << "    " << value_list << delim << archName << delim << cuNum << std::endl;
         }
 
-        str << name_list << "\n" << value_list << std::endl;
+        if(ArgumentModel_get_log_format() != ArgumentModel_log_format_t::text)
+            ArgumentModel_log_record(name_list.str(),
+                                     value_list.str(),
+                                     {{"index", std::to_string(index)},
+                                      {"winner", winner ? "1" : "0"},
+                                      {"solution_index", std::to_string(solution_index)},
+                                      {"solution_name", solution_name},
+                                      {"kernel_name", kernel_name}});
+
+        if(!ArgumentModel_log_to_stdout())
+            return;
+
+        str << "[" << index << "]:" << name_list << "\n    " << value_list << std::endl;
 
         if(solution_name != "")
         {
@@ -176,7 +176,8 @@ private:
 
     static memory_pool& Instance()
     {
-        static memory_pool buffer;
+        // Per host thread, as hipblaslt-bench --devices runs one thread per device
+        static thread_local memory_pool buffer;
         return buffer;
     }
 
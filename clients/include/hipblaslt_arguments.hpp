@@ -155,6 +155,7 @@ struct Arguments
     int32_t rotating;
     bool    use_gpu_timer;
     float   skip_slow_solution_ratio;
+    float   tuning_budget_ms; // wall time budget for trying the solutions of one problem
     // tuning
     int32_t gsu_vector[MAX_SUPPORTED_NUM_PROBLEMS]; // This is for client
     int32_t wgm_vector[MAX_SUPPORTED_NUM_PROBLEMS]; // This is for client
@@ -165,6 +166,18 @@ struct Arguments
 
     bool flush;
 
+    // per-iteration timing statistics
+    bool  timing_stats;
+    float timing_ci; // target relative half-width of the 95% confidence interval
+    float timing_budget_ms; // wall time budget for reaching timing_ci
+
+    // print the roofline estimate of the heuristic next to the measured time
+    bool print_roofline;
+
+    // determinism
+    bool    deterministic; // restrict the handle to deterministic solutions
+    int32_t audit_determinism; // runs compared bitwise per solution, 0 for no audit
+
     /*************************************************************************
      *                     End Of Arguments                                  *
      *************************************************************************/
@@ -252,11 +265,18 @@ struct Arguments
     OPER(rotating) SEP               \
     OPER(use_gpu_timer) SEP          \
     OPER(skip_slow_solution_ratio) SEP\
+    OPER(tuning_budget_ms) SEP       \
     OPER(gsu_vector) SEP             \
     OPER(wgm_vector) SEP             \
     OPER(print_solution_found) SEP   \
     OPER(print_kernel_info) SEP      \
-    OPER(flush) SEP
+    OPER(flush) SEP                  \
+    OPER(timing_stats) SEP           \
+    OPER(timing_ci) SEP              \
+    OPER(timing_budget_ms) SEP       \
+    OPER(print_roofline) SEP         \
+    OPER(deterministic) SEP          \
+    OPER(audit_determinism) SEP
 
     // clang-format on
 
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <hipblaslt/hipblaslt.h>
+
+/* ============================================================================================ */
+/*! \brief Bulk host-side conversions between float and the 8-bit float types.
+ *
+ *  Decoding uses a 256 entry lookup table per type which is filled from the scalar
+ *  conversion at first use, so it is bit-exact by construction. Encoding uses AVX-512 or
+ *  AVX2 when the host supports it and falls back to the scalar conversion otherwise. Both
+ *  directions keep the clipping and NaN semantics of the hipblaslt_f8_fnuz and
+ *  hipblaslt_bf8_fnuz constructors. When rng is not null, element i is stochastically
+ *  rounded with rng[i], exactly as the scalar constructor would do it.
+ */
+enum class hipblaslt_f8_cvt_isa
+{
+    scalar,
+    avx2,
+    avx512
+};
+
+// Currently selected encode path
+hipblaslt_f8_cvt_isa hipblaslt_f8_get_cvt_isa();
+
+// Select an encode path, clamped to what the host supports. Returns the path selected.
+hipblaslt_f8_cvt_isa hipblaslt_f8_set_cvt_isa(hipblaslt_f8_cvt_isa isa);
+
+const char* hipblaslt_f8_cvt_isa_to_string(hipblaslt_f8_cvt_isa isa);
+
+// 256 entry decode table for T
+template <typename T>
+const float* hipblaslt_f8_decode_table();
+
+template <typename T>
+void hipblaslt_f8_to_float(const T* src, float* dst, size_t size);
+
+template <typename T>
+void hipblaslt_float_to_f8(const float* src, T* dst, size_t size, const uint32_t* rng = nullptr);
+
+template <typename T>
+void hipblaslt_half_to_f8(const hipblasLtHalf* src, T* dst, size_t size);
@@ -54,6 +54,24 @@ void hipblaslt_init_device(ABC                      abc,
                            size_t                   stride,
                            size_t                   batch_count);
 
+/* ============================================================================================ */
+/*! \brief  Fill A in parallel with f(idx, i, j), where idx is the element's offset in A.
+ *  The result does not depend on the number of OpenMP threads as long as f only depends on its
+ *  arguments, which is the case for the counter-based generators below. */
+template <typename T, typename F>
+inline void hipblaslt_init_counter(
+    T* A, size_t M, size_t N, size_t lda, size_t stride, size_t batch_count, F f)
+{
+#pragma omp parallel for collapse(2)
+    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
+        for(size_t j = 0; j < N; ++j)
+        {
+            size_t offset = j * lda + i_batch * stride;
+            for(size_t i = 0; i < M; ++i)
+                A[i + offset] = f(i + offset, i, j);
+        }
+}
+
 /* ============================================================================================ */
 /*! \brief  matrix/vector initialization: */
 // for vector x (M=1, N=lengthX, lda=incx);
@@ -64,21 +82,11 @@ template <typename T>
 inline void
     hipblaslt_init(T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-    {
-        size_t b_idx = i_batch * stride;
-        for(size_t j = 0; j < N; ++j)
-        {
-            size_t col_idx = b_idx + j * lda;
-            if(M > 4)
-                random_run_generator<T>(A + col_idx, M);
-            else
-            {
-                for(size_t i = 0; i < M; ++i)
-                    A[col_idx + i] = random_generator<T>();
-            }
-        }
-    }
+    uint64_t seed = g_hipblaslt_counter_seed;
+    uint32_t id   = hipblaslt_next_tensor_id();
+    hipblaslt_init_counter(A, M, N, lda, stride, batch_count, [=](size_t idx, size_t, size_t) {
+        return random_counter_int<T>(hipblaslt_counter_rng(seed, id, idx));
+    });
 }
 
 // Initialize matrices with random values
@@ -267,17 +275,12 @@ template <typename T>
 inline void hipblaslt_init_alternating_sign(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-#pragma omp parallel for
-        for(size_t j = 0; j < N; ++j)
-        {
-            size_t offset = j * lda + i_batch * stride;
-            for(size_t i = 0; i < M; ++i)
-            {
-                auto value    = random_generator<T>();
-                A[i + offset] = (i ^ j) & 1 ? value : negate(value);
-            }
-        }
+    uint64_t seed = g_hipblaslt_counter_seed;
+    uint32_t id   = hipblaslt_next_tensor_id();
+    hipblaslt_init_counter(A, M, N, lda, stride, batch_count, [=](size_t idx, size_t i, size_t j) {
+        auto value = random_counter_int<T>(hipblaslt_counter_rng(seed, id, idx));
+        return (i ^ j) & 1 ? value : negate(value);
+    });
 }
 
 inline void hipblaslt_init_alternating_sign(void*       A,
@@ -343,17 +346,12 @@ template <typename T>
 inline void hipblaslt_init_hpl_alternating_sign(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-#pragma omp parallel for
-        for(size_t j = 0; j < N; ++j)
-        {
-            size_t offset = j * lda + i_batch * stride;
-            for(size_t i = 0; i < M; ++i)
-            {
-                auto value    = random_hpl_generator<T>();
-                A[i + offset] = (i ^ j) & 1 ? value : negate(value);
-            }
-        }
+    uint64_t seed = g_hipblaslt_counter_seed;
+    uint32_t id   = hipblaslt_next_tensor_id();
+    hipblaslt_init_counter(A, M, N, lda, stride, batch_count, [=](size_t idx, size_t i, size_t j) {
+        auto value = random_counter_hpl<T>(hipblaslt_counter_rng(seed, id, idx));
+        return (i ^ j) & 1 ? value : negate(value);
+    });
 }
 
 inline void hipblaslt_init_hpl_alternating_sign(void*       A,
@@ -487,22 +485,20 @@ inline void hipblaslt_init_cos(void*       A,
 // Initialize vector with HPL-like random values
 template <typename T>
 inline void hipblaslt_init_hpl(
-    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_hpl_generator<T>();
+    uint64_t seed = g_hipblaslt_counter_seed;
+    uint32_t id   = hipblaslt_next_tensor_id();
+    hipblaslt_init_counter(A, M, N, lda, stride, batch_count, [=](size_t idx, size_t, size_t) {
+        return random_counter_hpl<T>(hipblaslt_counter_rng(seed, id, idx));
+    });
 }
 
 template <typename T>
 inline void hipblaslt_init_hpl(
-    T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
+    std::vector<T>& A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
-    for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
-                A[i + j * lda + i_batch * stride] = random_hpl_generator<T>();
+    hipblaslt_init_hpl(A.data(), M, N, lda, stride, batch_count);
 }
 
 inline void hipblaslt_init_hpl(void*       A,
@@ -564,17 +560,19 @@ inline void hipblaslt_init_hpl(void*       A,
 /*! \brief  Initialize an array with random data, with NaN where appropriate */
 
 template <typename T>
-inline void hipblaslt_init_nan(T* A, size_t N)
+inline void hipblaslt_init_nan(T* A, size_t start_offset, size_t end_offset)
 {
-    for(size_t i = 0; i < N; ++i)
-        A[i] = T(hipblaslt_nan_rng());
+    uint64_t seed = g_hipblaslt_counter_seed;
+    uint32_t id   = hipblaslt_next_tensor_id();
+#pragma omp parallel for
+    for(size_t i = start_offset; i < end_offset; ++i)
+        A[i] = random_counter_nan<T>(hipblaslt_counter_rng(seed, id, i));
 }
 
 template <typename T>
-inline void hipblaslt_init_nan(T* A, size_t start_offset, size_t end_offset)
+inline void hipblaslt_init_nan(T* A, size_t N)
 {
-    for(size_t i = start_offset; i < end_offset; ++i)
-        A[i] = T(hipblaslt_nan_rng());
+    hipblaslt_init_nan(A, 0, N);
 }
 
 inline void hipblaslt_init_nan(void* A, size_t N, hipDataType type)
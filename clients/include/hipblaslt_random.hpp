@@ -367,6 +367,174 @@ inline hip_bfloat16 random_hpl_generator()
     return hip_bfloat16(std::uniform_real_distribution<float>(-0.5, 0.5)(t_hipblaslt_rng));
 }
 
+/* ============================================================================================ */
+/*! \brief  Counter-based random number generator (Philox4x32-10, Salmon et al., SC11).
+ *
+ *  The value for an element depends only on (seed, tensor id, element index), so matrices can
+ *  be filled in any order by any number of host threads, or directly on the device, and still
+ *  produce the same data.
+ */
+extern uint64_t g_hipblaslt_counter_seed;
+
+__host__ __device__ inline uint32_t
+    hipblaslt_counter_rng(uint64_t seed, uint32_t tensor_id, uint64_t idx)
+{
+    uint32_t c0 = uint32_t(idx), c1 = uint32_t(idx >> 32), c2 = tensor_id, c3 = 0;
+    uint32_t k0 = uint32_t(seed), k1 = uint32_t(seed >> 32);
+    for(int round = 0; round < 10; round++)
+    {
+        uint64_t p0 = uint64_t(0xD2511F53) * c0;
+        uint64_t p1 = uint64_t(0xCD9E8D57) * c2;
+        uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+        c0          = n0;
+        c1          = uint32_t(p1);
+        c2          = n2;
+        c3          = uint32_t(p0);
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    return c0;
+}
+
+// Draws a tensor id from the sequential generator, so that hipblaslt_seedrand() still makes
+// consecutive initializations repeatable while each of them gets a distinct stream.
+inline uint32_t hipblaslt_next_tensor_id()
+{
+    return uint32_t(t_hipblaslt_rng());
+}
+
+/*! \brief  map a counter-based random number to the range of random_generator<T> */
+template <typename T>
+__host__ __device__ inline T random_counter_int(uint32_t r)
+{
+    return T(float(r % 10 + 1));
+}
+
+/*! \brief  generate a random number in range [-2,-1,0,1,2] */
+template <>
+__host__ __device__ inline hipblasLtHalf random_counter_int<hipblasLtHalf>(uint32_t r)
+{
+    return hipblasLtHalf(float(int(r % 5) - 2));
+}
+
+/*! \brief  generate a random number in range [-2,-1,0,1,2] */
+template <>
+__host__ __device__ inline hip_bfloat16 random_counter_int<hip_bfloat16>(uint32_t r)
+{
+    return hip_bfloat16(float(int(r % 5) - 2));
+}
+
+/*! \brief  generate a random number in range [1,2,3] */
+template <>
+__host__ __device__ inline int8_t random_counter_int<int8_t>(uint32_t r)
+{
+    return int8_t(r % 3 + 1);
+}
+
+/*! \brief  map a counter-based random number to HPL-like [-0.5,0.5] */
+template <typename T>
+__host__ __device__ inline T random_counter_hpl(uint32_t r)
+{
+    return T(double(r) / double(UINT32_MAX) - 0.5);
+}
+
+/*! \brief  map a counter-based random number to HPL-like [-0.5,0.5] */
+template <>
+__host__ __device__ inline hip_bfloat16 random_counter_hpl<hip_bfloat16>(uint32_t r)
+{
+    return hip_bfloat16(float(double(r) / double(UINT32_MAX) - 0.5));
+}
+
+/*! \brief  map a counter-based random number to [-1,0,1] */
+template <>
+__host__ __device__ inline int8_t random_counter_hpl<int8_t>(uint32_t r)
+{
+    return int8_t(nearbyint(double(r) / double(UINT32_MAX) * 2. - 1.));
+}
+
+/*! \brief  map a counter-based random number to a NaN with random payload, like hipblaslt_nan_rng */
+template <typename T, typename UINT_T, int SIG, int EXP>
+__host__ __device__ inline T random_counter_nan_data(UINT_T u)
+{
+    union
+    {
+        UINT_T u;
+        T      fp;
+    } x;
+    x.u = u;
+    if(!(x.u & (((UINT_T)1 << SIG) - 1))) // Reject Inf (mantissa == 0)
+        x.u |= 1;
+    x.u |= (((UINT_T)1 << EXP) - 1) << SIG; // Exponent = all 1's
+    return x.fp;
+}
+
+/*! \brief  map a counter-based random number to a random integer */
+template <typename T>
+__host__ __device__ inline T random_counter_nan(uint32_t r)
+{
+    return T(r);
+}
+
+template <>
+__host__ __device__ inline double random_counter_nan<double>(uint32_t r)
+{
+    return random_counter_nan_data<double, uint64_t, 52, 11>((uint64_t(r) << 32) | r);
+}
+
+template <>
+__host__ __device__ inline float random_counter_nan<float>(uint32_t r)
+{
+    return random_counter_nan_data<float, uint32_t, 23, 8>(r);
+}
+
+template <>
+__host__ __device__ inline hipblasLtHalf random_counter_nan<hipblasLtHalf>(uint32_t r)
+{
+    return random_counter_nan_data<hipblasLtHalf, uint16_t, 10, 5>(uint16_t(r));
+}
+
+template <>
+__host__ __device__ inline hip_bfloat16 random_counter_nan<hip_bfloat16>(uint32_t r)
+{
+    return random_counter_nan_data<hip_bfloat16, uint16_t, 7, 8>(uint16_t(r));
+}
+
+// The float8 types have a single NaN encoding
+template <>
+__host__ __device__ inline hipblaslt_f8_fnuz random_counter_nan<hipblaslt_f8_fnuz>(uint32_t)
+{
+    hipblaslt_f8_fnuz x;
+    x.data = 0x80;
+    return x;
+}
+
+template <>
+__host__ __device__ inline hipblaslt_bf8_fnuz random_counter_nan<hipblaslt_bf8_fnuz>(uint32_t)
+{
+    hipblaslt_bf8_fnuz x;
+    x.data = 0x80;
+    return x;
+}
+
+#ifdef ROCM_USE_FLOAT8
+template <>
+__host__ __device__ inline hipblaslt_f8 random_counter_nan<hipblaslt_f8>(uint32_t)
+{
+    hipblaslt_f8 x;
+    x.data = 0x7f;
+    return x;
+}
+
+template <>
+__host__ __device__ inline hipblaslt_bf8 random_counter_nan<hipblaslt_bf8>(uint32_t)
+{
+    hipblaslt_bf8 x;
+    x.data = 0x7e;
+    return x;
+}
+#endif
+
 /*! \brief  generate a random ASCII string of up to length n */
 inline std::string random_string(size_t n)
 {
@@ -39,6 +39,7 @@
 #include "hipblaslt_ostream.hpp"
 #include "hipblaslt_test.hpp"
 #include "hipblaslt_vector.hpp"
+#include "validate.hpp"
 #include <hipblaslt/hipblaslt.h>
 
 template <class Tc, class Ti, class To>
@@ -482,6 +483,18 @@ inline void near_check_general(int64_t                        M,
 }
 #endif
 
+// Report the first error of a fused check the same way NEAR_CHECK would
+inline void near_check_result(const hipblaslt_validate_result& result, double abs_error)
+{
+#ifdef GOOGLE_TEST
+    if(result.num_errors)
+        ASSERT_NEAR(result.first_cpu, result.first_gpu, abs_error)
+            << "at i = " << result.first_i << ", j = " << result.first_j
+            << ", batch = " << result.first_batch << " (" << result.num_errors
+            << (result.complete ? "" : "+") << " elements out of tolerance)";
+#endif
+}
+
 inline void near_check_general(int64_t     M,
                                int64_t     N,
                                int64_t     lda,
@@ -492,112 +505,10 @@ inline void near_check_general(int64_t     M,
                                double      abs_error,
                                hipDataType type)
 {
-    switch(type)
-    {
-    case HIP_R_32F:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<float*>(hCPU),
-                           static_cast<float*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_64F:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<double*>(hCPU),
-                           static_cast<double*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_16F:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hipblasLtHalf*>(hCPU),
-                           static_cast<hipblasLtHalf*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_16BF:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hip_bfloat16*>(hCPU),
-                           static_cast<hip_bfloat16*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_8F_E4M3_FNUZ:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hipblaslt_f8_fnuz*>(hCPU),
-                           static_cast<hipblaslt_f8_fnuz*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_8F_E5M2_FNUZ:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hipblaslt_bf8_fnuz*>(hCPU),
-                           static_cast<hipblaslt_bf8_fnuz*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-#ifdef ROCM_USE_FLOAT8
-    case HIP_R_8F_E4M3:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hipblaslt_f8*>(hCPU),
-                           static_cast<hipblaslt_f8*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_8F_E5M2:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hipblaslt_bf8*>(hCPU),
-                           static_cast<hipblaslt_bf8*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
+#ifdef GOOGLE_TEST
+    // Like NEAR_CHECK, stop as soon as an element out of tolerance is found
+    auto result = hipblaslt_validate_general(
+        M, N, lda, strideA, hCPU, hGPU, batch_count, abs_error, 1, type);
+    near_check_result(result, abs_error);
 #endif
-    case HIP_R_32I:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<int32_t*>(hCPU),
-                           static_cast<int32_t*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    case HIP_R_8I:
-        near_check_general(M,
-                           N,
-                           lda,
-                           strideA,
-                           static_cast<hipblasLtInt8*>(hCPU),
-                           static_cast<hipblasLtInt8*>(hGPU),
-                           batch_count,
-                           abs_error);
-        break;
-    default:
-        hipblaslt_cerr << "Error type in near_check_general" << std::endl;
-        break;
-    }
 }
@@ -31,6 +31,7 @@
 #include "hipblaslt_vector.hpp"
 #include "norm.hpp"
 #include "utility.hpp"
+#include "validate.hpp"
 #include <cstdio>
 #include <hipblaslt/hipblaslt.h>
 #include <limits>
@@ -427,6 +428,12 @@ double norm_check_general(char        norm_type,
                           int64_t     batch_count,
                           hipDataType type)
 {
+    // The Frobenius norm needs no LAPACK call, so compute it with the fused single-pass check
+    if(norm_type == 'F' || norm_type == 'f')
+        return hipblaslt_validate_general(
+                   M, N, lda, stride_a, hCPU, hGPU, batch_count, 0, 0, type)
+            .norm_error;
+
     switch(type)
     {
     case HIP_R_32F:
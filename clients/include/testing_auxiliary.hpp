@@ -26,17 +26,27 @@
 
 #pragma once
 
+#include "PreloadProfile.hpp"
+#include "TunedSolutionStoreFormat.hpp"
 #include "flops.hpp"
 #include "hipblaslt_datatype2string.hpp"
 #include "hipblaslt_init.hpp"
 #include "hipblaslt_math.hpp"
 #include "hipblaslt_random.hpp"
 #include "hipblaslt_test.hpp"
+#include "hipblaslt_trace.hpp"
 #include "hipblaslt_vector.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <hipblaslt/hipblaslt-ext.hpp> // Add check for hipblaslt-ext
 #include <hipblaslt/hipblaslt.h>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
 
 void testing_aux_handle_init_bad_arg(const Arguments& arg)
 {
@@ -726,6 +736,1096 @@ void testing_aux_matmul_alg_null_matmul(const Arguments& arg)
     CHECK_HIP_ERROR(hipStreamDestroy(stream));
 }
 
+void testing_aux_matmul_autotune(const Arguments& arg)
+{
+    using InTypeA = hipblasLtHalf;
+    using InTypeB = hipblasLtHalf;
+    using OutType = hipblasLtHalf;
+
+    hipStream_t        stream;
+    hipblasLtHandle_t  handle;
+    hipblasOperation_t trans_a = arg.transA == 'N' ? HIPBLAS_OP_N : HIPBLAS_OP_T;
+    hipblasOperation_t trans_b = arg.transB == 'N' ? HIPBLAS_OP_N : HIPBLAS_OP_T;
+    int64_t            m       = arg.M[0];
+    int64_t            n       = arg.N[0];
+    int64_t            k       = arg.K[0];
+    float              alpha   = arg.alpha;
+    float              beta    = arg.beta;
+    void*              d_a;
+    void*              d_b;
+    void*              d_c;
+    void*              d_d;
+
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIP_ERROR(hipMalloc(&d_a, m * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, n * k * sizeof(InTypeB)));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, m * n * sizeof(OutType)));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, m * n * sizeof(OutType)));
+    CHECK_HIP_ERROR(hipMemset(d_a, 0, m * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMemset(d_b, 0, n * k * sizeof(InTypeB)));
+    CHECK_HIP_ERROR(hipMemset(d_c, 0, m * n * sizeof(OutType)));
+
+    hipblasLtMatrixLayout_t matA, matB, matC, matD;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matA, arg.a_type, m, k, m));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matB, arg.a_type, k, n, k));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matC, arg.a_type, m, n, m));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matD, arg.a_type, m, n, m));
+
+    hipblasLtMatmulDesc_t matmul;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescCreate(&matmul, arg.compute_type, arg.scale_type));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+        matmul, HIPBLASLT_MATMUL_DESC_TRANSA, &trans_a, sizeof(int32_t)));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+        matmul, HIPBLASLT_MATMUL_DESC_TRANSB, &trans_b, sizeof(int32_t)));
+
+    hipblasLtMatmulPreference_t pref;
+    uint64_t                    max_workspace_size = 32 * 1024 * 1024;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceCreate(&pref));
+    CHECK_HIPBLASLT_ERROR(
+        hipblasLtMatmulPreferenceSetAttribute(pref,
+                                              HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                              &max_workspace_size,
+                                              sizeof(max_workspace_size)));
+
+    hipblasLtMatmulHeuristicResult_t tunedResult;
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::matmulAutotune(handle,
+                                                        matmul,
+                                                        &alpha,
+                                                        d_a,
+                                                        matA,
+                                                        d_b,
+                                                        matB,
+                                                        &beta,
+                                                        d_c,
+                                                        matC,
+                                                        d_d,
+                                                        matD,
+                                                        pref,
+                                                        0,
+                                                        1,
+                                                        0,
+                                                        tunedResult,
+                                                        stream),
+                          HIPBLAS_STATUS_INVALID_VALUE);
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::matmulAutotune(handle,
+                                                        matmul,
+                                                        &alpha,
+                                                        d_a,
+                                                        matA,
+                                                        d_b,
+                                                        matB,
+                                                        &beta,
+                                                        d_c,
+                                                        matC,
+                                                        d_d,
+                                                        matD,
+                                                        pref,
+                                                        4,
+                                                        3,
+                                                        4 * m * n * sizeof(OutType),
+                                                        tunedResult,
+                                                        stream));
+
+    // The heuristic now returns the tuned solution first
+    const int                        request_solutions = 1;
+    hipblasLtMatmulHeuristicResult_t heuristicResult[request_solutions];
+    int                              returnedAlgoCount = 0;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                          matmul,
+                                                          matA,
+                                                          matB,
+                                                          matC,
+                                                          matD,
+                                                          pref,
+                                                          request_solutions,
+                                                          heuristicResult,
+                                                          &returnedAlgoCount));
+    CHECK_SOLUTION_FOUND(returnedAlgoCount);
+    EXPECT_EQ(hipblaslt_ext::getIndexFromAlgo(heuristicResult[0].algo),
+              hipblaslt_ext::getIndexFromAlgo(tunedResult.algo));
+
+    // and lists it only once when more solutions are requested
+    hipblasLtMatmulHeuristicResult_t moreResults[8];
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(
+        handle, matmul, matA, matB, matC, matD, pref, 8, moreResults, &returnedAlgoCount));
+    std::set<int> listed;
+    for(int i = 0; i < returnedAlgoCount; i++)
+        EXPECT_TRUE(listed.insert(hipblaslt_ext::getIndexFromAlgo(moreResults[i].algo)).second)
+            << "solution listed twice at " << i;
+
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::clearTunedSolutions());
+
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceDestroy(pref));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescDestroy(matmul));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matA));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matB));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matC));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matD));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+void testing_aux_tuning_override_convert(const Arguments& arg)
+{
+    hipblasLtHandle_t handle;
+    char              git_version[128];
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIPBLASLT_ERROR(hipblasLtGetGitRevision(handle, &git_version[0]));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+
+    auto tmp_dir  = std::filesystem::temp_directory_path();
+    auto csv_path = (tmp_dir / "hipblaslt_override_convert.csv").string();
+    auto bin_path = (tmp_dir / "hipblaslt_override_convert.bin").string();
+
+    const char* row = "N,N,0,1,128,128,128,1,128,16384,0,128,16384,128,16384,128,16384,f16_r,"
+                      "f16_r,f16_r,f16_r,f32_r,0,0,0,0,0,none,0,f32_r,0,1.0,1.0,1.0,12,gfx942,304";
+    {
+        std::ofstream csv(csv_path);
+        csv << "Git Version: " << git_version << std::endl << row << std::endl;
+    }
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::convertTuningOverrideFile(csv_path.c_str(), nullptr),
+                          HIPBLAS_STATUS_INVALID_VALUE);
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::convertTuningOverrideFile(csv_path.c_str(), bin_path.c_str()),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_GT(std::filesystem::file_size(bin_path), 0u);
+
+    // A binary file converts to itself
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::convertTuningOverrideFile(bin_path.c_str(), csv_path.c_str()),
+        HIPBLAS_STATUS_SUCCESS);
+    EXPECT_EQ(std::filesystem::file_size(bin_path), std::filesystem::file_size(csv_path));
+
+    // Files written by another library version are rejected
+    {
+        std::ofstream csv(csv_path);
+        csv << "Git Version: 0" << std::endl << row << std::endl;
+    }
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::convertTuningOverrideFile(csv_path.c_str(), bin_path.c_str()),
+        HIPBLAS_STATUS_INVALID_VALUE);
+
+    std::filesystem::remove(csv_path);
+    std::filesystem::remove(bin_path);
+}
+
+void testing_aux_tuning_override_match(const Arguments& arg)
+{
+    hipblasLtHandle_t handle;
+    char              git_version[128];
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIPBLASLT_ERROR(hipblasLtGetGitRevision(handle, &git_version[0]));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+
+    auto tmp_dir  = std::filesystem::temp_directory_path();
+    auto csv_path = (tmp_dir / "hipblaslt_override_match.csv").string();
+    auto bin_path = csv_path + ".bin";
+    auto new_path = (tmp_dir / "hipblaslt_override_match_new.csv").string();
+    std::filesystem::remove(bin_path);
+
+    std::vector<std::string> row;
+    {
+        std::stringstream columns("N,N,0,1,128,128,128,1,128,16384,0,128,16384,128,16384,128,"
+                                  "16384,f16_r,f16_r,f16_r,f16_r,f32_r,0,0,0,0,0,none,0,f32_r,0,"
+                                  "1.0,1.0,1.0,12,gfx942,304");
+        for(std::string column; std::getline(columns, column, ',');)
+            row.push_back(column);
+    }
+    // The row with column i set to value and the solution index set to index
+    auto make_row = [&](size_t i, const std::string& value, int index = 12) {
+        auto columns                = row;
+        columns[i]                  = value;
+        columns[columns.size() - 3] = std::to_string(index);
+        std::string line;
+        for(auto& column : columns)
+            line += (line.empty() ? "" : ",") + column;
+        return line;
+    };
+    auto write_csv = [&](const std::string& path, int index) {
+        std::ofstream csv(path);
+        csv << "Git Version: " << git_version << std::endl << make_row(0, "N", index) << std::endl;
+    };
+    auto lookup = [&](const std::string& line, int reload_ms = 0) {
+        int index = -2;
+        EXPECT_HIPBLAS_STATUS(
+            hipblaslt_ext::lookupTuningOverride(csv_path.c_str(), line.c_str(), reload_ms, index),
+            HIPBLAS_STATUS_SUCCESS);
+        return index;
+    };
+
+    write_csv(csv_path, 12);
+    EXPECT_EQ(lookup(make_row(0, "N")), 12);
+
+    // Problems differing from the entry in a single column do not match
+    EXPECT_EQ(lookup(make_row(15, "256")), -1); // ldd
+    EXPECT_EQ(lookup(make_row(27, "relu")), -1); // epilogue activation
+    EXPECT_EQ(lookup(make_row(28, "1")), -1); // epilogue bias
+    EXPECT_EQ(lookup(make_row(22, "1")), -1); // scalar scaleA
+    EXPECT_EQ(lookup(make_row(22, "2")), -1); // vector scaleA
+
+    int index;
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::lookupTuningOverride(csv_path.c_str(), "N,N,128", 0, index),
+        HIPBLAS_STATUS_INVALID_VALUE);
+
+    // An edited file is read again once the reload interval passed
+    const int reload_ms = 20;
+    write_csv(csv_path, 13);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * reload_ms));
+    EXPECT_EQ(lookup(make_row(0, "N"), reload_ms), 13);
+
+    // So is a regenerated binary file next to it, which is preferred while it is newer
+    write_csv(new_path, 14);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * reload_ms));
+    EXPECT_HIPBLAS_STATUS(
+        hipblaslt_ext::convertTuningOverrideFile(new_path.c_str(), bin_path.c_str()),
+        HIPBLAS_STATUS_SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * reload_ms));
+    EXPECT_EQ(lookup(make_row(0, "N"), reload_ms), 14);
+
+    std::filesystem::remove(csv_path);
+    std::filesystem::remove(bin_path);
+    std::filesystem::remove(new_path);
+}
+
+void testing_aux_preload_profile(const Arguments& arg)
+{
+    auto tmp_dir    = std::filesystem::temp_directory_path();
+    auto trace_path = (tmp_dir / "hipblaslt_preload_profile.trace").string();
+    auto store_path = (tmp_dir / "hipblaslt_preload_profile.store").string();
+    auto log_path   = (tmp_dir / "hipblaslt_preload_profile.log").string();
+
+    // Binary trace: 7 is used three times, 3 twice and 5 once, -1 is not a solution
+    {
+        hipblaslt_trace_header header{};
+        memcpy(header.magic, HIPBLASLT_TRACE_MAGIC, sizeof(HIPBLASLT_TRACE_MAGIC));
+        header.version     = HIPBLASLT_TRACE_VERSION;
+        header.record_size = sizeof(hipblaslt_trace_record);
+
+        std::ofstream trace(trace_path, std::ios::binary);
+        trace.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for(int index : {5, 3, 7, -1, 7, 3, 7})
+        {
+            hipblaslt_trace_record record{};
+            record.solution_index = index;
+            trace.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+    }
+
+    // Tuning store: the arch is the first column, the solution index the second to last
+    {
+        std::ofstream store(store_path);
+        store << tuned_solution_store_magic << ",1" << std::endl
+              << "# arch,...,solution_index,time_us" << std::endl
+              << "gfx942,0,0,0,0,0,0,0,2,0,128,128,128,1,128,128,128,128,0,0,0,0,0,11,3.5"
+              << std::endl
+              << "gfx90a,0,0,0,0,0,0,0,2,0,128,128,128,1,128,128,128,128,0,0,0,0,0,12,3.5"
+              << std::endl
+              << "gfx942,0,0,0,0,0,0,0,2,0,256,256,256,1,256,256,256,256,0,0,0,0,0,13,7.5"
+              << std::endl
+              << "gfx942,0,0,0,0,0,0,0,2,0,512,512,512,1,512,512,512,512,0,0,0,0,0,13,20.5"
+              << std::endl;
+    }
+
+    // Bench log: lines without a solution index are skipped, ties keep the first seen order
+    {
+        std::ofstream log(log_path);
+        log << "hipblaslt-bench --api_method c -m 128 -n 128 -k 128 --solution_index 21"
+            << std::endl
+            << "[2024-01-01 00:00:00][HIPBLASLT][1][info][runContractionProblem] launch"
+            << std::endl
+            << "hipblaslt-bench --api_method c -m 256 -n 256 -k 256 --solution_index 22"
+            << std::endl
+            << "hipblaslt-bench --api_method c -m 512 -n 512 -k 512 --solution_index 22"
+            << std::endl
+            << "hipblaslt-bench --api_method c -m 128 -n 128 -k 128 --solution_index 21"
+            << std::endl
+            << "hipblaslt-bench --api_method c -m 64 -n 64 -k 64 --solution_index 20"
+            << std::endl;
+    }
+
+    EXPECT_EQ(readPreloadProfile(trace_path, "gfx942"), (std::vector<int>{7, 3, 5}));
+
+    EXPECT_EQ(readPreloadProfile(store_path, "gfx942"), (std::vector<int>{13, 11}));
+    EXPECT_EQ(readPreloadProfile(store_path, "gfx90a"), (std::vector<int>{12}));
+
+    EXPECT_EQ(readPreloadProfile(log_path, "gfx942"), (std::vector<int>{21, 22, 20}));
+
+    // A missing file is an empty profile
+    std::filesystem::remove(log_path);
+    EXPECT_TRUE(readPreloadProfile(log_path, "gfx942").empty());
+
+    std::filesystem::remove(trace_path);
+    std::filesystem::remove(store_path);
+}
+
+void testing_aux_host_metrics(const Arguments& arg)
+{
+    using InTypeA = hipblasLtHalf;
+    using OutType = hipblasLtHalf;
+
+    hipStream_t        stream;
+    hipblasLtHandle_t  handle;
+    hipblasOperation_t trans_a = arg.transA == 'N' ? HIPBLAS_OP_N : HIPBLAS_OP_T;
+    hipblasOperation_t trans_b = arg.transB == 'N' ? HIPBLAS_OP_N : HIPBLAS_OP_T;
+    int64_t            m       = arg.M[0];
+    int64_t            n       = arg.N[0];
+    int64_t            k       = arg.K[0];
+    float              alpha   = arg.alpha;
+    float              beta    = arg.beta;
+    void*              d_a;
+    void*              d_b;
+    void*              d_c;
+    void*              d_d;
+
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIP_ERROR(hipMalloc(&d_a, m * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, n * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, m * n * sizeof(OutType)));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, m * n * sizeof(OutType)));
+
+    hipblasLtMatrixLayout_t matA, matB, matC, matD;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(
+        &matA, arg.a_type, trans_a == HIPBLAS_OP_N ? m : k, trans_a == HIPBLAS_OP_N ? k : m,
+        trans_a == HIPBLAS_OP_N ? m : k));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(
+        &matB, arg.b_type, trans_b == HIPBLAS_OP_N ? k : n, trans_b == HIPBLAS_OP_N ? n : k,
+        trans_b == HIPBLAS_OP_N ? k : n));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matC, arg.c_type, m, n, m));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matD, arg.d_type, m, n, m));
+
+    hipblasLtMatmulDesc_t matmul;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescCreate(&matmul, arg.compute_type, arg.scale_type));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+        matmul, HIPBLASLT_MATMUL_DESC_TRANSA, &trans_a, sizeof(int32_t)));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescSetAttribute(
+        matmul, HIPBLASLT_MATMUL_DESC_TRANSB, &trans_b, sizeof(int32_t)));
+
+    hipblasLtMatmulPreference_t pref;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceCreate(&pref));
+
+    hipblaslt_ext::enableHostMetrics(true);
+    hipblaslt_ext::resetHostMetrics();
+
+    hipblasLtMatmulHeuristicResult_t heuristicResult[1];
+    int                              returnedAlgoCount = 0;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(
+        handle, matmul, matA, matB, matC, matD, pref, 1, heuristicResult, &returnedAlgoCount));
+    CHECK_SOLUTION_FOUND(returnedAlgoCount);
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmul(handle,
+                                          matmul,
+                                          &alpha,
+                                          d_a,
+                                          matA,
+                                          d_b,
+                                          matB,
+                                          &beta,
+                                          d_c,
+                                          matC,
+                                          d_d,
+                                          matD,
+                                          &heuristicResult[0].algo,
+                                          nullptr,
+                                          0,
+                                          stream));
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+
+    std::map<std::string, hipblaslt_ext::HostMetric> metrics;
+    for(auto& metric : hipblaslt_ext::getHostMetrics())
+    {
+        if(metric.timed)
+        {
+            uint64_t samples = 0;
+            for(auto bucket : metric.histogram)
+                samples += bucket;
+            EXPECT_EQ(samples, metric.count) << metric.name;
+            EXPECT_LE(metric.max_ns, metric.total_ns) << metric.name;
+        }
+        metrics[metric.name] = metric;
+    }
+    EXPECT_GE(metrics["problem_construction"].count, 1u);
+    EXPECT_GE(metrics["heuristic_selection"].count, 1u);
+    EXPECT_GE(metrics["argument_building"].count, 1u);
+    EXPECT_GE(metrics["kernel_launch"].count, 1u);
+    EXPECT_EQ(metrics["kernel_launch"].count, metrics["kernels_launched"].count);
+
+    auto dump_path = (std::filesystem::temp_directory_path() / "hipblaslt_metrics.txt").string();
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::dumpHostMetrics(dump_path.c_str()),
+                          HIPBLAS_STATUS_SUCCESS);
+    EXPECT_GT(std::filesystem::file_size(dump_path), 0u);
+    std::filesystem::remove(dump_path);
+
+    // Nothing is recorded while disabled
+    hipblaslt_ext::resetHostMetrics();
+    hipblaslt_ext::enableHostMetrics(false);
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(
+        handle, matmul, matA, matB, matC, matD, pref, 1, heuristicResult, &returnedAlgoCount));
+    for(auto& metric : hipblaslt_ext::getHostMetrics())
+        EXPECT_EQ(metric.count, 0u) << metric.name;
+
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescDestroy(matmul));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matA));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matB));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matC));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matD));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceDestroy(pref));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+// The arg.M[0] x arg.N[0] x arg.K[0] gemm with the arg types, as the heuristic tests query it:
+// packed layouts and a default preference. The descriptors are released with the problem.
+struct aux_gemm_problem
+{
+    hipblasOperation_t            trans_a;
+    hipblasOperation_t            trans_b;
+    int64_t                       m;
+    int64_t                       n;
+    int64_t                       k;
+    hipblaslt_local_matrix_layout matA;
+    hipblaslt_local_matrix_layout matB;
+    hipblaslt_local_matrix_layout matC;
+    hipblaslt_local_matrix_layout matD;
+    hipblaslt_local_matmul_descr  matmul;
+    hipblaslt_local_preference    pref;
+
+    aux_gemm_problem(const Arguments& arg, hipblasOperation_t opA, hipblasOperation_t opB)
+        : trans_a(opA)
+        , trans_b(opB)
+        , m(arg.M[0])
+        , n(arg.N[0])
+        , k(arg.K[0])
+        , matA(opA == HIPBLAS_OP_N ? m : k,
+               opA == HIPBLAS_OP_N ? k : m,
+               opA == HIPBLAS_OP_N ? m : k,
+               arg.a_type)
+        , matB(opB == HIPBLAS_OP_N ? k : n,
+               opB == HIPBLAS_OP_N ? n : k,
+               opB == HIPBLAS_OP_N ? k : n,
+               arg.b_type)
+        , matC(m, n, m, arg.c_type)
+        , matD(m, n, m, arg.d_type)
+        , matmul(opA, opB, arg.compute_type, arg.scale_type)
+    {
+    }
+
+    explicit aux_gemm_problem(const Arguments& arg)
+        : aux_gemm_problem(arg,
+                           arg.transA == 'N' ? HIPBLAS_OP_N : HIPBLAS_OP_T,
+                           arg.transB == 'N' ? HIPBLAS_OP_N : HIPBLAS_OP_T)
+    {
+    }
+
+    // The first descriptor that could not be created, checked by the test before using them
+    hipblasStatus_t status()
+    {
+        for(auto status : {matA.status(),
+                           matB.status(),
+                           matC.status(),
+                           matD.status(),
+                           matmul.status(),
+                           pref.status()})
+            if(status != HIPBLAS_STATUS_SUCCESS)
+                return status;
+        return HIPBLAS_STATUS_SUCCESS;
+    }
+
+    hipblasStatus_t setWorkspace(size_t workspace)
+    {
+        return hipblasLtMatmulPreferenceSetAttribute(
+            pref, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspace, sizeof(workspace));
+    }
+
+    // Up to requestCount heuristic results, the vector is shrunk to the ones returned
+    hipblasStatus_t heuristic(hipblasLtHandle_t                              handle,
+                              int                                            requestCount,
+                              std::vector<hipblasLtMatmulHeuristicResult_t>& results)
+    {
+        int returnedAlgoCount = 0;
+        results.resize(requestCount);
+        auto status = hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                      matmul,
+                                                      matA,
+                                                      matB,
+                                                      matC,
+                                                      matD,
+                                                      pref,
+                                                      requestCount,
+                                                      results.data(),
+                                                      &returnedAlgoCount);
+        results.resize(status == HIPBLAS_STATUS_SUCCESS ? returnedAlgoCount : 0);
+        return status;
+    }
+};
+
+void testing_aux_heuristic_roofline(const Arguments& arg)
+{
+    hipblaslt_local_handle handle;
+    aux_gemm_problem       problem(arg);
+    CHECK_HIPBLASLT_ERROR(problem.status());
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+    CHECK_HIPBLASLT_ERROR(problem.heuristic(handle, 4, heuristicResult));
+    CHECK_SOLUTION_FOUND(heuristicResult.size());
+
+    // The roofline never predicts more than the peak, and the time follows from the efficiency
+    double flops = 2.0 * problem.m * problem.n * problem.k;
+    for(size_t i = 0; i < heuristicResult.size(); i++)
+    {
+        auto& result = heuristicResult[i];
+        EXPECT_GT(result.predictedTimeUs, 0.0f) << "solution " << i;
+        EXPECT_GT(result.efficiency, 0.0f) << "solution " << i;
+        EXPECT_LE(result.efficiency, 1.0f + 1e-5f) << "solution " << i;
+        EXPECT_TRUE(result.boundType == HIPBLASLT_BOUND_COMPUTE
+                    || result.boundType == HIPBLASLT_BOUND_MEMORY)
+            << "solution " << i;
+        if(i > 0)
+        {
+            // Same problem, so the implied peak is the same for every solution
+            double peak0 = flops / (heuristicResult[0].predictedTimeUs * 1e-6)
+                           / heuristicResult[0].efficiency;
+            double peak  = flops / (result.predictedTimeUs * 1e-6) / result.efficiency;
+            EXPECT_NEAR(peak / peak0, 1.0, 1e-3) << "solution " << i;
+        }
+    }
+}
+
+void testing_aux_heuristic_cache(const Arguments& arg)
+{
+    hipblaslt_local_handle handle;
+    aux_gemm_problem       problem(arg);
+    CHECK_HIPBLASLT_ERROR(problem.status());
+
+    auto heuristic = [&](size_t workspace, int requestCount) {
+        std::vector<hipblasLtMatmulHeuristicResult_t> results;
+        EXPECT_HIPBLAS_STATUS(problem.setWorkspace(workspace), HIPBLAS_STATUS_SUCCESS);
+        EXPECT_HIPBLAS_STATUS(problem.heuristic(handle, requestCount, results),
+                              HIPBLAS_STATUS_SUCCESS);
+        return results;
+    };
+    auto indices = [](const std::vector<hipblasLtMatmulHeuristicResult_t>& results) {
+        std::vector<int> rv;
+        for(auto result : results)
+            rv.push_back(hipblaslt_ext::getIndexFromAlgo(result.algo));
+        return rv;
+    };
+
+    const size_t workspace = 32 * 1024 * 1024;
+
+    // A short list cached first must not cap a longer request for the same problem
+    auto one  = heuristic(workspace, 1);
+    auto many = heuristic(workspace, 8);
+    CHECK_SOLUTION_FOUND(one.size());
+    EXPECT_GE(many.size(), one.size());
+    EXPECT_EQ(indices(one)[0], indices(many)[0]);
+    EXPECT_EQ(indices(heuristic(workspace, 8)), indices(many));
+
+    // Budgets that share a class still only get candidates that fit their own budget
+    for(size_t budget : {size_t(0), workspace / 3, workspace - 1})
+    {
+        auto results = heuristic(budget, 8);
+        for(auto& result : results)
+            EXPECT_LE(result.workspaceSize, budget) << "budget " << budget;
+        EXPECT_EQ(indices(heuristic(budget, 8)), indices(results)) << "budget " << budget;
+    }
+}
+
+void testing_aux_get_all_algos_stream(const Arguments& arg)
+{
+    hipblaslt_local_handle handle;
+    aux_gemm_problem       problem(arg);
+    CHECK_HIPBLASLT_ERROR(problem.status());
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> all;
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::getAllAlgos(handle,
+                                                     hipblaslt_ext::GemmType::HIPBLASLT_GEMM,
+                                                     problem.trans_a,
+                                                     problem.trans_b,
+                                                     arg.a_type,
+                                                     arg.b_type,
+                                                     arg.c_type,
+                                                     arg.d_type,
+                                                     arg.compute_type,
+                                                     all));
+    CHECK_SOLUTION_FOUND(all.size());
+
+    // Every algorithm accepting the size arrives once; a batch is ordered by estimate
+    std::vector<hipblasLtMatmulHeuristicResult_t> streamed;
+
+    auto collect = [&](hipblasLtMatmulHeuristicResult_t& result) {
+        streamed.push_back(result);
+        return true;
+    };
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::getAllAlgos(handle,
+                                                     hipblaslt_ext::GemmType::HIPBLASLT_GEMM,
+                                                     problem.trans_a,
+                                                     problem.trans_b,
+                                                     arg.a_type,
+                                                     arg.b_type,
+                                                     arg.c_type,
+                                                     arg.d_type,
+                                                     arg.compute_type,
+                                                     problem.m,
+                                                     problem.n,
+                                                     problem.k,
+                                                     collect));
+    CHECK_SOLUTION_FOUND(streamed.size());
+    ASSERT_LE(streamed.size(), all.size());
+
+    std::set<int> expected, seen;
+    for(auto& result : all)
+        expected.insert(hipblaslt_ext::getIndexFromAlgo(result.algo));
+    for(size_t i = 0; i < streamed.size(); i++)
+    {
+        int index = hipblaslt_ext::getIndexFromAlgo(streamed[i].algo);
+        EXPECT_TRUE(seen.insert(index).second) << "duplicate at " << i;
+        EXPECT_TRUE(expected.count(index)) << "unknown algorithm at " << i;
+    }
+
+    // Returning false stops the enumeration
+    size_t calls = 0;
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::getAllAlgos(handle,
+                                                     hipblaslt_ext::GemmType::HIPBLASLT_GEMM,
+                                                     problem.trans_a,
+                                                     problem.trans_b,
+                                                     arg.a_type,
+                                                     arg.b_type,
+                                                     arg.c_type,
+                                                     arg.d_type,
+                                                     arg.compute_type,
+                                                     problem.m,
+                                                     problem.n,
+                                                     problem.k,
+                                                     [&](hipblasLtMatmulHeuristicResult_t&) {
+                                                         return ++calls < 2;
+                                                     }));
+    EXPECT_EQ(calls, std::min<size_t>(2, streamed.size()));
+
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::getAllAlgos(handle,
+                                                     hipblaslt_ext::GemmType::HIPBLASLT_GEMM,
+                                                     problem.trans_a,
+                                                     problem.trans_b,
+                                                     arg.a_type,
+                                                     arg.b_type,
+                                                     arg.c_type,
+                                                     arg.d_type,
+                                                     arg.compute_type,
+                                                     problem.m,
+                                                     problem.n,
+                                                     problem.k,
+                                                     nullptr),
+                          HIPBLAS_STATUS_INVALID_VALUE);
+}
+
+void testing_aux_code_object_residency(const Arguments& arg)
+{
+    using InTypeA = hipblasLtHalf;
+    using OutType = hipblasLtHalf;
+
+    hipStream_t       stream;
+    hipblasLtHandle_t handle;
+    int64_t           m     = arg.M[0];
+    int64_t           n     = arg.N[0];
+    int64_t           k     = arg.K[0];
+    float             alpha = 1.0f;
+    float             beta  = 0.0f;
+    void*             d_a;
+    void*             d_b;
+    void*             d_c;
+    void*             d_d;
+
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIP_ERROR(hipMalloc(&d_a, m * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, n * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, m * n * sizeof(OutType)));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, m * n * sizeof(OutType)));
+
+    // All-ones inputs make every element of D exactly k whatever the transposes
+    std::vector<InTypeA> h_a(m * k, InTypeA(1.0f)), h_b(n * k, InTypeA(1.0f));
+    std::vector<OutType> h_d(m * n);
+    CHECK_HIP_ERROR(hipMemcpy(d_a, h_a.data(), m * k * sizeof(InTypeA), hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, h_b.data(), n * k * sizeof(InTypeA), hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemset(d_c, 0, m * n * sizeof(OutType)));
+
+    // NN and TN gemms live in different code objects, so a one byte budget evicts
+    // the first while the second runs and has to reload it for the third gemm
+    auto run_gemm = [&](hipblasOperation_t trans_a) {
+        aux_gemm_problem problem(arg, trans_a, HIPBLAS_OP_N);
+        CHECK_HIPBLASLT_ERROR(problem.status());
+
+        std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+        CHECK_HIPBLASLT_ERROR(problem.heuristic(handle, 1, heuristicResult));
+        CHECK_SOLUTION_FOUND(heuristicResult.size());
+
+        CHECK_HIP_ERROR(hipMemset(d_d, 0, m * n * sizeof(OutType)));
+        CHECK_HIPBLASLT_ERROR(hipblasLtMatmul(handle,
+                                              problem.matmul,
+                                              &alpha,
+                                              d_a,
+                                              problem.matA,
+                                              d_b,
+                                              problem.matB,
+                                              &beta,
+                                              d_c,
+                                              problem.matC,
+                                              d_d,
+                                              problem.matD,
+                                              &heuristicResult[0].algo,
+                                              nullptr,
+                                              0,
+                                              stream));
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        CHECK_HIP_ERROR(
+            hipMemcpy(h_d.data(), d_d, m * n * sizeof(OutType), hipMemcpyDeviceToHost));
+        for(int64_t i = 0; i < m * n; i++)
+            ASSERT_EQ(float(h_d[i]), float(k)) << "element " << i;
+    };
+
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setCodeObjectBudget(handle, 1));
+    run_gemm(HIPBLAS_OP_N);
+    run_gemm(HIPBLAS_OP_T);
+    run_gemm(HIPBLAS_OP_N);
+
+    hipblaslt_ext::CodeObjectResidency stats;
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::getCodeObjectResidency(handle, stats));
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setCodeObjectBudget(handle, 0));
+
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+
+    // Libraries built without lazy loading keep one code object resident for good
+    if(stats.evictedModules == 0 && stats.reloads == 0)
+        GTEST_SKIP() << "code objects are not lazily loaded in this build";
+    EXPECT_GE(stats.evictedModules, 1u);
+    EXPECT_GE(stats.evictedBytes, 1u);
+    EXPECT_GE(stats.reloads, 1u);
+    EXPECT_GE(stats.loadedModules, 1u);
+}
+
+void testing_aux_grouped_gemm_route(const Arguments& arg)
+{
+    using InType = hipblasLtHalf;
+
+    hipblasLtHandle_t handle;
+    hipStream_t       stream;
+    const int64_t     experts = 4;
+    const int         steps   = 3;
+    int64_t           tokens  = arg.M[0];
+    int64_t           n       = arg.N[0];
+    int64_t           k       = arg.K[0];
+    float             alpha   = 1.0f;
+    float             beta    = 0.0f;
+
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    // Every expert gets buffers for all tokens, so a step may route any m up to tokens
+    std::vector<int64_t>                     m(experts, tokens), nv(experts, n), kv(experts, k);
+    std::vector<int64_t>                     batch(experts, 1);
+    std::vector<hipblaslt_ext::GemmEpilogue> epilogue(experts);
+    std::vector<hipblaslt_ext::GemmInputs>   inputs(experts);
+    std::vector<void*>                       buffers;
+    std::vector<InType>                      h_a(tokens * k), h_b(k * n);
+    hipblaslt_seedrand();
+    for(int64_t i = 0; i < experts; i++)
+    {
+        void *a, *b, *d;
+        CHECK_HIP_ERROR(hipMalloc(&a, tokens * k * sizeof(InType)));
+        CHECK_HIP_ERROR(hipMalloc(&b, k * n * sizeof(InType)));
+        CHECK_HIP_ERROR(hipMalloc(&d, tokens * n * sizeof(InType)));
+        for(auto& v : h_a)
+            v = random_generator<InType>();
+        for(auto& v : h_b)
+            v = random_generator<InType>();
+        CHECK_HIP_ERROR(
+            hipMemcpy(a, h_a.data(), h_a.size() * sizeof(InType), hipMemcpyHostToDevice));
+        CHECK_HIP_ERROR(
+            hipMemcpy(b, h_b.data(), h_b.size() * sizeof(InType), hipMemcpyHostToDevice));
+        buffers.insert(buffers.end(), {a, b, d});
+        inputs[i].a     = a;
+        inputs[i].b     = b;
+        inputs[i].c     = d;
+        inputs[i].d     = d;
+        inputs[i].alpha = &alpha;
+        inputs[i].beta  = &beta;
+    }
+
+    hipblaslt_ext::GroupedGemm groupedGemm(handle,
+                                           HIPBLAS_OP_N,
+                                           HIPBLAS_OP_N,
+                                           HIP_R_16F,
+                                           HIP_R_16F,
+                                           HIP_R_16F,
+                                           HIP_R_16F,
+                                           HIPBLAS_COMPUTE_32F);
+    CHECK_HIPBLASLT_ERROR(groupedGemm.setProblem(m, nv, kv, batch, epilogue, inputs));
+
+    uint64_t                      workspaceSize = 32 * 1024 * 1024;
+    void*                         workspace;
+    hipblaslt_ext::GemmPreference pref;
+    pref.setMaxWorkspaceBytes(workspaceSize);
+    CHECK_HIP_ERROR(hipMalloc(&workspace, workspaceSize));
+
+    std::vector<hipblasLtMatmulHeuristicResult_t> heuristicResult;
+    CHECK_HIPBLASLT_ERROR(groupedGemm.algoGetHeuristic(1, pref, heuristicResult));
+    CHECK_SOLUTION_FOUND(heuristicResult.size());
+    CHECK_HIPBLASLT_ERROR(groupedGemm.initialize(heuristicResult[0].algo, workspace, true, stream));
+
+    // Sizes of every step, the last expert of a step keeping all tokens
+    std::vector<uint32_t> routes(steps * experts);
+    for(int s = 0; s < steps; s++)
+        for(int64_t i = 0; i < experts; i++)
+            routes[s * experts + i] = i == experts - 1 ? tokens : 1 + (s * 37 + i * 53) % tokens;
+    uint32_t* dRoutes;
+    CHECK_HIP_ERROR(hipMalloc(&dRoutes, routes.size() * sizeof(uint32_t)));
+    CHECK_HIP_ERROR(hipMemcpy(
+        dRoutes, routes.data(), routes.size() * sizeof(uint32_t), hipMemcpyHostToDevice));
+
+    std::vector<hipblaslt_ext::UserArguments> hostArgs(experts);
+    hipblaslt_ext::UserArguments*             dArgs;
+    CHECK_HIPBLASLT_ERROR(groupedGemm.getDefaultValueForDeviceUserArguments(hostArgs.data()));
+    CHECK_HIP_ERROR(hipMalloc(&dArgs, experts * sizeof(hipblaslt_ext::UserArguments)));
+
+    hipblaslt_ext::GroupedGemmUserArgsRing ring(groupedGemm, 2);
+    CHECK_HIPBLASLT_ERROR(ring.initialize(stream));
+
+    // D of every expert after a run, with the rows past m left at 0
+    auto results = [&](auto&& run) {
+        for(int64_t i = 0; i < experts; i++)
+            CHECK_HIP_ERROR(hipMemsetAsync(inputs[i].d, 0, tokens * n * sizeof(InType), stream));
+        run();
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        std::vector<InType> d(experts * tokens * n);
+        for(int64_t i = 0; i < experts; i++)
+            CHECK_HIP_ERROR(hipMemcpy(d.data() + i * tokens * n,
+                                      inputs[i].d,
+                                      tokens * n * sizeof(InType),
+                                      hipMemcpyDeviceToHost));
+        return d;
+    };
+
+    for(int s = 0; s < steps; s++)
+    {
+        auto routed = results([&] {
+            hipblaslt_ext::GroupedGemmRoute route;
+            route.m = dRoutes + s * experts;
+            CHECK_HIPBLASLT_ERROR(ring.run(route, stream));
+        });
+        auto copied = results([&] {
+            for(int64_t i = 0; i < experts; i++)
+                hostArgs[i].m = routes[s * experts + i];
+            CHECK_HIP_ERROR(hipMemcpy(dArgs,
+                                      hostArgs.data(),
+                                      experts * sizeof(hipblaslt_ext::UserArguments),
+                                      hipMemcpyHostToDevice));
+            CHECK_HIPBLASLT_ERROR(groupedGemm.run(dArgs, stream));
+        });
+        EXPECT_EQ(memcmp(routed.data(), copied.data(), routed.size() * sizeof(InType)), 0)
+            << "step " << s;
+    }
+
+    CHECK_HIP_ERROR(hipFree(dArgs));
+    CHECK_HIP_ERROR(hipFree(dRoutes));
+    CHECK_HIP_ERROR(hipFree(workspace));
+    for(auto buffer : buffers)
+        CHECK_HIP_ERROR(hipFree(buffer));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+}
+
+void testing_aux_available_cus(const Arguments& arg)
+{
+    hipblaslt_local_handle handle;
+    int                    deviceId;
+    hipDeviceProp_t        props;
+
+    CHECK_HIP_ERROR(hipGetDevice(&deviceId));
+    CHECK_HIP_ERROR(hipGetDeviceProperties(&props, deviceId));
+
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::setAvailableComputeUnits(handle, -1),
+                          HIPBLAS_STATUS_INVALID_VALUE);
+    EXPECT_HIPBLAS_STATUS(hipblaslt_ext::setAvailableComputeUnits(nullptr, 1),
+                          HIPBLAS_STATUS_NOT_INITIALIZED);
+
+    aux_gemm_problem problem(arg);
+    CHECK_HIPBLASLT_ERROR(problem.status());
+    CHECK_HIPBLASLT_ERROR(problem.setWorkspace(32 * 1024 * 1024));
+
+    auto heuristic = [&]() {
+        std::vector<hipblasLtMatmulHeuristicResult_t> results;
+        std::vector<int>                              indices;
+        EXPECT_HIPBLAS_STATUS(problem.heuristic(handle, 8, results), HIPBLAS_STATUS_SUCCESS);
+        for(auto& result : results)
+            indices.push_back(hipblaslt_ext::getIndexFromAlgo(result.algo));
+        return indices;
+    };
+
+    // The reduced count is looked up first, so neither result can come from the other's entry
+    int cus = std::max(props.multiProcessorCount / 4, 1);
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setAvailableComputeUnits(handle, cus));
+    auto reduced = heuristic();
+    CHECK_SOLUTION_FOUND(reduced.size());
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setAvailableComputeUnits(handle, 0));
+    auto full = heuristic();
+    CHECK_SOLUTION_FOUND(full.size());
+
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setAvailableComputeUnits(handle, cus));
+    EXPECT_EQ(heuristic(), reduced);
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setAvailableComputeUnits(handle, 0));
+    EXPECT_EQ(heuristic(), full);
+
+    // Counts beyond the device are clamped to all CUs
+    CHECK_HIPBLASLT_ERROR(
+        hipblaslt_ext::setAvailableComputeUnits(handle, props.multiProcessorCount + 8));
+    EXPECT_EQ(heuristic(), full);
+
+    // A stream masked to the same number of CUs selects like the count
+    std::vector<uint32_t> mask((props.multiProcessorCount + 31) / 32, 0);
+    for(int cu = 0; cu < cus; cu++)
+        mask[cu / 32] |= 1u << (cu % 32);
+    hipStream_t stream;
+    CHECK_HIP_ERROR(hipExtStreamCreateWithCUMask(&stream, mask.size(), mask.data()));
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setAvailableComputeUnitsFromStream(handle, stream));
+    EXPECT_EQ(heuristic(), reduced);
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+void testing_aux_deterministic_runs(const Arguments& arg)
+{
+    using InTypeA = hipblasLtHalf;
+    using OutType = hipblasLtHalf;
+
+    hipStream_t       stream;
+    hipblasLtHandle_t handle;
+    int64_t           m         = arg.M[0];
+    int64_t           n         = arg.N[0];
+    int64_t           k         = arg.K[0];
+    float             alpha     = 1.0f;
+    float             beta      = 0.0f;
+    size_t            workspace = 32 * 1024 * 1024;
+    const int         runs      = 5;
+    void*             d_a;
+    void*             d_b;
+    void*             d_c;
+    void*             d_d;
+    void*             d_workspace;
+
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+    CHECK_HIPBLASLT_ERROR(hipblasLtCreate(&handle));
+    CHECK_HIPBLASLT_ERROR(hipblaslt_ext::setDeterministicMode(handle, true));
+    CHECK_HIP_ERROR(hipMalloc(&d_a, m * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_b, n * k * sizeof(InTypeA)));
+    CHECK_HIP_ERROR(hipMalloc(&d_c, m * n * sizeof(OutType)));
+    CHECK_HIP_ERROR(hipMalloc(&d_d, m * n * sizeof(OutType)));
+    CHECK_HIP_ERROR(hipMalloc(&d_workspace, workspace));
+
+    // Inputs of mixed sign, so a different accumulation order changes the rounding of D
+    std::vector<InTypeA> h_a(m * k), h_b(n * k);
+    hipblaslt_seedrand();
+    for(auto& a : h_a)
+        a = random_generator<InTypeA>();
+    for(auto& b : h_b)
+        b = random_generator<InTypeA>();
+    CHECK_HIP_ERROR(hipMemcpy(d_a, h_a.data(), m * k * sizeof(InTypeA), hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemcpy(d_b, h_b.data(), n * k * sizeof(InTypeA), hipMemcpyHostToDevice));
+    CHECK_HIP_ERROR(hipMemset(d_c, 0, m * n * sizeof(OutType)));
+
+    hipblasLtMatrixLayout_t matA, matB, matC, matD;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matA, arg.a_type, m, k, m));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matB, arg.b_type, k, n, k));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matC, arg.c_type, m, n, m));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutCreate(&matD, arg.d_type, m, n, m));
+
+    hipblasLtMatmulDesc_t matmul;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescCreate(&matmul, arg.compute_type, arg.scale_type));
+
+    hipblasLtMatmulPreference_t pref;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceCreate(&pref));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceSetAttribute(
+        pref, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspace, sizeof(workspace)));
+
+    const int                        requested = 8;
+    hipblasLtMatmulHeuristicResult_t heuristicResult[requested];
+    int                              returnedAlgoCount = 0;
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                          matmul,
+                                                          matA,
+                                                          matB,
+                                                          matC,
+                                                          matD,
+                                                          pref,
+                                                          requested,
+                                                          heuristicResult,
+                                                          &returnedAlgoCount));
+    CHECK_SOLUTION_FOUND(returnedAlgoCount);
+
+    // Every solution of a deterministic handle writes the same bits on every run
+    std::vector<OutType> h_ref(m * n), h_d(m * n);
+    for(int i = 0; i < returnedAlgoCount; i++)
+    {
+        int index = hipblaslt_ext::getIndexFromAlgo(heuristicResult[i].algo);
+        EXPECT_TRUE(hipblaslt_ext::isAlgoDeterministic(handle, heuristicResult[i].algo))
+            << "solution index " << index;
+        for(int run = 0; run < runs; run++)
+        {
+            CHECK_HIP_ERROR(hipMemsetAsync(d_d, 0, m * n * sizeof(OutType), stream));
+            CHECK_HIPBLASLT_ERROR(hipblasLtMatmul(handle,
+                                                  matmul,
+                                                  &alpha,
+                                                  d_a,
+                                                  matA,
+                                                  d_b,
+                                                  matB,
+                                                  &beta,
+                                                  d_c,
+                                                  matC,
+                                                  d_d,
+                                                  matD,
+                                                  &heuristicResult[i].algo,
+                                                  d_workspace,
+                                                  workspace,
+                                                  stream));
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+            CHECK_HIP_ERROR(hipMemcpy((run == 0 ? h_ref : h_d).data(),
+                                      d_d,
+                                      m * n * sizeof(OutType),
+                                      hipMemcpyDeviceToHost));
+            if(run > 0)
+                EXPECT_EQ(memcmp(h_ref.data(), h_d.data(), m * n * sizeof(OutType)), 0)
+                    << "solution index " << index << ", run " << run;
+        }
+    }
+
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulPreferenceDestroy(pref));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatmulDescDestroy(matmul));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matA));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matB));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matC));
+    CHECK_HIPBLASLT_ERROR(hipblasLtMatrixLayoutDestroy(matD));
+    CHECK_HIP_ERROR(hipFree(d_a));
+    CHECK_HIP_ERROR(hipFree(d_b));
+    CHECK_HIP_ERROR(hipFree(d_c));
+    CHECK_HIP_ERROR(hipFree(d_d));
+    CHECK_HIP_ERROR(hipFree(d_workspace));
+    CHECK_HIPBLASLT_ERROR(hipblasLtDestroy(handle));
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
 void testing_aux_matmul_pref_init_bad_arg(const Arguments& arg)
 {
     hipblasLtMatmulPreference_t pref;
@@ -41,7 +41,11 @@
 #include "norm.hpp"
 #include "unit.hpp"
 #include "utility.hpp"
+#include "timing_stats.hpp"
+#include "validate.hpp"
+#include <chrono>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <hipblaslt/hipblaslt-ext-op.h>
 #include <hipblaslt/hipblaslt-ext.hpp>
@@ -103,6 +107,41 @@ inline void post_gpu_time(bool         use_gpu_timer,
     }
 }
 
+// Run hot_call(i) for the hot iterations and time them. By default the whole loop is timed at
+// once. With --timing_stats every call is timed separately (see hipblaslt_time_iterations) and
+// gpu_time_used is the median scaled to iters calls, so the reported per-call time is the median.
+template <typename F>
+void time_hot_calls(const Arguments&        arg,
+                    hipEvent_t&             event_gpu_time_start,
+                    hipEvent_t&             event_gpu_time_end,
+                    double&                 gpu_time_used,
+                    hipStream_t&            stream,
+                    int                     number_hot_calls,
+                    hipblaslt_timing_stats& timing_stats,
+                    F&&                     hot_call)
+{
+    ArgumentModel_timing_start();
+    if(arg.timing_stats)
+    {
+        int calls;
+        CHECK_HIP_ERROR(hipblaslt_time_iterations(stream,
+                                                  number_hot_calls,
+                                                  arg.timing_ci,
+                                                  arg.timing_budget_ms,
+                                                  timing_stats,
+                                                  calls,
+                                                  hot_call));
+        gpu_time_used = timing_stats.median * (arg.iters < 1 ? 1 : arg.iters);
+        return;
+    }
+
+    pre_gpu_time(arg.use_gpu_timer, event_gpu_time_start, gpu_time_used, stream);
+    for(int i = 0; i < number_hot_calls; i++)
+        hot_call(i);
+    post_gpu_time(
+        arg.use_gpu_timer, event_gpu_time_start, event_gpu_time_end, gpu_time_used, stream);
+}
+
 template <typename Tout>
 Tout cast_from_type(void* in, hipDataType type, size_t index)
 {
@@ -644,19 +683,30 @@ void check(hipStream_t                   stream,
         {
             CHECK_HIP_ERROR(synchronize(hBias[gemmIdx], dBias[gemmIdx]));
         }
+
+        // Near, norm and allclose checks of D share a single fused pass over the output.
+        // When only the near check needs it, the pass stops at the first error.
+        hipblaslt_validate_result resultD;
+        bool near_D = arg.unit_check && tol[gemmIdx] != 0;
+        if(near_D || arg.norm_check || arg.allclose_check)
+        {
+            resultD = hipblaslt_validate_general(M[gemmIdx],
+                                                 N[gemmIdx],
+                                                 ldd[gemmIdx],
+                                                 stride_d[gemmIdx],
+                                                 hD_gold[gemmIdx].buf(),
+                                                 hD_1[gemmIdx].buf(),
+                                                 num_batches[gemmIdx],
+                                                 tol[gemmIdx],
+                                                 arg.norm_check || arg.allclose_check ? 0 : 1,
+                                                 To);
+        }
+
         if(arg.unit_check)
         {
-            if(tol[gemmIdx] != 0)
+            if(near_D)
             {
-                near_check_general(M[gemmIdx],
-                                   N[gemmIdx],
-                                   ldd[gemmIdx],
-                                   stride_d[gemmIdx],
-                                   hD_gold[gemmIdx].buf(),
-                                   hD_1[gemmIdx].buf(),
-                                   num_batches[gemmIdx],
-                                   tol[gemmIdx],
-                                   To);
+                near_check_result(resultD, tol[gemmIdx]);
             }
             else
             {
@@ -751,16 +801,7 @@ void check(hipStream_t                   stream,
 
         if(arg.norm_check)
         {
-            double norm_error = 0.0;
-            norm_error        = std::abs(norm_check_general('F',
-                                                     M[gemmIdx],
-                                                     N[gemmIdx],
-                                                     ldd[gemmIdx],
-                                                     stride_d[gemmIdx],
-                                                     hD_gold[gemmIdx].buf(),
-                                                     hD_1[gemmIdx].buf(),
-                                                     num_batches[gemmIdx],
-                                                     To));
+            double norm_error = std::abs(resultD.norm_error);
             hipblaslt_error += norm_error;
             if(arg.norm_check_assert)
             {
@@ -822,17 +863,7 @@ void check(hipStream_t                   stream,
 
         if(arg.allclose_check)
         {
-            bool is_allclose = allclose_check_general('F',
-                                                      M[gemmIdx],
-                                                      N[gemmIdx],
-                                                      ldd[gemmIdx],
-                                                      stride_d[gemmIdx],
-                                                      hD_gold[gemmIdx].buf(),
-                                                      hD_1[gemmIdx].buf(),
-                                                      num_batches[gemmIdx],
-                                                      hipblaslt_atol,
-                                                      hipblaslt_rtol,
-                                                      To);
+            bool is_allclose = allclose_check_result(resultD, hipblaslt_atol, hipblaslt_rtol);
             //TODO: confirm if allclose_check_assert is neccessary
         }
     }
@@ -2811,6 +2842,72 @@ void testing_matmul_with_bias(const Arguments& arg,
         }
     }
 
+    // One call of solution sol writing D of the first block
+    auto run_solution = [&](size_t sol) {
+        if(!do_grouped_gemm)
+        {
+            if(arg.use_ext)
+            {
+                CHECK_HIPBLASLT_ERROR(
+                    gemmVec[0].initialize(heuristicResult[sol].algo,
+                                          tuningVec[heuristicTuningIndex[sol]],
+                                          *dWorkspace));
+                CHECK_HIPBLASLT_ERROR(gemmVec[0].run(stream));
+            }
+            else
+            {
+                CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+                EXPECT_HIPBLAS_STATUS(hipblasLtMatmul(handle,
+                                                      matmul[0][0],
+                                                      alpha_in[0],
+                                                      dA[0].buf(),
+                                                      matA[0],
+                                                      dB[0].buf(),
+                                                      matB[0],
+                                                      &(h_beta[0]),
+                                                      dC[0].buf(),
+                                                      matC[0],
+                                                      (*dDp)[0].buf(),
+                                                      matD[0],
+                                                      &heuristicResult[sol].algo,
+                                                      *dWorkspace,
+                                                      workspace_size,
+                                                      stream),
+                                      HIPBLAS_STATUS_SUCCESS);
+            }
+        }
+        else
+        {
+            //grouped gemm
+            if(arg.use_user_args)
+            {
+                CHECK_HIPBLASLT_ERROR(
+                    groupedGemmVec[0].initialize(heuristicResult[sol].algo,
+                                                 tuningVec[heuristicTuningIndex[0]],
+                                                 *dWorkspace));
+                groupedGemmVec[0].getDefaultValueForDeviceUserArguments(userArgs);
+                // Copy them to device memory
+                CHECK_HIP_ERROR(hipMemcpy(d_userArgs,
+                                          userArgs,
+                                          gemm_count * sizeof(hipblaslt_ext::UserArguments),
+                                          hipMemcpyHostToDevice));
+
+                CHECK_HIPBLASLT_ERROR(groupedGemmVec[0].run(d_userArgs, stream));
+            }
+            else
+            {
+                CHECK_HIPBLASLT_ERROR(
+                    groupedGemmVec[0].initialize(heuristicResult[sol].algo,
+                                                 tuningVec[heuristicTuningIndex[0]],
+                                                 *dWorkspace,
+                                                 false,
+                                                 stream));
+
+                CHECK_HIPBLASLT_ERROR(groupedGemmVec[0].run(stream));
+            }
+        }
+    };
+
     if(!arg.timing)
     {
         for(size_t sol = 0; sol < heuristicResult.size(); sol++)
@@ -2822,68 +2919,7 @@ void testing_matmul_with_bias(const Arguments& arg,
                     CHECK_HIP_ERROR(synchronize(dC[i], hC[i], block_count));
                 }
             }
-            if(!do_grouped_gemm)
-            {
-                if(arg.use_ext)
-                {
-                    CHECK_HIPBLASLT_ERROR(
-                        gemmVec[0].initialize(heuristicResult[sol].algo,
-                                              tuningVec[heuristicTuningIndex[sol]],
-                                              *dWorkspace));
-                    CHECK_HIPBLASLT_ERROR(gemmVec[0].run(stream));
-                }
-                else
-                {
-                    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
-                    EXPECT_HIPBLAS_STATUS(hipblasLtMatmul(handle,
-                                                          matmul[0][0],
-                                                          alpha_in[0],
-                                                          dA[0].buf(),
-                                                          matA[0],
-                                                          dB[0].buf(),
-                                                          matB[0],
-                                                          &(h_beta[0]),
-                                                          dC[0].buf(),
-                                                          matC[0],
-                                                          (*dDp)[0].buf(),
-                                                          matD[0],
-                                                          &heuristicResult[sol].algo,
-                                                          *dWorkspace,
-                                                          workspace_size,
-                                                          stream),
-                                          HIPBLAS_STATUS_SUCCESS);
-                }
-            }
-            else
-            {
-                //grouped gemm
-                if(arg.use_user_args)
-                {
-                    CHECK_HIPBLASLT_ERROR(
-                        groupedGemmVec[0].initialize(heuristicResult[sol].algo,
-                                                     tuningVec[heuristicTuningIndex[0]],
-                                                     *dWorkspace));
-                    groupedGemmVec[0].getDefaultValueForDeviceUserArguments(userArgs);
-                    // Copy them to device memory
-                    CHECK_HIP_ERROR(hipMemcpy(d_userArgs,
-                                              userArgs,
-                                              gemm_count * sizeof(hipblaslt_ext::UserArguments),
-                                              hipMemcpyHostToDevice));
-
-                    CHECK_HIPBLASLT_ERROR(groupedGemmVec[0].run(d_userArgs, stream));
-                }
-                else
-                {
-                    CHECK_HIPBLASLT_ERROR(
-                        groupedGemmVec[0].initialize(heuristicResult[sol].algo,
-                                                     tuningVec[heuristicTuningIndex[0]],
-                                                     *dWorkspace,
-                                                     false,
-                                                     stream));
-
-                    CHECK_HIPBLASLT_ERROR(groupedGemmVec[0].run(stream));
-                }
-            }
+            run_solution(sol);
 
             double              hipblaslt_error = 0.0;
             double              hipblaslt_atol  = 1;
@@ -2937,8 +2973,10 @@ void testing_matmul_with_bias(const Arguments& arg,
     else
     {
         // Get device information
+        int             deviceId;
         hipDeviceProp_t deviceProps;
-        CHECK_HIP_ERROR(hipGetDeviceProperties(&deviceProps, 0));
+        CHECK_HIP_ERROR(hipGetDevice(&deviceId));
+        CHECK_HIP_ERROR(hipGetDeviceProperties(&deviceProps, deviceId));
         int32_t gpu_block3 = deviceProps.multiProcessorCount * 60;
 
         size_t      best_sol       = -1;
@@ -2950,7 +2988,24 @@ void testing_matmul_with_bias(const Arguments& arg,
         double      best_norm      = 0.0;
         double      best_atol      = 0.0;
         double      best_rtol      = 0.0;
-        int         number_cold_calls
+
+        hipblaslt_timing_stats timing_stats, best_timing_stats;
+
+        // --audit_determinism: D of the first run of each solution and of its reruns
+        std::vector<HipHostBuffer> hD_audit_ref, hD_audit;
+        size_t                     audit_deterministic_sol  = -1;
+        double                     audit_deterministic_time = std::numeric_limits<double>::max();
+        size_t                     audit_disagreements      = 0;
+        if(arg.audit_determinism > 0)
+        {
+            for(int i = 0; i < gemm_count; i++)
+            {
+                hD_audit_ref.emplace_back(To, size_D[i]);
+                hD_audit.emplace_back(To, size_D[i]);
+            }
+        }
+
+        int number_cold_calls
             = ((arg.unit_check || arg.norm_check || arg.allclose_check) && arg.cold_iters == 0)
                   ? 1
                   : arg.cold_iters;
@@ -2987,8 +3042,75 @@ void testing_matmul_with_bias(const Arguments& arg,
             flush_time_used /= flush_iter;
         }
 
+        // When tuning, the default heuristic solution is timed first. It is the baseline of the
+        // tuning report and of --skip_slow_solution_ratio, and is never cut by the budget.
+        bool tuning = heuristicResult.size() > 1
+                      && (getenv("HIPBLASLT_TUNING_FILE") || ArgumentModel_get_tuning_report()
+                          || arg.tuning_budget_ms > 0);
+        int32_t default_index    = -1;
+        bool    default_first    = false;
+        double  default_gpu_time = ArgumentLogging::NA_value;
+        size_t  solutions_tried  = 0;
+        if(tuning)
+        {
+            std::vector<hipblasLtMatmulHeuristicResult_t> defaultAlgo;
+            if(arg.algo_method == 0)
+                defaultAlgo.push_back(heuristicResult[0]);
+            else if(do_grouped_gemm)
+                groupedGemmVec[0].algoGetHeuristic(1, gemmPref, defaultAlgo);
+            else if(arg.use_ext)
+                gemmVec[0].algoGetHeuristic(1, gemmPref, defaultAlgo);
+            else
+            {
+                int returned = 0;
+                defaultAlgo.resize(1);
+                if(hipblasLtMatmulAlgoGetHeuristic(handle,
+                                                   matmul[0][0],
+                                                   matA[0],
+                                                   matB[0],
+                                                   matC[0],
+                                                   matD[0],
+                                                   pref,
+                                                   1,
+                                                   defaultAlgo.data(),
+                                                   &returned)
+                       != HIPBLAS_STATUS_SUCCESS
+                   || returned == 0)
+                    defaultAlgo.clear();
+            }
+            if(!defaultAlgo.empty())
+                default_index = hipblaslt_ext::getIndexFromAlgo(defaultAlgo[0].algo);
+
+            for(size_t sol = 0; sol < heuristicResult.size(); sol++)
+            {
+                if(hipblaslt_ext::getIndexFromAlgo(heuristicResult[sol].algo) == default_index)
+                {
+                    std::rotate(heuristicResult.begin(),
+                                heuristicResult.begin() + sol,
+                                heuristicResult.begin() + sol + 1);
+                    std::rotate(heuristicTuningIndex.begin(),
+                                heuristicTuningIndex.begin() + sol,
+                                heuristicTuningIndex.begin() + sol + 1);
+                    default_first = true;
+                    break;
+                }
+            }
+        }
+
+        auto tuning_start = std::chrono::steady_clock::now();
         for(size_t sol = 0; sol < heuristicResult.size(); sol++)
         {
+            if(arg.tuning_budget_ms > 0 && sol > 0
+               && std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+                                                            - tuning_start)
+                          .count()
+                      > arg.tuning_budget_ms)
+            {
+                hipblaslt_cout << "Tuning budget of " << arg.tuning_budget_ms
+                               << " ms reached after " << sol << " of " << heuristicResult.size()
+                               << " solutions" << std::endl;
+                break;
+            }
             if((arg.unit_check || arg.norm_check || arg.allclose_check) && arg.c_equal_d)
             {
                 for(int i = 0; i < gemm_count; i++)
@@ -3036,14 +3158,19 @@ void testing_matmul_with_bias(const Arguments& arg,
                         }
                     }
                     freq_monitor.start();
-                    pre_gpu_time(arg.use_gpu_timer, event_gpu_time_start, gpu_time_used, stream);
-
-                    for(int i = 0; i < number_hot_calls; i++)
-                    {
+                    auto hot_call = [&](int i) {
                         CHECK_HIPBLASLT_ERROR(gemmVec[i % block_count].run(stream));
                         if(arg.flush)
                             hipLaunchKernelGGL(flush_icache, dim3(gpu_block3), dim3(64), 0, stream);
-                    }
+                    };
+                    time_hot_calls(arg,
+                                   event_gpu_time_start,
+                                   event_gpu_time_end,
+                                   gpu_time_used,
+                                   stream,
+                                   number_hot_calls,
+                                   timing_stats,
+                                   hot_call);
                 }
                 else
                 {
@@ -3104,9 +3231,7 @@ void testing_matmul_with_bias(const Arguments& arg,
                         }
                     }
                     freq_monitor.start();
-                    pre_gpu_time(arg.use_gpu_timer, event_gpu_time_start, gpu_time_used, stream);
-                    for(int i = 0; i < number_hot_calls; i++)
-                    {
+                    auto hot_call = [&](int i) {
                         auto ptr_matmul = matmul[i % block_count][0];
                         auto ptr_alpha  = arg.scaleAlpha_vector
                                               ? (dScaleAlphaVec[0].as<char>())
@@ -3137,13 +3262,16 @@ void testing_matmul_with_bias(const Arguments& arg,
                             HIPBLAS_STATUS_SUCCESS);
                         if(arg.flush)
                             hipLaunchKernelGGL(flush_icache, dim3(gpu_block3), dim3(64), 0, stream);
-                    }
+                    };
+                    time_hot_calls(arg,
+                                   event_gpu_time_start,
+                                   event_gpu_time_end,
+                                   gpu_time_used,
+                                   stream,
+                                   number_hot_calls,
+                                   timing_stats,
+                                   hot_call);
                 }
-                post_gpu_time(arg.use_gpu_timer,
-                              event_gpu_time_start,
-                              event_gpu_time_end,
-                              gpu_time_used,
-                              stream);
                 freq_monitor.stop();
             }
             else
@@ -3199,17 +3327,18 @@ void testing_matmul_with_bias(const Arguments& arg,
                         }
                     }
                     freq_monitor.start();
-                    pre_gpu_time(arg.use_gpu_timer, event_gpu_time_start, gpu_time_used, stream);
-
-                    for(int i = 0; i < number_hot_calls; i++)
+                    auto hot_call = [&](int i) {
                         CHECK_HIPBLASLT_ERROR(groupedGemmVec[i % block_count].run(
                             d_userArgsVec[i % block_count], stream));
-
-                    post_gpu_time(arg.use_gpu_timer,
-                                  event_gpu_time_start,
-                                  event_gpu_time_end,
-                                  gpu_time_used,
-                                  stream);
+                    };
+                    time_hot_calls(arg,
+                                   event_gpu_time_start,
+                                   event_gpu_time_end,
+                                   gpu_time_used,
+                                   stream,
+                                   number_hot_calls,
+                                   timing_stats,
+                                   hot_call);
                     freq_monitor.stop();
                 }
                 else
@@ -3253,16 +3382,17 @@ void testing_matmul_with_bias(const Arguments& arg,
                         }
                     }
                     freq_monitor.start();
-                    pre_gpu_time(arg.use_gpu_timer, event_gpu_time_start, gpu_time_used, stream);
-
-                    for(int i = 0; i < number_hot_calls; i++)
+                    auto hot_call = [&](int i) {
                         CHECK_HIPBLASLT_ERROR(groupedGemmVec[i % block_count].run(stream));
-
-                    post_gpu_time(arg.use_gpu_timer,
-                                  event_gpu_time_start,
-                                  event_gpu_time_end,
-                                  gpu_time_used,
-                                  stream);
+                    };
+                    time_hot_calls(arg,
+                                   event_gpu_time_start,
+                                   event_gpu_time_end,
+                                   gpu_time_used,
+                                   stream,
+                                   number_hot_calls,
+                                   timing_stats,
+                                   hot_call);
                     freq_monitor.stop();
                 }
             }
@@ -3331,15 +3461,75 @@ void testing_matmul_with_bias(const Arguments& arg,
                       Talpha);
             }
 
+            if(arg.audit_determinism > 0)
+            {
+                int mismatches = 0;
+                for(int run = 0; run <= arg.audit_determinism; run++)
+                {
+                    if(arg.c_equal_d)
+                    {
+                        for(int i = 0; i < gemm_count; i++)
+                            CHECK_HIP_ERROR(synchronize(dC[i], hC[i], block_count));
+                    }
+                    run_solution(sol);
+                    copy_gemm_to_host(
+                        stream, gemm_count, run == 0 ? hD_audit_ref : hD_audit, (*dDp));
+                    if(run == 0)
+                        continue;
+                    for(int i = 0; i < gemm_count; i++)
+                    {
+                        if(memcmp(hD_audit_ref[i].buf(),
+                                  hD_audit[i].buf(),
+                                  hD_audit[i].getNumBytes())
+                           != 0)
+                        {
+                            mismatches++;
+                            break;
+                        }
+                    }
+                }
+                if(mismatches == 0 && gpu_time_used < audit_deterministic_time)
+                {
+                    audit_deterministic_sol  = sol;
+                    audit_deterministic_time = gpu_time_used;
+                }
+                // A solution classified deterministic that differs is a library bug; one
+                // classified otherwise may still match by chance
+                auto gsu        = tuningVec[heuristicTuningIndex[sol]].splitK;
+                bool classified = hipblaslt_ext::isAlgoDeterministic(
+                    handle, heuristicResult[sol].algo, gsu);
+                if(classified && mismatches)
+                    audit_disagreements++;
+                if(ArgumentModel_log_to_stdout())
+                {
+                    hipblaslt_cout << "Determinism audit: solution index "
+                                   << hipblaslt_ext::getIndexFromAlgo(heuristicResult[sol].algo)
+                                   << (mismatches ? " is not" : " is") << " deterministic, "
+                                   << mismatches << " of " << arg.audit_determinism
+                                   << " reruns differ bitwise";
+                    if(classified && mismatches)
+                        hipblaslt_cout << ", DISAGREES with the library, which classifies it as "
+                                          "deterministic";
+                    else if(!classified && !mismatches)
+                        hipblaslt_cout << ", the library classifies it as non-deterministic";
+                    hipblaslt_cout << std::endl;
+                }
+            }
+
 #define argument_param                                                                            \
     e_transA, e_transB, e_grouped_gemm, e_batch_count, e_M, e_N, e_K, e_alpha, e_lda, e_stride_a, \
         e_beta, e_ldb, e_stride_b, e_ldc, e_stride_c, e_ldd, e_stride_d, e_a_type, e_b_type,      \
         e_c_type, e_d_type, e_compute_type, e_scaleA, e_scaleB, e_scaleC, e_scaleD, e_amaxD,      \
         e_activation_type, e_bias_vector, e_bias_type, e_rotating
 
+            // Structured logs always carry the solution index, and with
+            // --print_solution_found also the solution and kernel names
+            bool structured
+                = ArgumentModel_get_log_format() != ArgumentModel_log_format_t::text;
+            bool        kernelInfo    = arg.print_kernel_info || structured;
             const char* tuningEnv     = getenv("HIPBLASLT_TUNING_FILE");
-            int32_t     solutionIndex = ((tuningEnv && heuristicResult.size() == 1)
-                                     || (arg.print_solution_found && arg.print_kernel_info))
+            int32_t     solutionIndex = ((tuningEnv && heuristicResult.size() == 1) || structured
+                                     || (arg.print_solution_found && kernelInfo))
                                             ? hipblaslt_ext::getIndexFromAlgo(heuristicResult[sol].algo)
                                             : -1;
             std::string solutionName  = "";
@@ -3355,7 +3545,7 @@ void testing_matmul_with_bias(const Arguments& arg,
 
             if(arg.print_solution_found)
             {
-                if(arg.print_kernel_info)
+                if(kernelInfo)
                 {
                     if(arg.use_ext)
                     {
@@ -3397,8 +3587,14 @@ void testing_matmul_with_bias(const Arguments& arg,
                     cpu_time_used,
                     hipblaslt_error,
                     hipblaslt_atol,
-                    hipblaslt_rtol);
-            }
+                    hipblaslt_rtol,
+                    arg.timing_stats ? &timing_stats : nullptr,
+                    false,
+                    arg.print_roofline ? &heuristicResult[sol] : nullptr);
+            }
+            solutions_tried++;
+            if(sol == 0 && default_first)
+                default_gpu_time = gpu_time_used;
             if(best_gpu_time > gpu_time_used)
             {
                 best_sol      = sol;
@@ -3409,14 +3605,19 @@ void testing_matmul_with_bias(const Arguments& arg,
                 best_norm     = hipblaslt_error;
                 best_atol     = hipblaslt_atol;
                 best_rtol     = hipblaslt_rtol;
+
+                best_timing_stats = timing_stats;
             }
         }
 
         if(heuristicResult.size() > 1)
         {
+            bool kernelInfo
+                = arg.print_kernel_info
+                  || ArgumentModel_get_log_format() != ArgumentModel_log_format_t::text;
             const char* tuningEnv = getenv("HIPBLASLT_TUNING_FILE");
             int32_t     solutionIndex
-                = (tuningEnv || arg.print_kernel_info)
+                = (tuningEnv || kernelInfo)
                       ? hipblaslt_ext::getIndexFromAlgo(heuristicResult[best_sol].algo)
                       : -1;
             std::string solutionName = "";
@@ -3429,13 +3630,14 @@ void testing_matmul_with_bias(const Arguments& arg,
                 cuNum    = std::to_string(deviceProps.multiProcessorCount);
             }
 
-            if(arg.print_kernel_info)
+            if(kernelInfo)
             {
                 solutionName = best_s_name;
                 kernelName   = best_k_name;
             }
 
-            hipblaslt_cout << "Winner: " << std::endl;
+            if(ArgumentModel_log_to_stdout())
+                hipblaslt_cout << "Winner: " << std::endl;
             ArgumentModel<argument_param>{}.log_args(
                 Talpha,
                 hipblaslt_cout,
@@ -3455,7 +3657,63 @@ void testing_matmul_with_bias(const Arguments& arg,
                 cpu_time_used,
                 best_norm,
                 best_atol,
-                best_rtol);
+                best_rtol,
+                arg.timing_stats ? &best_timing_stats : nullptr,
+                true,
+                arg.print_roofline ? &heuristicResult[best_sol] : nullptr);
+        }
+
+        if(arg.audit_determinism > 0 && best_sol < heuristicResult.size()
+           && ArgumentModel_log_to_stdout())
+        {
+            // Throughput of the fastest deterministic solution relative to the fastest one
+            if(audit_deterministic_sol < heuristicResult.size())
+                hipblaslt_cout << "Determinism audit: fastest deterministic solution index "
+                               << hipblaslt_ext::getIndexFromAlgo(
+                                      heuristicResult[audit_deterministic_sol].algo)
+                               << " reaches " << std::setprecision(3)
+                               << 100.0 * best_gpu_time / audit_deterministic_time
+                               << "% of the throughput of solution index "
+                               << hipblaslt_ext::getIndexFromAlgo(heuristicResult[best_sol].algo)
+                               << std::endl;
+            else
+                hipblaslt_cout << "Determinism audit: no deterministic solution found"
+                               << std::endl;
+            hipblaslt_cout << "Determinism audit: " << audit_disagreements
+                           << " solutions disagree with the library classification" << std::endl;
+        }
+
+        // Work and time of one call of the chosen solution, for the hipblaslt-bench --devices
+        // summary
+        if(best_sol < heuristicResult.size())
+        {
+            int64_t hot_calls = arg.iters < 1 ? 1 : arg.iters;
+            ArgumentModel_add_totals(best_flops * num_batches[0],
+                                     best_gpu_time / hot_calls
+                                         - (flush_time_used > 0 ? flush_time_used : 0));
+        }
+
+        if(tuning && best_sol < heuristicResult.size())
+        {
+            std::string problem = std::string(1, arg.transA) + arg.transB + " "
+                                  + std::to_string(M[0]) + "x" + std::to_string(N[0]) + "x"
+                                  + std::to_string(K[0]) + "x" + std::to_string(num_batches[0]);
+            if(do_grouped_gemm)
+                problem += " grouped" + std::to_string(gemm_count);
+            problem += std::string(" ") + hip_datatype_to_string(arg.a_type) + "/"
+                       + hip_datatype_to_string(arg.b_type) + "/"
+                       + hip_datatype_to_string(arg.d_type) + " "
+                       + hipblas_computetype_to_string(arg.compute_type) + " "
+                       + hipblaslt_activation_type_to_string(arg.activation_type)
+                       + (arg.bias_vector ? " bias" : "");
+            ArgumentModel_log_tuning_result(
+                problem,
+                default_index,
+                default_gpu_time,
+                hipblaslt_ext::getIndexFromAlgo(heuristicResult[best_sol].algo),
+                best_gpu_time,
+                solutions_tried,
+                heuristicResult.size());
         }
     }
 
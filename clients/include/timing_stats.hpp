@@ -0,0 +1,179 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/*!\file
+ * \brief per-iteration benchmark timing: robust statistics over GPU event times, and a timing
+ * loop that keeps running until the confidence interval is tight enough.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <hip/hip_runtime.h>
+#include <vector>
+
+struct hipblaslt_timing_stats
+{
+    size_t samples  = 0; // iterations timed
+    size_t outliers = 0; // iterations rejected as outliers
+    double mean     = 0; // us, over the samples kept
+    double median   = 0; // us
+    double p5       = 0; // us
+    double p95      = 0; // us
+    double stddev   = 0; // us
+    double ci95     = 0; // us, half-width of the 95% confidence interval of the mean
+};
+
+// Two-sided 95% Student t quantile for df degrees of freedom
+inline double hipblaslt_t95(size_t df)
+{
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+    if(df == 0)
+        return 0;
+    if(df <= sizeof(table) / sizeof(table[0]))
+        return table[df - 1];
+    return 1.96 + 2.4 / df;
+}
+
+// Linear interpolation between closest ranks of a sorted sample
+inline double hipblaslt_percentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    double pos = p * (sorted.size() - 1);
+    size_t lo  = size_t(pos);
+    size_t hi  = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+/*! \brief Compute timing statistics. Samples outside Tukey's outer fences
+ *  [Q1 - 3 IQR, Q3 + 3 IQR] (preemption, clock changes, ...) are dropped before the mean,
+ *  stddev and confidence interval are computed; the percentiles use every sample. */
+inline hipblaslt_timing_stats hipblaslt_compute_timing_stats(std::vector<double> samples)
+{
+    hipblaslt_timing_stats stats;
+    stats.samples = samples.size();
+    if(samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    stats.median = hipblaslt_percentile(samples, 0.5);
+    stats.p5     = hipblaslt_percentile(samples, 0.05);
+    stats.p95    = hipblaslt_percentile(samples, 0.95);
+
+    double q1    = hipblaslt_percentile(samples, 0.25);
+    double q3    = hipblaslt_percentile(samples, 0.75);
+    double lo    = q1 - 3 * (q3 - q1);
+    double hi    = q3 + 3 * (q3 - q1);
+    auto   first = std::lower_bound(samples.begin(), samples.end(), lo);
+    auto   last  = std::upper_bound(samples.begin(), samples.end(), hi);
+    size_t n     = last - first;
+
+    stats.outliers = samples.size() - n;
+
+    double sum = 0;
+    for(auto it = first; it != last; ++it)
+        sum += *it;
+    stats.mean = sum / n;
+
+    if(n > 1)
+    {
+        double sq = 0;
+        for(auto it = first; it != last; ++it)
+            sq += (*it - stats.mean) * (*it - stats.mean);
+        stats.stddev = std::sqrt(sq / (n - 1));
+        stats.ci95   = hipblaslt_t95(n - 1) * stats.stddev / std::sqrt(double(n));
+    }
+    return stats;
+}
+
+/*! \brief Time every call of hot_call(i) with its own GPU events. Runs rounds of iters calls
+ *  until the 95% confidence interval of the mean is within ci_target (relative to the median),
+ *  or budget_ms of wall time has been spent; a non-positive ci_target means a single round.
+ *  The total number of calls made is returned in calls. On an error stats is cleared, not
+ *  computed from the rounds that completed. */
+template <typename F>
+hipError_t hipblaslt_time_iterations(hipStream_t             stream,
+                                     int                     iters,
+                                     double                  ci_target,
+                                     double                  budget_ms,
+                                     hipblaslt_timing_stats& stats,
+                                     int&                    calls,
+                                     F&&                     hot_call)
+{
+    iters = std::max(iters, 1);
+    std::vector<hipEvent_t> events(iters + 1, nullptr);
+    std::vector<double>     samples;
+    hipError_t              err   = hipSuccess;
+    auto                    start = std::chrono::steady_clock::now();
+
+    calls = 0;
+    for(auto& e : events)
+        if((err = hipEventCreate(&e)) != hipSuccess)
+            break;
+
+    while(err == hipSuccess)
+    {
+        if((err = hipEventRecord(events[0], stream)) != hipSuccess)
+            break;
+        for(int i = 0; i < iters && err == hipSuccess; i++)
+        {
+            hot_call(calls++);
+            err = hipEventRecord(events[i + 1], stream);
+        }
+        if(err != hipSuccess || (err = hipEventSynchronize(events[iters])) != hipSuccess)
+            break;
+
+        for(int i = 0; i < iters; i++)
+        {
+            float ms = 0;
+            if((err = hipEventElapsedTime(&ms, events[i], events[i + 1])) != hipSuccess)
+                break;
+            samples.push_back(ms * 1000); // ms to us
+        }
+        if(err != hipSuccess)
+            break;
+        stats = hipblaslt_compute_timing_stats(samples);
+
+        if(ci_target <= 0 || stats.ci95 <= ci_target * stats.median)
+            break;
+        std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+        if(spent.count() >= budget_ms)
+            break;
+    }
+
+    for(auto& e : events)
+        if(e)
+            (void)hipEventDestroy(e);
+    if(err != hipSuccess)
+        stats = hipblaslt_timing_stats{};
+    return err;
+}
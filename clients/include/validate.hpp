@@ -0,0 +1,257 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/* =====================================================================
+    Fused check: near, norm and allclose statistics in a single pass
+   =================================================================== */
+
+/*!\file
+ * \brief compares two results (usually, CPU and GPU results) in one parallel pass and
+ * collects everything the near, norm and allclose checks need.
+ */
+
+#pragma once
+
+#include "hipblaslt_f8_convert.hpp"
+#include "hipblaslt_ostream.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <hipblaslt/hipblaslt.h>
+#include <limits>
+#include <type_traits>
+
+// atol and rtol candidates searched by allclose_check_general, in search order
+constexpr double hipblaslt_allclose_tols[]  = {1e-5, 1e-4, 1e-3, 1e-2, 1e-1};
+constexpr int    hipblaslt_allclose_num_tols = 5;
+
+struct hipblaslt_validate_result
+{
+    double max_abs_error = 0; // max |gpu - cpu|
+    double max_rel_error = 0; // max |gpu - cpu| / |cpu| over the nonzero cpu values
+    double norm_error    = 0; // sum over batches of ||gpu - cpu||_F / ||cpu||_F
+    size_t num_errors    = 0; // number of elements where !(|gpu - cpu| <= abs_tol)
+    bool   complete      = true; // false if the scan stopped after max_errors errors
+
+    // First error in column-major, batch-major order among the elements scanned
+    int64_t first_i     = -1;
+    int64_t first_j     = -1;
+    int64_t first_batch = -1;
+    double  first_cpu   = 0;
+    double  first_gpu   = 0;
+
+    // Bit (a * hipblaslt_allclose_num_tols + r) is set when some element fails
+    // |cpu - gpu| <= atol[a] + |rtol[r] * gpu|
+    uint32_t allclose_fail = 0;
+};
+
+template <typename T>
+constexpr bool hipblaslt_validate_is_f8 = std::is_same<T, hipblaslt_f8_fnuz>{}
+                                          || std::is_same<T, hipblaslt_bf8_fnuz>{}
+#ifdef ROCM_USE_FLOAT8
+                                          || std::is_same<T, hipblaslt_f8>{}
+                                          || std::is_same<T, hipblaslt_bf8>{}
+#endif
+    ;
+
+// Widen n elements to double; 8-bit floats go through the decode table
+template <typename T>
+inline void hipblaslt_validate_load(const T* src, double* dst, int64_t n)
+{
+    if constexpr(hipblaslt_validate_is_f8<T>)
+    {
+        const float* table = hipblaslt_f8_decode_table<T>();
+        for(int64_t i = 0; i < n; i++)
+            dst[i] = table[src[i].data];
+    }
+    else
+    {
+        for(int64_t i = 0; i < n; i++)
+            dst[i] = double(src[i]);
+    }
+}
+
+/*! \brief Scan hCPU and hGPU once, in parallel, and collect the max abs/rel error, the Frobenius
+ *  norm error, the allclose failures and the first element further than abs_tol apart.
+ *  If max_errors is not 0, the scan stops once that many such elements have been found. */
+template <typename T>
+hipblaslt_validate_result hipblaslt_validate_general(int64_t  M,
+                                                     int64_t  N,
+                                                     int64_t  lda,
+                                                     int64_t  stride,
+                                                     const T* hCPU,
+                                                     const T* hGPU,
+                                                     int64_t  batch_count,
+                                                     double   abs_tol,
+                                                     size_t   max_errors = 0)
+{
+    constexpr int64_t         chunk = 1024;
+    hipblaslt_validate_result res;
+    if(M * N == 0)
+        return res;
+
+    std::atomic<size_t> num_errors{0};
+    uint64_t            first_key = std::numeric_limits<uint64_t>::max();
+
+    for(int64_t b = 0; b < batch_count; b++)
+    {
+        if(max_errors && num_errors >= max_errors)
+        {
+            res.complete = false;
+            break;
+        }
+
+        double   err_sq = 0, ref_sq = 0, max_abs = 0, max_rel = 0;
+        uint32_t fail = 0;
+
+#pragma omp parallel reduction(+ : err_sq, ref_sq) reduction(max : max_abs, max_rel) \
+    reduction(| : fail)
+        {
+            double   cpu[chunk], gpu[chunk];
+            uint64_t t_first_key = std::numeric_limits<uint64_t>::max();
+            double   t_first_cpu = 0, t_first_gpu = 0;
+
+#pragma omp for collapse(2) schedule(static)
+            for(int64_t j = 0; j < N; j++)
+                for(int64_t i0 = 0; i0 < M; i0 += chunk)
+                {
+                    if(max_errors && num_errors.load(std::memory_order_relaxed) >= max_errors)
+                        continue;
+
+                    int64_t n      = std::min(chunk, M - i0);
+                    size_t  offset = b * stride + j * size_t(lda) + i0;
+                    hipblaslt_validate_load(hCPU + offset, cpu, n);
+                    hipblaslt_validate_load(hGPU + offset, gpu, n);
+
+                    size_t errors = 0;
+                    for(int64_t i = 0; i < n; i++)
+                    {
+                        double diff = gpu[i] - cpu[i];
+                        double err  = std::abs(diff);
+                        err_sq += diff * diff;
+                        ref_sq += cpu[i] * cpu[i];
+                        max_abs = std::max(max_abs, err);
+                        if(cpu[i] != 0)
+                            max_rel = std::max(max_rel, err / std::abs(cpu[i]));
+
+                        // Every allclose candidate passes when err is within the smallest atol
+                        if(!(err <= hipblaslt_allclose_tols[0]))
+                            for(int a = 0; a < hipblaslt_allclose_num_tols; a++)
+                                for(int r = 0; r < hipblaslt_allclose_num_tols; r++)
+                                {
+                                    double tol = hipblaslt_allclose_tols[a]
+                                                 + std::abs(hipblaslt_allclose_tols[r] * gpu[i]);
+                                    if(!(err <= tol))
+                                        fail |= 1u << (a * hipblaslt_allclose_num_tols + r);
+                                }
+
+                        if(!(err <= abs_tol))
+                        {
+                            errors++;
+                            uint64_t key = (uint64_t(b) * N + j) * M + i0 + i;
+                            if(key < t_first_key)
+                            {
+                                t_first_key = key;
+                                t_first_cpu = cpu[i];
+                                t_first_gpu = gpu[i];
+                            }
+                        }
+                    }
+                    if(errors)
+                        num_errors += errors;
+                }
+
+#pragma omp critical
+            if(t_first_key < first_key)
+            {
+                first_key     = t_first_key;
+                res.first_cpu = t_first_cpu;
+                res.first_gpu = t_first_gpu;
+            }
+        }
+
+        res.norm_error += std::sqrt(err_sq) / std::sqrt(ref_sq);
+        res.max_abs_error = std::max(res.max_abs_error, max_abs);
+        res.max_rel_error = std::max(res.max_rel_error, max_rel);
+        res.allclose_fail |= fail;
+    }
+
+    res.num_errors = num_errors;
+    if(max_errors && res.num_errors >= max_errors)
+        res.complete = false;
+    if(res.num_errors)
+    {
+        res.first_i     = first_key % M;
+        res.first_j     = first_key / M % N;
+        res.first_batch = first_key / M / N;
+    }
+    return res;
+}
+
+inline hipblaslt_validate_result hipblaslt_validate_general(int64_t     M,
+                                                            int64_t     N,
+                                                            int64_t     lda,
+                                                            int64_t     stride,
+                                                            const void* hCPU,
+                                                            const void* hGPU,
+                                                            int64_t     batch_count,
+                                                            double      abs_tol,
+                                                            size_t      max_errors,
+                                                            hipDataType type)
+{
+#define VALIDATE_CASE(TYPE, T)                                                      \
+    case TYPE:                                                                      \
+        return hipblaslt_validate_general(M,                                        \
+                                          N,                                        \
+                                          lda,                                      \
+                                          stride,                                   \
+                                          static_cast<const T*>(hCPU),              \
+                                          static_cast<const T*>(hGPU),              \
+                                          batch_count,                              \
+                                          abs_tol,                                  \
+                                          max_errors)
+
+    switch(type)
+    {
+        VALIDATE_CASE(HIP_R_32F, float);
+        VALIDATE_CASE(HIP_R_64F, double);
+        VALIDATE_CASE(HIP_R_16F, hipblasLtHalf);
+        VALIDATE_CASE(HIP_R_16BF, hip_bfloat16);
+        VALIDATE_CASE(HIP_R_8F_E4M3_FNUZ, hipblaslt_f8_fnuz);
+        VALIDATE_CASE(HIP_R_8F_E5M2_FNUZ, hipblaslt_bf8_fnuz);
+#ifdef ROCM_USE_FLOAT8
+        VALIDATE_CASE(HIP_R_8F_E4M3, hipblaslt_f8);
+        VALIDATE_CASE(HIP_R_8F_E5M2, hipblaslt_bf8);
+#endif
+        VALIDATE_CASE(HIP_R_32I, int32_t);
+        VALIDATE_CASE(HIP_R_8I, hipblasLtInt8);
+    default:
+        hipblaslt_cerr << "Error type in hipblaslt_validate_general" << std::endl;
+        return hipblaslt_validate_result{};
+    }
+#undef VALIDATE_CASE
+}
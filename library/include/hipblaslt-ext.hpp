@@ -32,6 +32,7 @@
 #pragma once
 #include "hipblaslt/hipblaslt.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -1310,6 +1311,119 @@ namespace hipblaslt_ext
         HIPBLASLT_EXPORT hipblasStatus_t run(void* deviceUserArgs, hipStream_t stream);
     };
 
+    /*! \ingroup types_module
+     *  \brief Compact per-gemm inputs of a grouped gemm step, in device memory.
+     *
+     * \details Every array that is set holds one entry per gemm of the group and replaces
+     * that field of the UserArguments, so a router (for example the token dispatch of a
+     * mixture-of-experts layer) only produces what changes between steps. Fields whose
+     * array is nullptr keep the values of the problem set on the GroupedGemm.
+     *
+     * The sizes must not exceed the sizes passed to GroupedGemm::setProblem. The launch
+     * grid is computed on the host from that problem, so larger sizes are not covered,
+     * and the buffers of the problem must hold the largest sizes a step may route.
+     */
+    struct GroupedGemmRoute
+    {
+        const uint32_t* m = nullptr; //!< Size m of each gemm.
+        const uint32_t* n = nullptr; //!< Size n of each gemm.
+        const uint32_t* k = nullptr; //!< Size k of each gemm.
+        void* const*    a = nullptr; //!< The a matrix pointer of each gemm.
+        void* const*    b = nullptr; //!< The b matrix pointer of each gemm.
+        void* const*    c = nullptr; //!< The c matrix pointer of each gemm.
+        void* const*    d = nullptr; //!< The d matrix pointer of each gemm.
+    };
+
+    /*! \ingroup types_module
+     *  \brief Ring of UserArguments buffers for running a GroupedGemm step after step.
+     *
+     * \details Each of the depth slots holds the UserArguments of every gemm of the group
+     * in pinned host memory and in device memory. A step either writes the host slot from
+     * hostArgs() and calls run(stream), which uploads it asynchronously, or calls
+     * run(route, stream), which fills the device slot on the device from a
+     * GroupedGemmRoute. The next step uses the next slot, so the host only waits for the
+     * device when it is depth steps ahead.
+     *
+     * The GroupedGemm must have its problem set and be initialized with useUserArgs = true
+     * before the ring is initialized, and must outlive the ring.
+     */
+    class GroupedGemmUserArgsRing
+    {
+    public:
+        /*! \ingroup library_module
+        *  \brief Constructor
+        *
+        *  @param[in]
+        *  groupedGemm  The grouped gemm the ring runs.
+        *  @param[in]
+        *  depth        Number of slots, at least 2.
+        */
+        HIPBLASLT_EXPORT explicit GroupedGemmUserArgsRing(GroupedGemm& groupedGemm,
+                                                          size_t       depth = 2);
+        HIPBLASLT_EXPORT ~GroupedGemmUserArgsRing();
+
+        GroupedGemmUserArgsRing(const GroupedGemmUserArgsRing&)            = delete;
+        GroupedGemmUserArgsRing& operator=(const GroupedGemmUserArgsRing&) = delete;
+
+        /*! \ingroup library_module
+        *  \brief Allocates the slots and sets all of them to the default arguments of the
+        * problem saved in the grouped gemm.
+        *
+        *  \details
+        *  Call it again after the problem or its gemm count changes. The device slots are
+        * written on stream.
+        *
+        *  \retval HIPBLAS_STATUS_SUCCESS           If the slots are ready.
+        *  \retval HIPBLAS_STATUS_INVALID_VALUE     If the gemm count is 0.
+        *  \retval HIPBLAS_STATUS_ALLOC_FAILED      If a buffer cannot be allocated.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t initialize(hipStream_t stream);
+
+        /*! \ingroup library_module
+        *  \brief Host slot of the next run(stream), one UserArguments per gemm.
+        *
+        *  \details
+        *  Waits until the device is done with the previous step that used the slot. The
+        * slot keeps the values written for that step.
+        */
+        HIPBLASLT_EXPORT UserArguments* hostArgs();
+
+        /*! \ingroup library_module
+        *  \brief Uploads the host slot asynchronously and runs the grouped gemm with it.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t run(hipStream_t stream);
+
+        /*! \ingroup library_module
+        *  \brief Fills the next device slot from route on the device and runs the grouped
+        * gemm with it. Nothing is copied from the host.
+        *
+        *  \details
+        *  The sizes of route must not exceed those of the problem set on the grouped
+        * gemm, see GroupedGemmRoute.
+        */
+        HIPBLASLT_EXPORT hipblasStatus_t run(const GroupedGemmRoute& route, hipStream_t stream);
+
+        HIPBLASLT_EXPORT size_t depth() const;
+
+    private:
+        struct Slot
+        {
+            UserArguments* host   = nullptr;
+            UserArguments* device = nullptr;
+            hipEvent_t     done   = nullptr; // recorded after the gemm that read the slot
+        };
+
+        hipblasStatus_t launch(Slot& slot, hipStream_t stream);
+        void            release();
+
+        GroupedGemm&      m_gemm;
+        size_t            m_depth;
+        size_t            m_count    = 0;
+        size_t            m_next     = 0;
+        UserArguments*    m_defaults = nullptr; // device defaults that route fills start from
+        std::vector<Slot> m_slots;
+    };
+
     /*******************************************************************************
      * Ext APIs
      ******************************************************************************/
@@ -1358,6 +1472,58 @@ namespace hipblaslt_ext
                                 hipblasComputeType_t                           typeCompute,
                                 std::vector<hipblasLtMatmulHeuristicResult_t>& heuristicResults);
 
+    /*! \ingroup library_module
+     *  \brief Stream the possible algorithms to a callback
+     *
+     *  \details
+     *  This function evaluates the algorithms getAllAlgos() would return for an
+     * m x n x k problem in batches and hands each batch to callback as soon as
+     * it is ready, so that tuning can start benchmarking before the whole list
+     * has been evaluated. Algorithms whose predicates reject the problem size
+     * are not passed on. Within a batch the order follows the roofline estimate
+     * (predictedTimeUs), fastest first, with candidates without an estimate
+     * last; there is no order across batches. Return false from callback to
+     * stop the enumeration early. The algorithms still need
+     * matmulIsAlgoSupported() before execution, since the layouts, epilogue
+     * and scaling modes of the real problem are not known here.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  typeGemm Gemm type. ex. GEMM, GROUPED_GEMM.
+     *  @param[in]
+     *  opA, opB Transpose settings of A, B.
+     *  @param[in]
+     *  typeA,typeB,typeC,typeD The data type of matrix A, B, C, D.
+     *  @param[in]
+     *  typeCompute             The compute type.
+     *  @param[in]
+     *  m, n, k                 The problem size used to filter and order the
+     * candidates.
+     *  @param[in]
+     *  callback                Called for each algorithm until it returns false.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the enumeration completed or
+     * was stopped by callback. \retval HIPBLAS_STATUS_INVALID_VALUE If the size
+     * is not positive or callback is empty.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t
+        getAllAlgos(hipblasLtHandle_t                                             handle,
+                    GemmType                                                      typeGemm,
+                    hipblasOperation_t                                            opA,
+                    hipblasOperation_t                                            opB,
+                    hipDataType                                                   typeA,
+                    hipDataType                                                   typeB,
+                    hipDataType                                                   typeC,
+                    hipDataType                                                   typeD,
+                    hipblasComputeType_t                                          typeCompute,
+                    int64_t                                                       m,
+                    int64_t                                                       n,
+                    int64_t                                                       k,
+                    const std::function<bool(hipblasLtMatmulHeuristicResult_t&)>& callback);
+
     /*! \ingroup library_module
      *  \brief Retrieve the algorithm index
      *
@@ -1405,6 +1571,28 @@ namespace hipblaslt_ext
     HIPBLASLT_EXPORT std::string getKernelNameFromAlgo(hipblasLtHandle_t      handle,
                                                        hipblasLtMatmulAlgo_t& algo);
 
+    /*! \ingroup library_module
+     *  \brief Whether the solution of an algorithm is deterministic
+     *
+     *  \details
+     *  A deterministic solution writes bitwise identical results from run to run. This
+     * is the classification setDeterministicMode() filters on.
+     *
+     *  @param[in]
+     *  handle  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  algo    The algorithm.
+     *  @param[in]
+     *  gsu     The GSU of a GemmTuning the algorithm runs with, 0 for its own.
+     *
+     *  \retval bool True if the solution is deterministic, false if not or if the
+     * index stored in algo < 0.
+     */
+    HIPBLASLT_EXPORT bool isAlgoDeterministic(hipblasLtHandle_t      handle,
+                                              hipblasLtMatmulAlgo_t& algo,
+                                              uint16_t               gsu = 0);
+
     /*! \ingroup library_module
      *  \brief Retrieve the possible algorithms
      *
@@ -1497,4 +1685,278 @@ namespace hipblaslt_ext
                       hipblasLtMatrixLayout_t Bdesc,
                       hipblasLtMatrixLayout_t Cdesc,
                       hipblasLtMatrixLayout_t Ddesc);
+
+    /*! \ingroup library_module
+     *  \brief Tune a matrix multiplication in process
+     *
+     *  \details
+     *  This function benchmarks up to candidateCount solutions returned by
+     * hipblasLtMatmulAlgoGetHeuristic() for the problem and returns the fastest.
+     * Every candidate is warmed up once and then timed over iterations calls with
+     * GPU events. The calls rotate over copies of A, B, C and D whose total size is
+     * about rotatingBytes, so operands are read from memory as in a real workload.
+     * The contents of D are overwritten.
+     *
+     * The selected solution is remembered for the rest of the process and
+     * hipblasLtMatmulAlgoGetHeuristic() returns it first for the same problem, ahead of
+     * HIPBLASLT_TUNING_OVERRIDE_FILE. If HIPBLASLT_TUNING_STORE_FILE is set, tuned
+     * solutions are loaded from that file at startup, as long as the file was written
+     * by the same library version, and merged into it at exit or by
+     * saveTunedSolutions() with the same path.
+     *
+     *  @param[in]
+     *  handle                  Pointer to the allocated hipBLASLt handle for the
+     * hipBLASLt context. See \ref hipblasLtHandle_t .
+     *  @param[in]
+     *  matmulDesc              Handle to a previously created matrix multiplication
+     * descriptor of type \ref hipblasLtMatmulDesc_t .
+     *  @param[in]
+     *  alpha,beta              Pointers to the scalars used in the multiplication.
+     *  @param[in]
+     *  A,B,C                   Pointers to the GPU memory of the input matrices.
+     *  @param[out]
+     *  D                       Pointer to the GPU memory of the output matrix.
+     *  @param[in]
+     *  Adesc,Bdesc,Cdesc,Ddesc Handles to the previously created matrix layout
+     * descriptors of the type \ref hipblasLtMatrixLayout_t .
+     *  @param[in]
+     *  pref                    The preference, the workspace of the candidates is
+     * limited to its max workspace bytes and allocated by this function.
+     *  @param[in]
+     *  candidateCount          The number of heuristic solutions to benchmark.
+     *  @param[in]
+     *  iterations              The number of timed calls per candidate.
+     *  @param[in]
+     *  rotatingBytes           The size of the rotating buffers, 0 disables rotation.
+     *  @param[out]
+     *  heuristicResult         The fastest algorithm.
+     *  @param[in]
+     *  stream                  The HIP stream the benchmark runs on.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If a solution was selected.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If no candidate can run the problem.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t matmulAutotune(hipblasLtHandle_t                 handle,
+                                   hipblasLtMatmulDesc_t             matmulDesc,
+                                   const void*                       alpha,
+                                   const void*                       A,
+                                   hipblasLtMatrixLayout_t           Adesc,
+                                   const void*                       B,
+                                   hipblasLtMatrixLayout_t           Bdesc,
+                                   const void*                       beta,
+                                   const void*                       C,
+                                   hipblasLtMatrixLayout_t           Cdesc,
+                                   void*                             D,
+                                   hipblasLtMatrixLayout_t           Ddesc,
+                                   hipblasLtMatmulPreference_t       pref,
+                                   int                               candidateCount,
+                                   int                               iterations,
+                                   size_t                            rotatingBytes,
+                                   hipblasLtMatmulHeuristicResult_t& heuristicResult,
+                                   hipStream_t                       stream);
+
+    /*! \ingroup library_module
+     *  \brief Write the solutions selected by matmulAutotune() to a file
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the file was written.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the file cannot be written.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t saveTunedSolutions(const char* path);
+
+    /*! \ingroup library_module
+     *  \brief Add the solutions of a file written by saveTunedSolutions()
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the file was loaded.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If the file cannot be read or was written
+     * by a different library version.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t loadTunedSolutions(const char* path);
+
+    /*! \ingroup library_module
+     *  \brief Forget all solutions selected by matmulAutotune() or loaded from a file
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the solutions were cleared.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t clearTunedSolutions();
+
+    /*! \ingroup library_module
+     *  \brief Convert a HIPBLASLT_TUNING_OVERRIDE_FILE to the binary override format
+     *
+     *  \details
+     *  The binary file can be used as HIPBLASLT_TUNING_OVERRIDE_FILE directly, or be
+     *  placed next to the CSV file as "<csv file>.bin", in which case it is used instead
+     *  of the CSV file while it is newer.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the file was written.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If src cannot be read or was written by a
+     * different library version.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If dst cannot be written.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t convertTuningOverrideFile(const char* src, const char* dst);
+
+    /*! \ingroup library_module
+     *  \brief Look up a problem in a HIPBLASLT_TUNING_OVERRIDE_FILE
+     *
+     *  \details
+     *  Lets a tuning flow check an override file before it is deployed; it uses its own
+     * copy of the file and does not change the overrides the library applies.
+     *  row is a line in the hipblaslt-bench tuning format, as in the override file; its
+     * solution index is ignored. The problem matches an entry when the transposes, types,
+     * sizes, leading dimensions, activation, bias and scaleA/scaleB mode are all equal.
+     * The file is read like HIPBLASLT_TUNING_OVERRIDE_FILE, preferring a newer
+     * "<path>.bin", and kept until it or path changes. With a positive reloadIntervalMs the
+     * file is checked for changes at most that often, as with
+     * HIPBLASLT_TUNING_OVERRIDE_RELOAD_MS; 0 reads each path once. A file that cannot be
+     * reloaded keeps its previous entries. solutionIndex is the index
+     * with the highest priority for the problem, or -1 if the problem is not in the file.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the file was searched.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If path or row is nullptr, or row cannot be
+     * parsed.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t lookupTuningOverride(const char* path,
+                                         const char* row,
+                                         int         reloadIntervalMs,
+                                         int&        solutionIndex);
+
+    /*! \ingroup types_module
+     *  \brief Host overhead metric returned by getHostMetrics()
+     *
+     *  \details
+     *  Timers cover problem_construction, cache_lookup, heuristic_selection (which
+     *  includes the cache lookup), argument_building, code_object_loading and
+     *  kernel_launch. Counters (timed is false) only set count. histogram[i] counts the
+     *  samples below (128 << i) ns that are not in a lower bucket, the last bucket is
+     *  open ended.
+     */
+    struct HostMetric
+    {
+        std::string           name;
+        bool                  timed;
+        uint64_t              count;
+        uint64_t              total_ns;
+        uint64_t              max_ns;
+        std::vector<uint64_t> histogram;
+    };
+
+    /*! \ingroup library_module
+     *  \brief Turn the recording of host overhead metrics on or off
+     *
+     *  \details
+     *  Recording starts enabled when HIPBLASLT_METRICS is set to a nonzero value. When
+     *  HIPBLASLT_METRICS_FILE is set the metrics are written to that file at exit.
+     */
+    HIPBLASLT_EXPORT
+    void enableHostMetrics(bool enable);
+
+    /*! \ingroup library_module
+     *  \brief Return the host overhead metrics recorded so far in this process
+     */
+    HIPBLASLT_EXPORT
+    std::vector<HostMetric> getHostMetrics();
+
+    /*! \ingroup library_module
+     *  \brief Zero all host overhead metrics
+     */
+    HIPBLASLT_EXPORT
+    void resetHostMetrics();
+
+    /*! \ingroup library_module
+     *  \brief Write a table of the host overhead metrics to a file, or to stdout if path
+     * is nullptr
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the metrics were written.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the file cannot be written.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t dumpHostMetrics(const char* path);
+
+    /*! \ingroup types_module
+     *  \brief Code object residency counters returned by getCodeObjectResidency()
+     */
+    struct CodeObjectResidency
+    {
+        size_t loadedModules;
+        size_t residentBytes;
+        size_t evictedModules;
+        size_t evictedBytes;
+        size_t reloads;
+    };
+
+    /*! \ingroup library_module
+     *  \brief Set the budget for code objects loaded on demand on the device of a handle
+     *
+     *  \details
+     *  With lazy loading, once the code objects loaded on demand take more than bytes the
+     * least recently used ones are unloaded and reloaded when needed again. The budget
+     * applies to every handle on the device. It starts at TENSILE_CODE_OBJECT_BUDGET_MB,
+     * 0 means no limit. Eviction is skipped while the launching stream is capturing, and
+     * code objects with kernels captured into a graph stay loaded.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the budget was set.
+     *  \retval HIPBLAS_STATUS_NOT_INITIALIZED   If handle is null.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t setCodeObjectBudget(hipblasLtHandle_t handle, size_t bytes);
+
+    /*! \ingroup library_module
+     *  \brief Return the code object residency counters of the device of a handle
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the counters were returned.
+     *  \retval HIPBLAS_STATUS_NOT_INITIALIZED   If handle is null.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t getCodeObjectResidency(hipblasLtHandle_t handle, CodeObjectResidency& stats);
+
+    /*! \ingroup library_module
+     *  \brief Set the number of CUs the gemms on a handle may use
+     *
+     *  \details
+     *  Use it when the gemms share the device with other kernels, for example
+     * collectives running under a complementary CU mask. Solution selection, the
+     * performance models and the stream-K grid size then assume cuCount CUs, and
+     * the heuristic results are cached separately per CU count. The library variant
+     * for the device is still chosen by its physical CU count. 0, or a count that is
+     * not below the physical one, restores all CUs. New handles start with the count
+     * set by HIPBLASLT_STREAMK_AVAILABLE_CUS. Do not change it while gemms on the
+     * handle are being set up.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the count was set.
+     *  \retval HIPBLAS_STATUS_INVALID_VALUE     If cuCount is negative.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t setAvailableComputeUnits(hipblasLtHandle_t handle, int cuCount);
+
+    /*! \ingroup library_module
+     *  \brief Set the CUs the gemms on a handle may use to the CUs enabled in the CU mask
+     * of stream, see setAvailableComputeUnits()
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the count was set.
+     *  \retval HIPBLAS_STATUS_INTERNAL_ERROR    If the CU mask cannot be read.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t setAvailableComputeUnitsFromStream(hipblasLtHandle_t handle,
+                                                       hipStream_t       stream);
+
+    /*! \ingroup library_module
+     *  \brief Restrict the gemms on a handle to deterministic solutions
+     *
+     *  \details
+     *  In deterministic mode the heuristic only returns solutions whose results are
+     * bitwise identical from run to run. Stream-K solutions with an atomic fixup and
+     * GSU solutions accumulating the splits with atomics are excluded, and
+     * isAlgoSupported() rejects them. The heuristic results are cached separately for
+     * each mode. New handles start in the mode set by HIPBLASLT_DETERMINISTIC.
+     *
+     *  \retval HIPBLAS_STATUS_SUCCESS           If the mode was set.
+     *  \retval HIPBLAS_STATUS_NOT_INITIALIZED   If handle is null.
+     */
+    HIPBLASLT_EXPORT
+    hipblasStatus_t setDeterministicMode(hipblasLtHandle_t handle, bool deterministic);
 } // End of namespace hipblasltext
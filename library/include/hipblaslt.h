@@ -317,6 +317,15 @@ typedef struct _hipblasLtMatmulAlgo_t{
 #endif
 } hipblasLtMatmulAlgo_t;
 
+/*! \ingroup types_module
+ *  \brief Limiting resource of a heuristic result according to the roofline estimate.
+ */
+typedef enum {
+  HIPBLASLT_BOUND_UNKNOWN = 0, /**<No estimate is available.*/
+  HIPBLASLT_BOUND_COMPUTE = 1, /**<Limited by the matrix core throughput of the compute type.*/
+  HIPBLASLT_BOUND_MEMORY  = 2, /**<Limited by the global memory bandwidth.*/
+} hipblasLtBoundType_t;
+
 /*! \ingroup types_module
  *  \struct hipblasLtMatmulHeuristicResult_t
  *  \brief Description of the matrix multiplication algorithm
@@ -327,13 +336,17 @@ typedef struct _hipblasLtMatmulAlgo_t{
  *  @param algo \ref hipblasLtMatmulAlgo_t struct
  *  @param workspaceSize Actual size of workspace memory required
  *  @param state Result status. Other fields are valid only if, after call to hipblasLtMatmulAlgoGetHeuristic(), this member is set to HIPBLAS_STATUS_SUCCESS
+ *  @param predictedTimeUs,efficiency,boundType Roofline estimate from the tile granularity of the solution and the peak throughput and bandwidth of the device. It is meant for deciding whether to split, fuse or pad a GEMM without running it, not as a measurement.
  */
 typedef struct _hipblasLtMatmulHeuristicResult_t{
   hipblasLtMatmulAlgo_t algo;                      /**<Algo struct*/
   size_t workspaceSize = 0;                        /**<Actual size of workspace memory required.*/
   hipblasStatus_t state = HIPBLAS_STATUS_SUCCESS;  /**<Result status. Other fields are valid only if, after call to hipblasLtMatmulAlgoGetHeuristic(), this member is set to HIPBLAS_STATUS_SUCCESS..*/
   float wavesCount = 1.0;                          /**<Waves count is a device utilization metric. A wavesCount value of 1.0f suggests that when the kernel is launched it will fully occupy the GPU.*/
-  int reserved[4];                                 /**<Reserved.*/
+  float predictedTimeUs = 0;                       /**<Roofline estimate of the kernel time in microseconds, 0 if no estimate is available.*/
+  float efficiency = 0;                            /**<Estimated fraction of the device peak throughput for the compute type that the solution reaches, 0 if unknown.*/
+  int boundType = HIPBLASLT_BOUND_UNKNOWN;         /**<\ref hipblasLtBoundType_t of the estimate.*/
+  int reserved[1];                                 /**<Reserved.*/
 } hipblasLtMatmulHeuristicResult_t;
 #elif defined(__HIP_PLATFORM_NVIDIA__)
 #endif
@@ -194,8 +194,12 @@ uint8_t cast_to_f8_no_range_reduce(T _x, bool stoch = false, uint32_t rng = 0) {
             mantissa += (1 << mfmt); //Add the implicit 1 into mantissa
         }
 
-        bool midpoint = (mantissa & ((1 << (mfmt - wm + exponent_diff)) - 1))
-                        == (1 << (mfmt - wm + exponent_diff - 1));
+        // Shifting by 32 or more is undefined. Inputs that far below the f8 denormal range
+        // can neither be a tie nor keep any mantissa bit, so handle them explicitly.
+        const int midpoint_shift = mfmt - wm + exponent_diff;
+        bool      midpoint       = midpoint_shift < 32
+                         && (mantissa & ((1u << midpoint_shift) - 1))
+                                == (1u << (midpoint_shift - 1));
         /* This part is a bit tricky. The judgment of whether it is a tie needs to be done before we shift right
      as shift right could rip off some residual part and make something not midpoint look like midpoint.
      For example, the fp16 number 0x1002 (0 00100 0000000010), it is larger than midpoint,
@@ -203,7 +207,7 @@ uint8_t cast_to_f8_no_range_reduce(T _x, bool stoch = false, uint32_t rng = 0) {
   */
 
         if(exponent_diff > 0)
-            mantissa >>= exponent_diff;
+            mantissa = exponent_diff < 32 ? mantissa >> exponent_diff : 0;
         else if(exponent_diff == -1)
             mantissa <<= -exponent_diff;
         bool implicit_one = mantissa & (1 << mfmt);
@@ -29,6 +29,7 @@
 #include "hipblaslt_internal.hpp"
 #include <Debug.hpp>
 #include <algorithm>
+#include <cstring>
 #include <hip/hip_runtime.h>
 #include <hipblaslt/hipblaslt_float8.h>
 #include <iostream>
@@ -1520,6 +1521,186 @@ namespace hipblaslt_ext
         return status;
     }
 
+    __global__ void fillGroupedGemmUserArgs(UserArguments*       args,
+                                            const UserArguments* defaults,
+                                            GroupedGemmRoute     route,
+                                            uint32_t             gemmCount)
+    {
+        const auto i = blockIdx.x * blockDim.x + threadIdx.x;
+        if(i >= gemmCount)
+            return;
+
+        UserArguments arg = defaults[i];
+        if(route.m)
+            arg.m = route.m[i];
+        if(route.n)
+            arg.n = route.n[i];
+        if(route.k)
+            arg.k = route.k[i];
+        if(route.a)
+            arg.a = route.a[i];
+        if(route.b)
+            arg.b = route.b[i];
+        if(route.c)
+            arg.c = route.c[i];
+        if(route.d)
+            arg.d = route.d[i];
+        args[i] = arg;
+    }
+
+    GroupedGemmUserArgsRing::GroupedGemmUserArgsRing(GroupedGemm& groupedGemm, size_t depth)
+        : m_gemm(groupedGemm)
+        , m_depth(std::max<size_t>(depth, 2))
+    {
+    }
+
+    GroupedGemmUserArgsRing::~GroupedGemmUserArgsRing()
+    {
+        release();
+    }
+
+    void GroupedGemmUserArgsRing::release()
+    {
+        for(auto& slot : m_slots)
+        {
+            if(slot.done)
+            {
+                static_cast<void>(hipEventSynchronize(slot.done));
+                static_cast<void>(hipEventDestroy(slot.done));
+            }
+            static_cast<void>(hipHostFree(slot.host));
+            static_cast<void>(hipFree(slot.device));
+        }
+        m_slots.clear();
+        static_cast<void>(hipFree(m_defaults));
+        m_defaults = nullptr;
+        m_count    = 0;
+        m_next     = 0;
+    }
+
+    hipblasStatus_t GroupedGemmUserArgsRing::initialize(hipStream_t stream)
+    {
+        release();
+
+        m_count = m_gemm.getGemmCount();
+        if(m_count == 0)
+            return HIPBLAS_STATUS_INVALID_VALUE;
+
+        const size_t bytes = sizeof(UserArguments) * m_count;
+        if(hipMalloc(&m_defaults, bytes) != hipSuccess)
+        {
+            release();
+            return HIPBLAS_STATUS_ALLOC_FAILED;
+        }
+
+        m_slots.resize(m_depth);
+        for(auto& slot : m_slots)
+        {
+            if(hipHostMalloc(&slot.host, bytes, 0) != hipSuccess
+               || hipMalloc(&slot.device, bytes) != hipSuccess
+               || hipEventCreateWithFlags(&slot.done, hipEventDisableTiming) != hipSuccess)
+            {
+                release();
+                return HIPBLAS_STATUS_ALLOC_FAILED;
+            }
+        }
+
+        auto status = m_gemm.getDefaultValueForDeviceUserArguments(m_slots[0].host);
+        if(status != HIPBLAS_STATUS_SUCCESS)
+        {
+            release();
+            return status;
+        }
+
+        for(size_t i = 1; i < m_depth; i++)
+            memcpy(m_slots[i].host, m_slots[0].host, bytes);
+
+        hipError_t err
+            = hipMemcpyAsync(m_defaults, m_slots[0].host, bytes, hipMemcpyHostToDevice, stream);
+        for(size_t i = 0; i < m_depth && err == hipSuccess; i++)
+        {
+            err = hipMemcpyAsync(
+                m_slots[i].device, m_slots[0].host, bytes, hipMemcpyHostToDevice, stream);
+            if(err == hipSuccess)
+                err = hipEventRecord(m_slots[i].done, stream);
+        }
+        return hipErrorToHIPBLASStatus(err);
+    }
+
+    UserArguments* GroupedGemmUserArgsRing::hostArgs()
+    {
+        if(m_slots.empty())
+            return nullptr;
+
+        auto& slot = m_slots[m_next];
+        static_cast<void>(hipEventSynchronize(slot.done));
+        return slot.host;
+    }
+
+    hipblasStatus_t GroupedGemmUserArgsRing::run(hipStream_t stream)
+    {
+        if(m_slots.empty())
+            return HIPBLAS_STATUS_NOT_INITIALIZED;
+
+        // The slot may last have been read by a gemm on another stream
+        auto& slot = m_slots[m_next];
+        auto  err  = hipStreamWaitEvent(stream, slot.done, 0);
+        if(err == hipSuccess)
+            err = hipMemcpyAsync(slot.device,
+                                 slot.host,
+                                 sizeof(UserArguments) * m_count,
+                                 hipMemcpyHostToDevice,
+                                 stream);
+        if(err != hipSuccess)
+            return hipErrorToHIPBLASStatus(err);
+        return launch(slot, stream);
+    }
+
+    hipblasStatus_t GroupedGemmUserArgsRing::run(const GroupedGemmRoute& route,
+                                                 hipStream_t             stream)
+    {
+        if(m_slots.empty())
+            return HIPBLAS_STATUS_NOT_INITIALIZED;
+
+        // The slot may last have been read by a gemm on another stream
+        auto& slot = m_slots[m_next];
+        auto  err  = hipStreamWaitEvent(stream, slot.done, 0);
+        if(err != hipSuccess)
+            return hipErrorToHIPBLASStatus(err);
+
+        constexpr uint32_t blockSize = 256;
+        const uint32_t     gemmCount = m_count;
+        hipLaunchKernelGGL(fillGroupedGemmUserArgs,
+                           dim3((gemmCount + blockSize - 1) / blockSize),
+                           dim3(blockSize),
+                           0,
+                           stream,
+                           slot.device,
+                           m_defaults,
+                           route,
+                           gemmCount);
+        err = hipGetLastError();
+        if(err != hipSuccess)
+            return hipErrorToHIPBLASStatus(err);
+        return launch(slot, stream);
+    }
+
+    hipblasStatus_t GroupedGemmUserArgsRing::launch(Slot& slot, hipStream_t stream)
+    {
+        auto status = m_gemm.run(slot.device, stream);
+        if(status != HIPBLAS_STATUS_SUCCESS)
+            return status;
+
+        auto err = hipEventRecord(slot.done, stream);
+        m_next   = (m_next + 1) % m_depth;
+        return hipErrorToHIPBLASStatus(err);
+    }
+
+    size_t GroupedGemmUserArgsRing::depth() const
+    {
+        return m_depth;
+    }
+
     hipblasStatus_t matmulIsAlgoSupported(hipblasLtHandle_t       handle,
                                           hipblasLtMatmulDesc_t   matmulDesc,
                                           const void*             alpha,
@@ -1598,6 +1779,50 @@ namespace hipblaslt_ext
         return exception_to_hipblas_status();
     }
 
+    hipblasStatus_t
+        getAllAlgos(hipblasLtHandle_t                                             handle,
+                    GemmType                                                      typeGemm,
+                    hipblasOperation_t                                            opA,
+                    hipblasOperation_t                                            opB,
+                    hipDataType                                                   typeA,
+                    hipDataType                                                   typeB,
+                    hipDataType                                                   typeC,
+                    hipDataType                                                   typeD,
+                    hipblasComputeType_t                                          typeCompute,
+                    int64_t                                                       m,
+                    int64_t                                                       n,
+                    int64_t                                                       k,
+                    const std::function<bool(hipblasLtMatmulHeuristicResult_t&)>& callback)
+    try
+    {
+        rocblaslt::Debug::Instance().markerStart("hipblasLtGetAllAlgosStreamCpp");
+        std::function<bool(rocblaslt_matmul_heuristic_result&)> forward;
+        if(callback)
+            forward = [&callback](rocblaslt_matmul_heuristic_result& result) {
+                return callback(reinterpret_cast<hipblasLtMatmulHeuristicResult_t&>(result));
+            };
+        auto status = RocBlasLtStatusToHIPStatus(
+            rocblaslt_matmul_get_all_algos_cpp((rocblaslt_handle)handle,
+                                               static_cast<rocblaslt::RocGemmType>(typeGemm),
+                                               opA,
+                                               opB,
+                                               typeA,
+                                               typeB,
+                                               typeC,
+                                               typeD,
+                                               (rocblaslt_compute_type)typeCompute,
+                                               m,
+                                               n,
+                                               k,
+                                               forward));
+        rocblaslt::Debug::Instance().markerStop();
+        return status;
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
     int getIndexFromAlgo(hipblasLtMatmulAlgo_t& algo)
     {
         int* algo_ptr = (int*)algo.data;
@@ -1630,6 +1855,17 @@ namespace hipblaslt_ext
         return rocblaslt_get_kernel_name_from_algo((rocblaslt_handle)handle, *rocalgo);
     }
 
+    bool isAlgoDeterministic(hipblasLtHandle_t handle, hipblasLtMatmulAlgo_t& algo, uint16_t gsu)
+    {
+        int* algo_ptr = (int*)algo.data;
+        if(handle == nullptr || *algo_ptr < 0)
+        {
+            return false;
+        }
+        auto rocalgo = reinterpret_cast<const rocblaslt_matmul_algo*>(&algo);
+        return rocblaslt_is_algo_deterministic((rocblaslt_handle)handle, *rocalgo, gsu);
+    }
+
     hipblasStatus_t
         getAlgosFromIndex(hipblasLtHandle_t                              handle,
                           std::vector<int>&                              algoIndex,
@@ -1672,4 +1908,180 @@ namespace hipblaslt_ext
         return status;
     }
 
+    hipblasStatus_t matmulAutotune(hipblasLtHandle_t                 handle,
+                                   hipblasLtMatmulDesc_t             matmulDesc,
+                                   const void*                       alpha,
+                                   const void*                       A,
+                                   hipblasLtMatrixLayout_t           Adesc,
+                                   const void*                       B,
+                                   hipblasLtMatrixLayout_t           Bdesc,
+                                   const void*                       beta,
+                                   const void*                       C,
+                                   hipblasLtMatrixLayout_t           Cdesc,
+                                   void*                             D,
+                                   hipblasLtMatrixLayout_t           Ddesc,
+                                   hipblasLtMatmulPreference_t       pref,
+                                   int                               candidateCount,
+                                   int                               iterations,
+                                   size_t                            rotatingBytes,
+                                   hipblasLtMatmulHeuristicResult_t& heuristicResult,
+                                   hipStream_t                       stream)
+    try
+    {
+        rocblaslt::Debug::Instance().markerStart("hipblasLtMatmulAutotuneCpp");
+        auto status = RocBlasLtStatusToHIPStatus(rocblaslt_matmul_autotune(
+            (rocblaslt_handle)handle,
+            (rocblaslt_matmul_desc)matmulDesc,
+            alpha,
+            A,
+            (rocblaslt_matrix_layout)Adesc,
+            B,
+            (rocblaslt_matrix_layout)Bdesc,
+            beta,
+            C,
+            (rocblaslt_matrix_layout)Cdesc,
+            D,
+            (rocblaslt_matrix_layout)Ddesc,
+            (rocblaslt_matmul_preference)pref,
+            candidateCount,
+            iterations,
+            rotatingBytes,
+            (rocblaslt_matmul_heuristic_result*)&heuristicResult,
+            stream));
+        rocblaslt::Debug::Instance().markerStop();
+        return status;
+    }
+    catch(...)
+    {
+        // The marker was opened above, so close it before reporting the exception
+        rocblaslt::Debug::Instance().markerStop();
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t saveTunedSolutions(const char* path)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(rocblaslt_tuned_solutions_save(path));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t loadTunedSolutions(const char* path)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(rocblaslt_tuned_solutions_load(path));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t clearTunedSolutions()
+    try
+    {
+        rocblaslt_tuned_solutions_clear();
+        return HIPBLAS_STATUS_SUCCESS;
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t convertTuningOverrideFile(const char* src, const char* dst)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(rocblaslt_tuning_override_convert(src, dst));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t lookupTuningOverride(const char* path,
+                                         const char* row,
+                                         int         reloadIntervalMs,
+                                         int&        solutionIndex)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_tuning_override_lookup(path, row, reloadIntervalMs, &solutionIndex));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    void enableHostMetrics(bool enable)
+    {
+        rocblaslt_metrics_enable(enable);
+    }
+
+    std::vector<HostMetric> getHostMetrics()
+    {
+        std::vector<HostMetric> metrics;
+        for(auto const& m : rocblaslt_metrics_get())
+            metrics.push_back({m.name, m.timed, m.count, m.total_ns, m.max_ns, m.histogram});
+        return metrics;
+    }
+
+    void resetHostMetrics()
+    {
+        rocblaslt_metrics_reset();
+    }
+
+    hipblasStatus_t dumpHostMetrics(const char* path)
+    {
+        return RocBlasLtStatusToHIPStatus(rocblaslt_metrics_dump(path));
+    }
+
+    hipblasStatus_t setCodeObjectBudget(hipblasLtHandle_t handle, size_t bytes)
+    try
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_set_code_object_budget((rocblaslt_handle)handle, bytes));
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t getCodeObjectResidency(hipblasLtHandle_t handle, CodeObjectResidency& stats)
+    try
+    {
+        rocblaslt::RocCodeObjectResidency residency;
+        auto status = rocblaslt_get_code_object_residency((rocblaslt_handle)handle, residency);
+        if(status == rocblaslt_status_success)
+            stats = {residency.loaded_modules,
+                     residency.resident_bytes,
+                     residency.evicted_modules,
+                     residency.evicted_bytes,
+                     residency.reloads};
+        return RocBlasLtStatusToHIPStatus(status);
+    }
+    catch(...)
+    {
+        return exception_to_hipblas_status();
+    }
+
+    hipblasStatus_t setAvailableComputeUnits(hipblasLtHandle_t handle, int cuCount)
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_set_available_cus((rocblaslt_handle)handle, cuCount));
+    }
+
+    hipblasStatus_t setAvailableComputeUnitsFromStream(hipblasLtHandle_t handle,
+                                                       hipStream_t       stream)
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_set_available_cus_from_stream((rocblaslt_handle)handle, stream));
+    }
+
+    hipblasStatus_t setDeterministicMode(hipblasLtHandle_t handle, bool deterministic)
+    {
+        return RocBlasLtStatusToHIPStatus(
+            rocblaslt_set_deterministic((rocblaslt_handle)handle, deterministic));
+    }
+
 } // End of namespace hipblasltext
@@ -42,27 +42,6 @@
 #define TO_STR2(x) #x
 #define TO_STR(x) TO_STR2(x)
 
-bool override_path_compare_git_version(OverrideSingleton& override, hipblasLtHandle_t& handle)
-{
-    char git_version[128];
-    hipblasLtGetGitRevision(handle, &git_version[0]);
-    std::ifstream file_read(override.file_path);
-    std::string   firstline;
-    std::string   header = "Git Version: ";
-    std::getline(file_read, firstline);
-    size_t pos = firstline.find(header);
-    if(pos != std::string::npos)
-    {
-        std::string file_version = firstline.substr(pos + header.length());
-        if(file_version == git_version)
-            return true;
-    }
-
-    override.env_mode = false;
-
-    return false;
-}
-
 hipblasStatus_t hipErrorToHIPBLASStatus(hipError_t status)
 {
     switch(status)
@@ -434,18 +413,6 @@ try
 {
     rocblaslt::Debug::Instance().markerStart("hipblasLtMatmulAlgoGetHeuristic");
 
-    OverrideSingleton& override = OverrideSingleton::getInstance();
-    if(override.env_mode)
-    {
-        bool override_success = override_path_compare_git_version(override, handle);
-        if(override_success)
-            log_info(__func__, "HIPBLASLT_TUNING_OVERRIDE_FILE is the correct setting.");
-        else
-            log_error(
-                __func__,
-                "The hipBLASLt git version and the override file git version are not the same.");
-    }
-
     auto status = RocBlasLtStatusToHIPStatus(rocblaslt_matmul_algo_get_heuristic(
         (rocblaslt_handle)handle,
         (rocblaslt_matmul_desc)matmulDesc,
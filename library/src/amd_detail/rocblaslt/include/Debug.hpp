@@ -76,6 +76,19 @@ namespace rocblaslt
 
         bool preload() const;
 
+        // Profile of solution indices to resolve at startup, empty when not set
+        std::string const& preloadProfile() const;
+
+        // CUs to size stream-K grids for: 0 for all CUs of the device, a positive count caps
+        // the CUs, a negative count leaves that many CUs to other kernels
+        int streamKAvailableCUs() const;
+
+        // Size stream-K grids for the CUs enabled in the CU mask of the gemm's stream
+        bool streamKStreamCUMask() const;
+
+        // Default of the deterministic mode of new handles
+        bool deterministic() const;
+
     private:
         friend LazySingleton<Debug>;
 
@@ -83,6 +96,10 @@ namespace rocblaslt
         int         m_value2;
         bool        m_printMarker       = false;
         bool        m_preloadAllKernels = false;
+        std::string m_preloadProfile;
+        int         m_streamKAvailableCUs = 0;
+        bool        m_streamKStreamCUMask = false;
+        bool        m_deterministic       = false;
 
         Debug();
     };
@@ -33,6 +33,7 @@
 #define _ROCBLASLT_AUXILIARY_H_
 
 #include "rocblaslt-types.h"
+#include <functional>
 #include <stdint.h>
 #include <vector>
 
@@ -368,6 +369,21 @@ rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
     rocblaslt_compute_type                          typeCompute,
     std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults);
 
+rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
+    rocblaslt_handle                                               handle,
+    rocblaslt::RocGemmType                                         typeGemm,
+    hipblasOperation_t                                             opA,
+    hipblasOperation_t                                             opB,
+    hipDataType                                                    typeA,
+    hipDataType                                                    typeB,
+    hipDataType                                                    typeC,
+    hipDataType                                                    typeD,
+    rocblaslt_compute_type                                         typeCompute,
+    int64_t                                                        m,
+    int64_t                                                        n,
+    int64_t                                                        k,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback);
+
 rocblaslt_status rocblaslt_matmul_get_algos_from_index_cpp(
     rocblaslt_handle                                handle,
     std::vector<int>&                               solutionIndex,
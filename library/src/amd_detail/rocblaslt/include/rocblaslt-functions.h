@@ -133,9 +133,63 @@ int rocblaslt_matmul_is_tuned(rocblaslt_handle handle,
                               rocblaslt_matrix_layout Bdesc,
                               rocblaslt_matrix_layout Cdesc,
                               rocblaslt_matrix_layout Ddesc);
+
+/*! \brief Benchmarks up to candidateCount solutions for the problem, returns the
+ * fastest and records it in the tuned solution store. */
+rocblaslt_status rocblaslt_matmul_autotune(rocblaslt_handle                   handle,
+                                           rocblaslt_matmul_desc              matmul_desc,
+                                           const void*                        alpha,
+                                           const void*                        A,
+                                           rocblaslt_matrix_layout            matA,
+                                           const void*                        B,
+                                           rocblaslt_matrix_layout            matB,
+                                           const void*                        beta,
+                                           const void*                        C,
+                                           rocblaslt_matrix_layout            matC,
+                                           void*                              D,
+                                           rocblaslt_matrix_layout            matD,
+                                           rocblaslt_matmul_preference        pref,
+                                           int                                candidateCount,
+                                           int                                iterations,
+                                           size_t                             rotatingBytes,
+                                           rocblaslt_matmul_heuristic_result* result,
+                                           hipStream_t                        stream);
+
+rocblaslt_status rocblaslt_tuned_solutions_save(const char* path);
+
+rocblaslt_status rocblaslt_tuned_solutions_load(const char* path);
+
+void rocblaslt_tuned_solutions_clear();
+
+rocblaslt_status rocblaslt_tuning_override_convert(const char* src, const char* dst);
+
+rocblaslt_status rocblaslt_tuning_override_lookup(const char* path,
+                                                  const char* row,
+                                                  int         reload_interval_ms,
+                                                  int*        solution_index);
+
+void rocblaslt_metrics_enable(int enable);
+
+void rocblaslt_metrics_reset();
+
+rocblaslt_status rocblaslt_metrics_dump(const char* path);
+
+rocblaslt_status rocblaslt_set_code_object_budget(rocblaslt_handle handle, size_t bytes);
+
+rocblaslt_status rocblaslt_set_available_cus(rocblaslt_handle handle, int cus);
+
+rocblaslt_status rocblaslt_set_available_cus_from_stream(rocblaslt_handle handle,
+                                                         hipStream_t      stream);
+
+rocblaslt_status rocblaslt_set_deterministic(rocblaslt_handle handle, int deterministic);
 #ifdef __cplusplus
 }
 
+std::vector<rocblaslt::RocMetric> rocblaslt_metrics_get();
+
+rocblaslt_status rocblaslt_get_code_object_residency(rocblaslt_handle                   handle,
+                                                     rocblaslt::RocCodeObjectResidency& stats);
+
 rocblaslt_status rocblaslt_gemm_create_cpp(rocblaslt_handle               handle,
                                            int64_t                        m,
                                            int64_t                        n,
@@ -306,6 +360,10 @@ std::string rocblaslt_get_kernel_name_from_algo(rocblaslt_handle             han
 std::string rocblaslt_get_solution_name_from_algo(rocblaslt_handle             handle,
                                                   const rocblaslt_matmul_algo& algo);
 
+bool rocblaslt_is_algo_deterministic(rocblaslt_handle             handle,
+                                     const rocblaslt_matmul_algo& algo,
+                                     uint16_t                     gsu);
+
 #endif
 
 #endif /* _ROCBLASLT_FUNCTIONS_H_ */
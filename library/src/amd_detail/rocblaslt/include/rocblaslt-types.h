@@ -42,6 +42,7 @@
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
+#include <string>
 #include <vector>
 
 #define ROCBLASLT_KERNEL __global__
@@ -384,10 +385,13 @@ typedef struct __attribute__((packed, aligned(8))) _rocblaslt_matmul_algo
 typedef struct _rocblaslt_matmul_heuristic_result
 {
     rocblaslt_matmul_algo algo;
-    size_t                workspaceSize = 0;
-    rocblaslt_status      state         = rocblaslt_status_success;
-    float                 wavesCount    = 1.0;
-    int                   reserved[4];
+    size_t                workspaceSize   = 0;
+    rocblaslt_status      state           = rocblaslt_status_success;
+    float                 wavesCount      = 1.0;
+    float                 predictedTimeUs = 0;
+    float                 efficiency      = 0;
+    int                   boundType       = HIPBLASLT_BOUND_UNKNOWN;
+    int                   reserved[1];
 } rocblaslt_matmul_heuristic_result;
 
 typedef struct _rocblaslt_solutions
@@ -511,6 +515,25 @@ namespace rocblaslt
         void* amaxD         = nullptr;
     };
 
+    struct RocMetric
+    {
+        std::string           name;
+        bool                  timed    = false;
+        uint64_t              count    = 0;
+        uint64_t              total_ns = 0;
+        uint64_t              max_ns   = 0;
+        std::vector<uint64_t> histogram;
+    };
+
+    struct RocCodeObjectResidency
+    {
+        size_t loaded_modules  = 0;
+        size_t resident_bytes  = 0;
+        size_t evicted_modules = 0;
+        size_t evicted_bytes   = 0;
+        size_t reloads         = 0;
+    };
+
     class RocGemm
     {
     public:
@@ -43,6 +43,26 @@ namespace rocblaslt
         return m_preloadAllKernels;
     }
 
+    std::string const& Debug::preloadProfile() const
+    {
+        return m_preloadProfile;
+    }
+
+    int Debug::streamKAvailableCUs() const
+    {
+        return m_streamKAvailableCUs;
+    }
+
+    bool Debug::streamKStreamCUMask() const
+    {
+        return m_streamKStreamCUMask;
+    }
+
+    bool Debug::deterministic() const
+    {
+        return m_deterministic;
+    }
+
     Debug::Debug()
         : m_value(DEBUG_SM)
         , m_value2(DEBUG_SM2)
@@ -59,6 +79,23 @@ namespace rocblaslt
 
         const char *hipblaslt_preload = std::getenv("HIPBLASLT_PRELOAD_KERNELS");
         m_preloadAllKernels = hipblaslt_preload && strtol(hipblaslt_preload, nullptr, 0) != 0;
+
+        const char* hipblaslt_preload_profile = std::getenv("HIPBLASLT_PRELOAD_PROFILE");
+        if(hipblaslt_preload_profile)
+            m_preloadProfile = hipblaslt_preload_profile;
+
+        const char* hipblaslt_sk_cus = std::getenv("HIPBLASLT_STREAMK_AVAILABLE_CUS");
+        if(hipblaslt_sk_cus)
+        {
+            if(std::string(hipblaslt_sk_cus) == "stream")
+                m_streamKStreamCUMask = true;
+            else
+                m_streamKAvailableCUs = strtol(hipblaslt_sk_cus, nullptr, 0);
+        }
+
+        const char* hipblaslt_deterministic = std::getenv("HIPBLASLT_DETERMINISTIC");
+        m_deterministic
+            = hipblaslt_deterministic && strtol(hipblaslt_deterministic, nullptr, 0) != 0;
     }
 
 } // namespace rocblaslt
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "PreloadProfile.hpp"
+#include "TunedSolutionStoreFormat.hpp"
+#include "hipblaslt_trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+    // Counts uses of each index and remembers when it was first seen
+    class IndexCounter
+    {
+    public:
+        void add(int index)
+        {
+            if(index < 0)
+                return;
+            auto it = m_counts.find(index);
+            if(it == m_counts.end())
+            {
+                m_counts.emplace(index, 1);
+                m_order.push_back(index);
+            }
+            else
+                it->second++;
+        }
+
+        std::vector<int> hottestFirst()
+        {
+            std::stable_sort(m_order.begin(), m_order.end(), [this](int a, int b) {
+                return m_counts[a] > m_counts[b];
+            });
+            return m_order;
+        }
+
+    private:
+        std::unordered_map<int, size_t> m_counts;
+        std::vector<int>                m_order;
+    };
+
+    bool readTrace(std::ifstream& file, IndexCounter& counter)
+    {
+        hipblaslt_trace_header header{};
+        if(!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+           || memcmp(header.magic, HIPBLASLT_TRACE_MAGIC, sizeof(HIPBLASLT_TRACE_MAGIC)) != 0)
+            return false;
+        if(header.version != HIPBLASLT_TRACE_VERSION
+           || header.record_size != sizeof(hipblaslt_trace_record))
+            return true;
+
+        hipblaslt_trace_record record;
+        while(file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+            if(!(record.flags & HIPBLASLT_TRACE_DROPPED))
+                counter.add(record.solution_index);
+        return true;
+    }
+
+    void readTuningStore(std::ifstream& file, const std::string& arch, IndexCounter& counter)
+    {
+        std::string line;
+        while(std::getline(file, line))
+        {
+            if(line.empty() || line[0] == '#')
+                continue;
+
+            std::vector<std::string> fields;
+            std::stringstream        line_ss(line);
+            std::string              entry;
+            while(getline(line_ss, entry, ','))
+                fields.push_back(entry);
+
+            // arch is the first column, the solution index the second to last
+            if(fields.size() < 3 || fields.front() != arch)
+                continue;
+            try
+            {
+                counter.add(std::stoi(fields[fields.size() - 2]));
+            }
+            catch(std::logic_error const&)
+            {
+                continue;
+            }
+        }
+    }
+
+    void readBenchLog(std::ifstream& file, IndexCounter& counter)
+    {
+        static const std::regex solution_index("--solution_index\\s+(-?\\d+)");
+
+        std::string line;
+        std::smatch match;
+        while(std::getline(file, line))
+        {
+            if(!std::regex_search(line, match, solution_index))
+                continue;
+            try
+            {
+                counter.add(std::stoi(match[1]));
+            }
+            catch(std::out_of_range const&)
+            {
+                continue;
+            }
+        }
+    }
+}
+
+std::vector<int> readPreloadProfile(const std::string& path, const std::string& arch)
+{
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+        return {};
+
+    IndexCounter counter;
+    if(readTrace(file, counter))
+        return counter.hottestFirst();
+
+    file.clear();
+    file.seekg(0);
+    std::string first;
+    std::getline(file, first);
+    if(first.compare(0, sizeof(tuned_solution_store_magic) - 1, tuned_solution_store_magic) == 0)
+    {
+        readTuningStore(file, arch, counter);
+    }
+    else
+    {
+        file.clear();
+        file.seekg(0);
+        readBenchLog(file, counter);
+    }
+    return counter.hottestFirst();
+}
@@ -0,0 +1,300 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "TunedSolutionStore.hpp"
+#include "TunedSolutionStoreFormat.hpp"
+#include "utility.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/file.h>
+#include <unistd.h>
+
+#define TO_STR2(x) #x
+#define TO_STR(x) TO_STR2(x)
+
+namespace
+{
+    constexpr int  store_version   = 1;
+    constexpr char store_columns[] = "# arch,transA,transB,a_type,b_type,c_type,d_type,bias_type,"
+                                     "compute_type,epilogue,m,n,k,batch_count,lda,ldb,ldc,ldd,"
+                                     "stride_a,stride_b,stride_c,stride_d,flags,solution_index,"
+                                     "time_us";
+    constexpr int  store_entries   = 25;
+
+    std::string store_header()
+    {
+        return std::string(tuned_solution_store_magic) + "," + std::to_string(store_version)
+               + ",Git Version: " + TO_STR(HIPBLASLT_VERSION_TWEAK);
+    }
+}
+
+bool TunedProblemKey::operator==(const TunedProblemKey& rhs) const
+{
+    return trans_a == rhs.trans_a && trans_b == rhs.trans_b && a_type == rhs.a_type
+           && b_type == rhs.b_type && c_type == rhs.c_type && d_type == rhs.d_type
+           && bias_type == rhs.bias_type && compute_type == rhs.compute_type
+           && epilogue == rhs.epilogue && m == rhs.m && n == rhs.n && k == rhs.k
+           && batch_count == rhs.batch_count && lda == rhs.lda && ldb == rhs.ldb
+           && ldc == rhs.ldc && ldd == rhs.ldd && stride_a == rhs.stride_a
+           && stride_b == rhs.stride_b && stride_c == rhs.stride_c && stride_d == rhs.stride_d
+           && flags == rhs.flags && arch == rhs.arch;
+}
+
+size_t std::hash<TunedProblemKey>::operator()(TunedProblemKey const& key) const
+{
+    return TensileLite::hash_combine(key.arch,
+                                     key.trans_a,
+                                     key.trans_b,
+                                     key.a_type,
+                                     key.b_type,
+                                     key.c_type,
+                                     key.d_type,
+                                     key.bias_type,
+                                     key.compute_type,
+                                     key.epilogue,
+                                     key.m,
+                                     key.n,
+                                     key.k,
+                                     key.batch_count,
+                                     key.lda,
+                                     key.ldb,
+                                     key.ldc,
+                                     key.ldd,
+                                     key.stride_a,
+                                     key.stride_b,
+                                     key.stride_c,
+                                     key.stride_d,
+                                     key.flags);
+}
+
+TunedProblemKey RocblasltContractionProblem2TunedKey(const RocblasltContractionProblem& problem,
+                                                     const hipDeviceProp_t&             prop)
+{
+    // strip out xnack/ecc from name
+    std::string gcnArchName(prop.gcnArchName);
+
+    TunedProblemKey key;
+    key.arch         = gcnArchName.substr(0, gcnArchName.find(":"));
+    key.trans_a      = problem.trans_a;
+    key.trans_b      = problem.trans_b;
+    key.a_type       = problem.a_type;
+    key.b_type       = problem.b_type;
+    key.c_type       = problem.c_type;
+    key.d_type       = problem.d_type;
+    key.bias_type    = problem.bias_type;
+    key.compute_type = problem.compute_type;
+    key.epilogue     = problem.epilogue;
+    key.m            = problem.m;
+    key.n            = problem.n;
+    key.k            = problem.k;
+    key.batch_count  = problem.batch_count;
+    key.lda          = problem.col_stride_a;
+    key.ldb          = problem.col_stride_b;
+    key.ldc          = problem.col_stride_c;
+    key.ldd          = problem.col_stride_d;
+    key.stride_a     = problem.batch_stride_a;
+    key.stride_b     = problem.batch_stride_b;
+    key.stride_c     = problem.batch_stride_c;
+    key.stride_d     = problem.batch_stride_d;
+    key.flags        = (problem.scaleA ? TUNED_SCALE_A : 0) | (problem.scaleB ? TUNED_SCALE_B : 0)
+                | (problem.isScaleAVec ? TUNED_SCALE_A_VEC : 0)
+                | (problem.isScaleBVec ? TUNED_SCALE_B_VEC : 0)
+                | (problem.scaleAlphaVec ? TUNED_SCALE_ALPHA_VEC : 0)
+                | (problem.gradient ? TUNED_GRADIENT : 0);
+    return key;
+}
+
+// Reads the entries of a store file into entries, returns false if the file cannot be read or
+// was written by a different library version
+static bool readStoreFile(const std::string&                                  path,
+                          std::unordered_map<TunedProblemKey, TunedSolution>& entries)
+{
+    std::ifstream file_read(path);
+    std::string   line, entry;
+
+    if(!std::getline(file_read, line) || line != store_header())
+        return false;
+
+    while(std::getline(file_read, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<std::string> fields;
+        fields.reserve(store_entries);
+        std::stringstream line_ss(line);
+        while(getline(line_ss, entry, ','))
+            fields.push_back(entry);
+        if(fields.size() != store_entries)
+            continue;
+
+        try
+        {
+            TunedProblemKey key;
+            TunedSolution   solution;
+            size_t          i = 0;
+
+            key.arch                = fields[i++];
+            key.trans_a             = hipblasOperation_t(std::stoi(fields[i++]));
+            key.trans_b             = hipblasOperation_t(std::stoi(fields[i++]));
+            key.a_type              = hipDataType(std::stoi(fields[i++]));
+            key.b_type              = hipDataType(std::stoi(fields[i++]));
+            key.c_type              = hipDataType(std::stoi(fields[i++]));
+            key.d_type              = hipDataType(std::stoi(fields[i++]));
+            key.bias_type           = hipDataType(std::stoi(fields[i++]));
+            key.compute_type        = rocblaslt_compute_type(std::stoi(fields[i++]));
+            key.epilogue            = rocblaslt_epilogue(std::stoi(fields[i++]));
+            key.m                   = std::stoll(fields[i++]);
+            key.n                   = std::stoll(fields[i++]);
+            key.k                   = std::stoll(fields[i++]);
+            key.batch_count         = std::stoll(fields[i++]);
+            key.lda                 = std::stoll(fields[i++]);
+            key.ldb                 = std::stoll(fields[i++]);
+            key.ldc                 = std::stoll(fields[i++]);
+            key.ldd                 = std::stoll(fields[i++]);
+            key.stride_a            = std::stoll(fields[i++]);
+            key.stride_b            = std::stoll(fields[i++]);
+            key.stride_c            = std::stoll(fields[i++]);
+            key.stride_d            = std::stoll(fields[i++]);
+            key.flags               = std::stoul(fields[i++]);
+            solution.solution_index = std::stoi(fields[i++]);
+            solution.time_us        = std::stod(fields[i++]);
+
+            entries[key] = solution;
+        }
+        catch(std::invalid_argument const& ex)
+        {
+            continue;
+        }
+        catch(std::out_of_range const& ex)
+        {
+            continue;
+        }
+    }
+
+    return true;
+}
+
+TunedSolutionStore::TunedSolutionStore()
+{
+    char* Env = getenv("HIPBLASLT_TUNING_STORE_FILE");
+    if(Env)
+    {
+        m_file_path = Env;
+        if(rocblaslt_internal_test_path(m_file_path) && !load(m_file_path))
+            log_info(__func__, "Ignoring tuning store written by another version", m_file_path);
+    }
+}
+
+TunedSolutionStore::~TunedSolutionStore()
+{
+    // Runs during static destruction, so failures are not logged
+    if(!m_file_path.empty() && m_dirty)
+        static_cast<void>(save(m_file_path));
+}
+
+void TunedSolutionStore::add(const TunedProblemKey& key, const TunedSolution& solution)
+{
+    std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+    m_table[key] = solution;
+    m_dirty      = true;
+}
+
+bool TunedSolutionStore::load(const std::string& path)
+{
+    std::unordered_map<TunedProblemKey, TunedSolution> entries;
+    if(!readStoreFile(path, entries))
+        return false;
+
+    std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+    for(auto& it : entries)
+        m_table[it.first] = it.second;
+    return true;
+}
+
+bool TunedSolutionStore::save(const std::string& path) const
+{
+    std::lock_guard<std::mutex> file_lock(m_file_mutex);
+
+    // Other processes may share the store file: serialize the writers and keep the entries
+    // they added since this process loaded it. Entries of this process win.
+    bool                                               shared  = path == m_file_path;
+    int                                                lock_fd = -1;
+    std::unordered_map<TunedProblemKey, TunedSolution> entries;
+    if(shared)
+    {
+        lock_fd = open((path + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if(lock_fd >= 0)
+            flock(lock_fd, LOCK_EX);
+        if(rocblaslt_internal_test_path(path))
+            static_cast<void>(readStoreFile(path, entries));
+    }
+
+    bool        written  = false;
+    std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file_write(tmp_path, std::ios::trunc);
+        if(file_write)
+        {
+            file_write << store_header() << "\n" << store_columns << "\n";
+
+            // add() needs the exclusive lock, so no entry can slip in between the copy and
+            // clearing the dirty flag
+            std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+            for(auto& it : m_table)
+                entries[it.first] = it.second;
+            if(shared)
+                m_dirty = false;
+            for(auto& it : entries)
+            {
+                auto& key = it.first;
+                file_write << key.arch << "," << key.trans_a << "," << key.trans_b << ","
+                           << key.a_type << "," << key.b_type << "," << key.c_type << ","
+                           << key.d_type << "," << key.bias_type << "," << key.compute_type
+                           << "," << key.epilogue << "," << key.m << "," << key.n << ","
+                           << key.k << "," << key.batch_count << "," << key.lda << ","
+                           << key.ldb << "," << key.ldc << "," << key.ldd << "," << key.stride_a
+                           << "," << key.stride_b << "," << key.stride_c << "," << key.stride_d
+                           << "," << key.flags << "," << it.second.solution_index << ","
+                           << it.second.time_us << "\n";
+            }
+            written = bool(file_write.flush());
+        }
+    }
+
+    if(written)
+        written = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    else
+        std::remove(tmp_path.c_str());
+    if(!written && shared)
+        m_dirty = true;
+
+    if(lock_fd >= 0)
+        close(lock_fd);
+    return written;
+}
@@ -1,98 +1,404 @@
 #include "UserDrivenTuningParser.hpp"
+#include "utility.hpp"
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <shared_mutex>
 #include <sstream>
+#include <sys/stat.h>
 #include <utility>
 
-namespace TensileLite
+#define TO_STR2(x) #x
+#define TO_STR(x) TO_STR2(x)
+
+namespace
 {
+    using TensileLite::ActivationType;
+    using TensileLite::DataType;
+
+    constexpr char     binary_magic[8] = {'h', 'b', 'l', 't', 'o', 'v', 'r', '\0'};
+    constexpr uint32_t binary_version  = 1;
+
+    struct OverrideBinaryHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t record_size;
+        uint64_t record_count;
+        char     git_version[64];
+    };
+
+    // One record per problem/solution pair, in increasing priority order
+    struct OverrideBinaryRecord
+    {
+        int32_t flags; // bit 0: transA, bit 1: transB, bit 2: bias
+        int32_t activation;
+        int32_t scale_ab;
+        int32_t type_a;
+        int32_t type_b;
+        int32_t type_c;
+        int32_t type_d;
+        int32_t type_compute;
+        int32_t solution_index;
+        int32_t reserved;
+        int64_t m;
+        int64_t n;
+        int64_t k;
+        int64_t batch;
+        int64_t lda;
+        int64_t ldb;
+        int64_t ldc;
+        int64_t ldd;
+    };
+    static_assert(sizeof(OverrideBinaryRecord) == 104, "override record layout changed");
+
+    constexpr char git_version[] = TO_STR(HIPBLASLT_VERSION_TWEAK);
+
+    bool file_stamp(const std::string& path, int64_t& mtime, int64_t& size)
+    {
+        struct stat st;
+        if(stat(path.c_str(), &st) != 0)
+            return false;
+        mtime = int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+        size  = st.st_size;
+        return true;
+    }
 
-    void getContractionProblemsFromFile(const std::string& path)
+    DataType entry_to_tensile_type(const std::string& entry)
     {
-        OverrideMap&                m_override = OverrideMap::getMap();
-        std::mutex&                 map_guard  = m_override.getLock();
-        std::lock_guard<std::mutex> lock(map_guard);
+        hipDataType type = string_to_hip_datatype(entry);
+        return type == HIPBLASLT_DATATYPE_INVALID ? DataType::None
+                                                  : hipDataType_to_tensile_type(type);
+    }
 
-        if(m_override.size() == 0)
+    // hipblaslt-bench only writes none, relu and gelu
+    ActivationType entry_to_activation(const std::string& entry)
+    {
+        if(entry == "none")
+            return ActivationType::None;
+        if(entry == "relu")
+            return ActivationType::Relu;
+        if(entry == "gelu")
+            return ActivationType::Gelu;
+        return ActivationType::Count;
+    }
+
+    void add_solution(TensileLite::OverrideTable&         table,
+                      const TensileLite::ProblemOverride& problem,
+                      int                                 solution_index)
+    {
+        auto& indices = table[problem];
+        auto  dup     = std::find(indices.begin(), indices.end(), solution_index);
+        if(dup != indices.end())
+            indices.erase(dup);
+        indices.push_back(solution_index);
+    }
+
+    bool is_binary_override(const std::string& path)
+    {
+        std::ifstream file_read(path, std::ios::binary);
+        char          magic[sizeof(binary_magic)] = {};
+        file_read.read(magic, sizeof(magic));
+        return file_read && memcmp(magic, binary_magic, sizeof(magic)) == 0;
+    }
+
+    std::shared_ptr<TensileLite::OverrideTable> read_override_binary(const std::string& path)
+    {
+        std::ifstream        file_read(path, std::ios::binary);
+        OverrideBinaryHeader header;
+        if(!file_read.read(reinterpret_cast<char*>(&header), sizeof(header))
+           || memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0
+           || header.version != binary_version
+           || header.record_size != sizeof(OverrideBinaryRecord))
         {
+            log_error(__func__, "Invalid binary override file", path);
+            return nullptr;
+        }
+        header.git_version[sizeof(header.git_version) - 1] = '\0';
+        if(strcmp(header.git_version, git_version) != 0)
+        {
+            log_error(
+                __func__,
+                "The hipBLASLt git version and the override file git version are not the same.");
+            return nullptr;
+        }
+
+        std::vector<OverrideBinaryRecord> records(header.record_count);
+        if(!file_read.read(reinterpret_cast<char*>(records.data()),
+                           records.size() * sizeof(OverrideBinaryRecord)))
+        {
+            log_error(__func__, "Truncated binary override file", path);
+            return nullptr;
+        }
+
+        auto table = std::make_shared<TensileLite::OverrideTable>();
+        table->reserve(records.size());
+        for(auto const& r : records)
+        {
+            TensileLite::ProblemOverride po((r.flags & 1) != 0,
+                                            (r.flags & 2) != 0,
+                                            static_cast<DataType>(r.type_a),
+                                            static_cast<DataType>(r.type_b),
+                                            static_cast<DataType>(r.type_compute),
+                                            static_cast<DataType>(r.type_c),
+                                            static_cast<DataType>(r.type_d),
+                                            r.m,
+                                            r.n,
+                                            r.k,
+                                            r.batch,
+                                            r.lda,
+                                            r.ldb,
+                                            r.ldc,
+                                            r.ldd,
+                                            static_cast<ActivationType>(r.activation),
+                                            (r.flags & 4) != 0,
+                                            r.scale_ab);
+            add_solution(*table, po, r.solution_index);
+        }
+        return table;
+    }
+
+    std::shared_ptr<TensileLite::OverrideTable> read_override_csv(const std::string& path)
+    {
+        std::ifstream file_read(path);
+        if(!file_read)
+        {
+            log_error(__func__, "Cannot open override file", path);
+            return nullptr;
+        }
+
+        std::string line, entry;
+        const auto  version     = "Git Version: ";
+        const auto  delim       = ',';
+        const int   max_entries = 40;
 
-            std::ifstream file_read(path);
-            std::string   line, entry;
+        // The first line carries the version of the library that wrote the file
+        std::getline(file_read, line);
+        size_t pos = line.find(version);
+        if(pos == std::string::npos
+           || line.compare(pos + strlen(version), std::string::npos, git_version) != 0)
+        {
+            log_error(
+                __func__,
+                "The hipBLASLt git version and the override file git version are not the same.");
+            return nullptr;
+        }
 
-            const auto verion      = "Git Version";
-            const auto delim       = ',';
-            const int  max_entries = 37;
+        auto table = std::make_shared<TensileLite::OverrideTable>();
+        while(std::getline(file_read, line))
+        {
+            // Ignore lines without delimiter
+            line.erase(0, line.find_first_not_of(" \t\n\r\f\v"));
 
-            while(std::getline(file_read, line))
+            if(line.find(delim) != std::string::npos && line.find(version) == std::string::npos)
             {
-                // Ignore lines without delimiter
-                line.erase(0, line.find_first_not_of(" \t\n\r\f\v"));
+                std::vector<std::string> entries{};
+                entries.reserve(max_entries);
 
-                if(line.find(delim) != std::string::npos && line.find(verion) == std::string::npos)
+                std::stringstream line_ss(line);
+                while(getline(line_ss, entry, delim))
                 {
-                    std::vector<std::string> entries{};
-                    entries.reserve(max_entries);
-
-                    std::stringstream line_ss(line);
-                    while(getline(line_ss, entry, delim))
-                    {
-                        entries.push_back(entry);
-                    }
-
-                    auto problemSolution = problemFromEntries(entries);
-
-                    if(problemSolution.second > 0)
-                    {
-                        auto sol_iter = m_override.find(problemSolution.first);
-                        for(auto sol_idx = sol_iter.first; sol_idx != sol_iter.second; sol_idx++)
-                        {
-                            if(sol_idx->second == problemSolution.second)
-                            {
-                                m_override.erase(sol_idx);
-                                break;
-                            }
-                        }
-
-                        m_override.add(problemSolution);
-                    }
+                    entries.push_back(entry);
                 }
+
+                auto problemSolution = TensileLite::problemFromEntries(entries);
+
+                if(problemSolution.second > 0)
+                    add_solution(*table, problemSolution.first, problemSolution.second);
             }
         }
+        return table;
     }
+}
 
-    std::pair<ProblemOverride, int> problemFromEntries(const std::vector<std::string>& entries)
+namespace TensileLite
+{
+
+    std::shared_ptr<const OverrideTable> getContractionProblemsFromFile(const std::string& path)
+    {
+        OverrideSingleton& override = OverrideSingleton::getInstance();
+        return OverrideMap::getMap().table(path, override.reload_interval_ms);
+    }
+
+    std::shared_ptr<OverrideTable> readOverrideFile(const std::string& path)
+    {
+        if(is_binary_override(path))
+            return read_override_binary(path);
+
+        // A binary file next to the CSV is used while it is newer than the CSV
+        int64_t csvTime, binTime, size;
+        auto    binPath = path + ".bin";
+        if(file_stamp(path, csvTime, size) && file_stamp(binPath, binTime, size)
+           && binTime >= csvTime && is_binary_override(binPath))
+        {
+            auto table = read_override_binary(binPath);
+            if(table)
+                return table;
+        }
+
+        return read_override_csv(path);
+    }
+
+    bool writeOverrideBinary(const OverrideTable& table, const std::string& path)
     {
+        std::vector<OverrideBinaryRecord> records;
+        for(auto const& problemSolutions : table)
+        {
+            auto const& po = problemSolutions.first;
+            for(int solution_index : problemSolutions.second)
+            {
+                OverrideBinaryRecord r{};
+                r.flags = (po.transA() ? 1 : 0) | (po.transB() ? 2 : 0) | (po.bias() ? 4 : 0);
+                r.activation     = static_cast<int32_t>(po.activation());
+                r.scale_ab       = po.scaleABMode();
+                r.type_a         = static_cast<int32_t>(po.inputType());
+                r.type_b         = static_cast<int32_t>(po.inputTypeB());
+                r.type_c         = static_cast<int32_t>(po.outputType());
+                r.type_d         = static_cast<int32_t>(po.outputTypeD());
+                r.type_compute   = static_cast<int32_t>(po.computeType());
+                r.solution_index = solution_index;
+                r.m              = po.m();
+                r.n              = po.n();
+                r.k              = po.k();
+                r.batch          = po.batchSize();
+                r.lda            = po.lda();
+                r.ldb            = po.ldb();
+                r.ldc            = po.ldc();
+                r.ldd            = po.ldd();
+                records.push_back(r);
+            }
+        }
+
+        OverrideBinaryHeader header{};
+        memcpy(header.magic, binary_magic, sizeof(binary_magic));
+        header.version      = binary_version;
+        header.record_size  = sizeof(OverrideBinaryRecord);
+        header.record_count = records.size();
+        strncpy(header.git_version, git_version, sizeof(header.git_version) - 1);
+
+        // Write to a temporary file so that a running process never reads a partial file
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream file_write(tmp_path, std::ios::binary | std::ios::trunc);
+            file_write.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file_write.write(reinterpret_cast<const char*>(records.data()),
+                             records.size() * sizeof(OverrideBinaryRecord));
+            if(!file_write)
+                return false;
+        }
+        return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    }
+
+    std::shared_ptr<const OverrideTable> OverrideMap::table(const std::string& path,
+                                                            int                reloadIntervalMs)
+    {
+        auto table       = std::atomic_load(&m_table);
+        auto tablePath   = std::atomic_load(&m_path);
+        bool currentPath = tablePath && *tablePath == path;
+        if(table && currentPath && !reloadDue(reloadIntervalMs))
+            return table;
+
+        // Only one thread reloads; the others keep using the current table meanwhile
+        std::unique_lock<std::mutex> lock(m_guard, std::defer_lock);
+        if(table && currentPath && !lock.try_lock())
+            return table;
+        if(!lock.owns_lock())
+            lock.lock();
 
+        // readOverrideFile may read "<path>.bin" instead of path, so a change of either reloads
+        table         = std::atomic_load(&m_table);
+        tablePath     = std::atomic_load(&m_path);
+        int64_t mtime = -1, size = -1, binMtime = -1, binSize = -1;
+        file_stamp(path, mtime, size);
+        file_stamp(path + ".bin", binMtime, binSize);
+        if(tablePath && *tablePath == path && mtime == m_mtime && size == m_fileSize
+           && binMtime == m_binMtime && binSize == m_binFileSize)
+            return table;
+
+        // A file that cannot be read, for example while it is being rewritten, keeps the
+        // current table of its path and the old stamps, so the next check reads it again
+        if(auto loaded = readOverrideFile(path))
+        {
+            log_info(__func__, "Loaded override file", path, "with", loaded->size(), "problems");
+            table         = loaded;
+            m_mtime       = mtime;
+            m_fileSize    = size;
+            m_binMtime    = binMtime;
+            m_binFileSize = binSize;
+        }
+        else if(!tablePath || *tablePath != path)
+        {
+            table   = std::make_shared<OverrideTable>();
+            m_mtime = m_fileSize = m_binMtime = m_binFileSize = -1;
+        }
+        else if(mtime != -1 || binMtime != -1)
+        {
+            log_error(__func__, "Keeping the previous overrides, cannot reload", path);
+        }
+        std::atomic_store(&m_table, table);
+        if(!tablePath || *tablePath != path)
+            std::atomic_store(&m_path, std::make_shared<const std::string>(path));
+        return table;
+    }
+
+    bool OverrideMap::reloadDue(int reloadIntervalMs)
+    {
+        if(reloadIntervalMs <= 0)
+            return false;
+
+        int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+        int64_t last = m_lastCheck.load(std::memory_order_relaxed);
+        return now - last >= reloadIntervalMs
+               && m_lastCheck.compare_exchange_strong(last, now, std::memory_order_relaxed);
+    }
+
+    std::pair<ProblemOverride, int> problemFromEntries(const std::vector<std::string>& entries)
+    {
+        // hipblaslt-bench tuning file columns; optional performance columns may precede the
+        // trailing solution_index,archName,cuNum.
         const size_t entries_n = entries.size();
-        if(entries_n != 37)
+        if(entries_n < 37)
         {
             return std::make_pair(ProblemOverride{}, -1);
         }
 
-        //Expected format: transA,transB,batch_count,M,N,K,input_type,output_type,compute_type,solution_index
         bool transA = (entries[0] != "N");
         bool transB = (entries[1] != "N");
 
-        size_t   m, n, b, k;
-        DataType inputType   = DataType::None;
-        DataType outputType  = DataType::None;
-        DataType computeType = DataType::None;
+        size_t         m, n, b, k, lda, ldb, ldc, ldd;
+        int            scaleA, scaleB;
+        bool           bias;
+        DataType       inputType   = DataType::None;
+        DataType       inputTypeB  = DataType::None;
+        DataType       outputType  = DataType::None;
+        DataType       outputTypeD = DataType::None;
+        DataType       computeType = DataType::None;
+        ActivationType activation  = ActivationType::Count;
 
         int solution_idx = -1;
 
         try
         {
-
-            // TODO: are any additional mapping parameters needed?
-
             b            = std::stol(entries[3]);
             m            = std::stol(entries[4]);
             n            = std::stol(entries[5]);
             k            = std::stol(entries[6]);
-            inputType    = hipDataType_to_tensile_type(string_to_hip_datatype(entries[17]));
-            outputType   = hipDataType_to_tensile_type(string_to_hip_datatype(entries[19]));
-            computeType  = hipDataType_to_tensile_type(string_to_hip_datatype(entries[21]));
-            solution_idx = std::stoi(entries[34]);
+            lda          = std::stol(entries[8]);
+            ldb          = std::stol(entries[11]);
+            ldc          = std::stol(entries[13]);
+            ldd          = std::stol(entries[15]);
+            inputType    = entry_to_tensile_type(entries[17]);
+            inputTypeB   = entry_to_tensile_type(entries[18]);
+            outputType   = entry_to_tensile_type(entries[19]);
+            outputTypeD  = entry_to_tensile_type(entries[20]);
+            computeType  = entry_to_tensile_type(entries[21]);
+            scaleA       = std::stoi(entries[22]);
+            scaleB       = std::stoi(entries[23]);
+            activation   = entry_to_activation(entries[27]);
+            bias         = entries[28] == "1" || entries[28] == "true";
+            solution_idx = std::stoi(entries[entries_n - 3]);
         }
         catch(std::invalid_argument const& ex)
         {
@@ -103,13 +409,33 @@ namespace TensileLite
             return std::make_pair(ProblemOverride{}, -1);
         }
 
-        if(inputType == DataType::None || outputType == DataType::None
-           || computeType == DataType::None)
+        if(inputType == DataType::None || inputTypeB == DataType::None
+           || outputType == DataType::None || outputTypeD == DataType::None
+           || computeType == DataType::None || activation == ActivationType::Count)
         {
             return std::make_pair(ProblemOverride{}, -1);
         }
 
-        ProblemOverride po(transA, transB, inputType, computeType, outputType, m, n, k, b);
+        int scaleABMode = (scaleA == 0 && scaleB == 0) ? 0 : (scaleA == 2 || scaleB == 2 ? 2 : 1);
+
+        ProblemOverride po(transA,
+                           transB,
+                           inputType,
+                           inputTypeB,
+                           computeType,
+                           outputType,
+                           outputTypeD,
+                           m,
+                           n,
+                           k,
+                           b,
+                           lda,
+                           ldb,
+                           ldc,
+                           ldd,
+                           activation,
+                           bias,
+                           scaleABMode);
 
         return std::make_pair(po, solution_idx);
     }
@@ -118,48 +444,61 @@ namespace TensileLite
         : m_transA(false)
         , m_transB(false)
         , m_inputType(DataType::None)
+        , m_inputTypeB(DataType::None)
         , m_computeType(DataType::None)
         , m_outputType(DataType::None)
+        , m_outputTypeD(DataType::None)
         , m_m(0)
         , m_n(0)
         , m_k(0)
         , m_batchSize(0)
+        , m_lda(0)
+        , m_ldb(0)
+        , m_ldc(0)
+        , m_ldd(0)
+        , m_activation(ActivationType::None)
+        , m_bias(false)
+        , m_scaleABMode(0)
     {
     }
 
-    ProblemOverride::ProblemOverride(bool     transA,
-                                     bool     transB,
-                                     DataType inputType,
-                                     DataType computeType,
-                                     DataType outputType,
-                                     size_t   m,
-                                     size_t   n,
-                                     size_t   k,
-                                     size_t   batchSize)
+    ProblemOverride::ProblemOverride(bool           transA,
+                                     bool           transB,
+                                     DataType       inputType,
+                                     DataType       inputTypeB,
+                                     DataType       computeType,
+                                     DataType       outputType,
+                                     DataType       outputTypeD,
+                                     size_t         m,
+                                     size_t         n,
+                                     size_t         k,
+                                     size_t         batchSize,
+                                     size_t         lda,
+                                     size_t         ldb,
+                                     size_t         ldc,
+                                     size_t         ldd,
+                                     ActivationType activation,
+                                     bool           bias,
+                                     int            scaleABMode)
         : m_transA(transA)
         , m_transB(transB)
         , m_inputType(inputType)
+        , m_inputTypeB(inputTypeB)
         , m_computeType(computeType)
         , m_outputType(outputType)
+        , m_outputTypeD(outputTypeD)
         , m_m(m)
         , m_n(n)
         , m_k(k)
         , m_batchSize(batchSize)
+        , m_lda(lda)
+        , m_ldb(ldb)
+        , m_ldc(ldc)
+        , m_ldd(ldd)
+        , m_activation(activation)
+        , m_bias(bias)
+        , m_scaleABMode(scaleABMode)
     {
     }
 
-    ProblemOverride::ProblemOverride(const ProblemOverride& problem)
-    {
-
-        m_transA      = problem.transA();
-        m_transB      = problem.transB();
-        m_inputType   = problem.inputType();
-        m_computeType = problem.computeType();
-        m_outputType  = problem.outputType();
-        m_m           = problem.m();
-        m_n           = problem.n();
-        m_k           = problem.k();
-        m_batchSize   = problem.batchSize();
-    }
-
 };
@@ -25,9 +25,11 @@
  * ************************************************************************ */
 
 #include "handle.h"
+#include "Debug.hpp"
 #include "definitions.h"
 #include "logging.h"
 
+#include <algorithm>
 #include <hip/hip_runtime.h>
 
 /*******************************************************************************
@@ -48,6 +50,16 @@ _rocblaslt_handle::_rocblaslt_handle()
 #else
     asic_rev = 0;
 #endif
+
+    // HIPBLASLT_STREAMK_AVAILABLE_CUS only seeds the CUs of new handles
+    auto& debug               = rocblaslt::Debug::Instance();
+    int   cus                 = debug.streamKAvailableCUs();
+    available_cus_from_stream = debug.streamKStreamCUMask();
+    if(cus < 0)
+        cus = std::max(properties.multiProcessorCount + cus, 1);
+    available_cus = cus < properties.multiProcessorCount ? cus : 0;
+
+    deterministic = debug.deterministic();
 }
 
 /*******************************************************************************
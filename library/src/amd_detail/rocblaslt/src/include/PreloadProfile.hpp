@@ -0,0 +1,42 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*! \brief Solution indices selected by an earlier run, for the kernel preloader.
+ *
+ * HIPBLASLT_PRELOAD_PROFILE names one of the files the library already writes:
+ * a binary shape trace (HIPBLASLT_TRACE_FILE), a tuning store
+ * (HIPBLASLT_TUNING_STORE_FILE) or a log holding bench lines
+ * (HIPBLASLT_LOG_MASK=32). The format is detected from the contents. Tuning store
+ * entries for other architectures than arch are skipped.
+ *
+ * Indices are returned once each, most frequently used first, so the kernels that
+ * matter most are resolved first. An unreadable file gives an empty profile.
+ */
+std::vector<int> readPreloadProfile(const std::string& path, const std::string& arch);
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include "auxiliary.hpp"
+#include "tensile_host.hpp"
+#include <Tensile/Comparison.hpp>
+#include <atomic>
+#include <shared_mutex>
+
+#include <string>
+#include <unordered_map>
+
+enum TunedProblemFlags : uint32_t
+{
+    TUNED_SCALE_A         = 1 << 0,
+    TUNED_SCALE_B         = 1 << 1,
+    TUNED_SCALE_A_VEC     = 1 << 2,
+    TUNED_SCALE_B_VEC     = 1 << 3,
+    TUNED_SCALE_ALPHA_VEC = 1 << 4,
+    TUNED_GRADIENT        = 1 << 5,
+};
+
+// Everything that selects a different solution for a gemm. Scale pointers only
+// contribute whether they are set, so buffers can move between calls.
+struct TunedProblemKey
+{
+    std::string            arch;
+    hipblasOperation_t     trans_a;
+    hipblasOperation_t     trans_b;
+    hipDataType            a_type;
+    hipDataType            b_type;
+    hipDataType            c_type;
+    hipDataType            d_type;
+    hipDataType            bias_type;
+    rocblaslt_compute_type compute_type;
+    rocblaslt_epilogue     epilogue;
+    int64_t                m;
+    int64_t                n;
+    int64_t                k;
+    int64_t                batch_count;
+    int64_t                lda;
+    int64_t                ldb;
+    int64_t                ldc;
+    int64_t                ldd;
+    int64_t                stride_a;
+    int64_t                stride_b;
+    int64_t                stride_c;
+    int64_t                stride_d;
+    uint32_t               flags; // TunedProblemFlags
+
+    bool operator==(const TunedProblemKey& rhs) const;
+};
+
+TunedProblemKey RocblasltContractionProblem2TunedKey(const RocblasltContractionProblem& problem,
+                                                     const hipDeviceProp_t&             prop);
+
+namespace std
+{
+    template <>
+    struct hash<TunedProblemKey>
+    {
+        size_t operator()(TunedProblemKey const& key) const;
+    };
+} // namespace std
+
+struct TunedSolution
+{
+    int    solution_index;
+    double time_us;
+};
+
+/*! \brief Solutions selected by rocblaslt_matmul_autotune, consulted by
+ * rocblaslt_matmul_algo_get_heuristic before the Tensile heuristic.
+ *
+ * When HIPBLASLT_TUNING_STORE_FILE is set the table is loaded from that file at
+ * startup and written back at exit or when save() is called with its path. Writers
+ * of that file take a lock on "<file>.lock" and merge the entries other processes
+ * wrote meanwhile. Solution indices are only valid for the library build that
+ * produced them, so a file with a different version is ignored. Entries are keyed
+ * by architecture and entries for other architectures are kept.
+ */
+class TunedSolutionStore
+{
+public:
+    static TunedSolutionStore& getInstance()
+    {
+        static TunedSolutionStore gInstance;
+        return gInstance;
+    }
+
+    // copy contructor
+    TunedSolutionStore(const TunedSolutionStore&) = delete;
+    // assignment operator
+    TunedSolutionStore& operator=(const TunedSolutionStore&) = delete;
+
+    bool empty() const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        return m_table.empty();
+    }
+
+    bool find(const TunedProblemKey& key, TunedSolution& solution) const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        auto                                      iter = m_table.find(key);
+        if(iter == m_table.end())
+            return false;
+        solution = iter->second;
+        return true;
+    }
+
+    // Adds or replaces the entry, the store file is written at exit
+    void add(const TunedProblemKey& key, const TunedSolution& solution);
+
+    void erase(const TunedProblemKey& key)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+        m_table.erase(key);
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+        m_table.clear();
+    }
+
+    // Merges the entries of a store file, returns false if the file cannot be read or
+    // was written by a different library version
+    bool load(const std::string& path);
+
+    // Writes all entries to path through a temporary file, so readers never see a
+    // partial store. Saving to the store file merges the entries already in it.
+    bool save(const std::string& path) const;
+
+private:
+    TunedSolutionStore();
+    ~TunedSolutionStore();
+
+    std::unordered_map<TunedProblemKey, TunedSolution> m_table;
+    std::string                                        m_file_path;
+    mutable std::shared_timed_mutex                    m_mutex;
+    mutable std::mutex                                 m_file_mutex;
+    mutable std::atomic<bool>                          m_dirty{false};
+};
@@ -2,11 +2,16 @@
 
 #include "auxiliary.hpp"
 #include "tensile_host.hpp"
+#include <Tensile/Activation.hpp>
 #include <Tensile/DataTypes.hpp>
 #include <shared_mutex>
 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class OverrideSingleton
@@ -14,6 +19,9 @@ class OverrideSingleton
 public:
     std::string file_path;
     bool        env_mode = false;
+    // Interval in milliseconds between checks of the override file for changes; 0 disables
+    // hot reload.
+    int reload_interval_ms = 0;
 
     static OverrideSingleton& getInstance()
     {
@@ -35,6 +43,10 @@ private:
             file_path = Env;
             env_mode  = true;
         }
+
+        char* reloadEnv = getenv("HIPBLASLT_TUNING_OVERRIDE_RELOAD_MS");
+        if(reloadEnv)
+            reload_interval_ms = std::max(0, atoi(reloadEnv));
     }
 
     ~OverrideSingleton() {}
@@ -47,16 +59,25 @@ namespace TensileLite
     {
     public:
         ProblemOverride();
-        ProblemOverride(bool     transA,
-                        bool     transB,
-                        DataType inputType,
-                        DataType computeType,
-                        DataType outputType,
-                        size_t   m,
-                        size_t   n,
-                        size_t   k,
-                        size_t   batchSize);
-        ProblemOverride(const ProblemOverride& problem);
+        ProblemOverride(bool           transA,
+                        bool           transB,
+                        DataType       inputType,
+                        DataType       inputTypeB,
+                        DataType       computeType,
+                        DataType       outputType,
+                        DataType       outputTypeD,
+                        size_t         m,
+                        size_t         n,
+                        size_t         k,
+                        size_t         batchSize,
+                        size_t         lda,
+                        size_t         ldb,
+                        size_t         ldc,
+                        size_t         ldd,
+                        ActivationType activation,
+                        bool           bias,
+                        int            scaleABMode);
+        ProblemOverride(const ProblemOverride& problem) = default;
 
         inline bool transA() const
         {
@@ -70,6 +91,10 @@ namespace TensileLite
         {
             return m_inputType;
         }
+        inline DataType inputTypeB() const
+        {
+            return m_inputTypeB;
+        }
         inline DataType computeType() const
         {
             return m_computeType;
@@ -78,6 +103,10 @@ namespace TensileLite
         {
             return m_outputType;
         }
+        inline DataType outputTypeD() const
+        {
+            return m_outputTypeD;
+        }
         inline size_t m() const
         {
             return m_m;
@@ -94,22 +123,72 @@ namespace TensileLite
         {
             return m_batchSize;
         }
+        inline size_t lda() const
+        {
+            return m_lda;
+        }
+        inline size_t ldb() const
+        {
+            return m_ldb;
+        }
+        inline size_t ldc() const
+        {
+            return m_ldc;
+        }
+        inline size_t ldd() const
+        {
+            return m_ldd;
+        }
+        inline ActivationType activation() const
+        {
+            return m_activation;
+        }
+        inline bool bias() const
+        {
+            return m_bias;
+        }
+        // 0: no scaleA/scaleB, 1: scalar, 2: vector
+        inline int scaleABMode() const
+        {
+            return m_scaleABMode;
+        }
 
     private:
-        bool     m_transA;
-        bool     m_transB;
-        DataType m_inputType;
-        DataType m_computeType;
-        DataType m_outputType;
-        size_t   m_m;
-        size_t   m_n;
-        size_t   m_k;
-        size_t   m_batchSize;
+        bool           m_transA;
+        bool           m_transB;
+        DataType       m_inputType;
+        DataType       m_inputTypeB;
+        DataType       m_computeType;
+        DataType       m_outputType;
+        DataType       m_outputTypeD;
+        size_t         m_m;
+        size_t         m_n;
+        size_t         m_k;
+        size_t         m_batchSize;
+        size_t         m_lda;
+        size_t         m_ldb;
+        size_t         m_ldc;
+        size_t         m_ldd;
+        ActivationType m_activation;
+        bool           m_bias;
+        int            m_scaleABMode;
     };
 
+    // Solution indices per problem, in file order; the last one has the highest priority.
+    using OverrideTable = std::unordered_map<ProblemOverride, std::vector<int>>;
+
     std::pair<ProblemOverride, int> problemFromEntries(const std::vector<std::string>& entries);
 
-    void getContractionProblemsFromFile(const std::string& path);
+    // Returns the override table of path, loading it on first use and reloading it when the
+    // file changed and hot reload is enabled. The returned table is never modified.
+    std::shared_ptr<const OverrideTable> getContractionProblemsFromFile(const std::string& path);
+
+    // Parses an override file, CSV or binary, into a new table. Returns nullptr if the file
+    // cannot be read or was written by a different library version.
+    std::shared_ptr<OverrideTable> readOverrideFile(const std::string& path);
+
+    // Writes table in the binary override format.
+    bool writeOverrideBinary(const OverrideTable& table, const std::string& path);
 
     template <>
     struct Comparison<ProblemOverride>
@@ -127,10 +206,14 @@ namespace TensileLite
                                         rhs.transB(),
                                         lhs.inputType(),
                                         rhs.inputType(),
+                                        lhs.inputTypeB(),
+                                        rhs.inputTypeB(),
                                         lhs.computeType(),
                                         rhs.computeType(),
                                         lhs.outputType(),
                                         rhs.outputType(),
+                                        lhs.outputTypeD(),
+                                        rhs.outputTypeD(),
                                         lhs.m(),
                                         rhs.m(),
                                         lhs.n(),
@@ -138,7 +221,21 @@ namespace TensileLite
                                         lhs.k(),
                                         rhs.k(),
                                         lhs.batchSize(),
-                                        rhs.batchSize());
+                                        rhs.batchSize(),
+                                        lhs.lda(),
+                                        rhs.lda(),
+                                        lhs.ldb(),
+                                        rhs.ldb(),
+                                        lhs.ldc(),
+                                        rhs.ldc(),
+                                        lhs.ldd(),
+                                        rhs.ldd(),
+                                        lhs.activation(),
+                                        rhs.activation(),
+                                        lhs.bias(),
+                                        rhs.bias(),
+                                        lhs.scaleABMode(),
+                                        rhs.scaleABMode());
         }
     };
 
@@ -158,41 +255,21 @@ namespace TensileLite
         // assignment operator
         OverrideMap& operator=(const OverrideMap&) = delete;
 
-        int size()
-        {
-            std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
-            auto                                      size = m_override.size();
-            return size;
-        }
-
-        auto find(const ProblemOverride& prob_key)
-        {
-            std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
-            auto                                      iter = m_override.equal_range(prob_key);
-            return iter;
-        }
-
-        void add(const std::pair<ProblemOverride, int>& problemSolution)
-        {
-            std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
-            m_override.insert(problemSolution);
-        }
-
-        void erase(std::multimap<ProblemOverride, int>::iterator& sol_idx)
-        {
-            std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
-            m_override.erase(sol_idx);
-        }
-
-        std::mutex& getLock()
-        {
-            return m_guard;
-        }
+        // Readers keep the table they got alive; a reload publishes a new table and never
+        // touches the old one.
+        std::shared_ptr<const OverrideTable> table(const std::string& path, int reloadIntervalMs);
 
     private:
-        std::multimap<ProblemOverride, int> m_override;
-        std::mutex                          m_guard;
-        std::shared_timed_mutex             m_mutex;
+        bool reloadDue(int reloadIntervalMs);
+
+        std::shared_ptr<const OverrideTable> m_table;
+        std::shared_ptr<const std::string>   m_path; // file m_table was read for
+        std::mutex                           m_guard;
+        int64_t                              m_mtime       = -1;
+        int64_t                              m_fileSize    = -1;
+        int64_t                              m_binMtime    = -1;
+        int64_t                              m_binFileSize = -1;
+        std::atomic<int64_t>                 m_lastCheck{0};
     };
 } // namespace Tensile
 
@@ -206,12 +283,21 @@ namespace std
             return TensileLite::hash_combine(po.transA(),
                                              po.transB(),
                                              po.inputType(),
+                                             po.inputTypeB(),
                                              po.computeType(),
                                              po.outputType(),
+                                             po.outputTypeD(),
                                              po.m(),
                                              po.n(),
                                              po.k(),
-                                             po.batchSize());
+                                             po.batchSize(),
+                                             po.lda(),
+                                             po.ldb(),
+                                             po.ldc(),
+                                             po.ldd(),
+                                             po.activation(),
+                                             po.bias(),
+                                             po.scaleABMode());
         }
     };
 } // namespace std
@@ -95,6 +95,12 @@ struct _rocblaslt_handle
     void* Synchronizer = nullptr;
     // pointer mode ; default mode is host
     rocblaslt_pointer_mode pointer_mode = rocblaslt_pointer_mode_host;
+    // CUs the gemms on the handle may use, 0 for all CUs of the device
+    int available_cus = 0;
+    // size the stream-K grid of each launch for the CU mask of its stream
+    bool available_cus_from_stream = false;
+    // restrict the heuristic to solutions that reduce in a fixed order
+    bool deterministic = false;
 };
 
 /********************************************************************************
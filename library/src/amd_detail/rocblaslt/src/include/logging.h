@@ -29,28 +29,38 @@
 #ifndef LOGGING_H
 #define LOGGING_H
 
+#include "hipblaslt_trace.hpp"
 #include "tuple_helper.hpp"
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <pthread.h>
 #include <shared_mutex>
 #include <string>
 #include <sys/types.h>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unistd.h>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 /************************************************************************************
  * Profile kernel arguments
  ************************************************************************************/
+// Held by every write to the log stream
+std::mutex& get_logger_os_mutex();
+
 template <typename TUP>
 class argument_profile
 {
@@ -108,8 +118,10 @@ public:
     // Dump the current profile
     void dump() const
     {
-        // Acquire an exclusive lock to use map
+        // Acquire an exclusive lock to use map, and the stream, which the asynchronous log
+        // writer may still be writing to
         std::lock_guard<std::shared_timed_mutex> lock(mutex);
+        std::lock_guard<std::mutex>              os_lock(get_logger_os_mutex());
 
         // Clear the output buffer
         os->clear();
@@ -202,17 +214,272 @@ inline void open_log_stream(std::ostream** log_os,
     }
 }
 
+/************************************************************************************
+ * Asynchronous log writer
+ *
+ * Every logging thread owns a bounded single-producer/single-consumer ring of
+ * formatted records, so logging takes no lock and does no IO on the calling thread.
+ * A background thread drains all rings and writes the records in batches. When a
+ * ring is full the record is dropped and counted, and the total is reported when
+ * the writer is destroyed. A writer given a drop record function also writes a record
+ * in place of the records each ring dropped since its last one.
+ *
+ * Every write to the stream holds os_mutex, so records written synchronously while
+ * the writer is stopped do not interleave with its batches. try_push() only queues a
+ * record while the writer runs; otherwise the caller writes it with write().
+ *
+ * stop() drains every ring and joins the writer thread; start() resumes it. They are
+ * used around fork(), so that no record is pending while the process is copied, and
+ * on quick_exit(), which skips the static destructors.
+ ************************************************************************************/
+class log_async_writer
+{
+    struct ring
+    {
+        explicit ring(size_t capacity)
+            : slots(capacity)
+        {
+        }
+
+        std::vector<std::string> slots;
+        std::atomic<size_t>      head{0}; // next slot to fill, written by the producer only
+        std::atomic<size_t>      tail{0}; // next slot to drain, written by the writer only
+        std::atomic<uint64_t>    dropped{0};
+        uint64_t                 marked = 0; // dropped records written as a drop record
+    };
+
+    std::ostream*                        os;
+    std::mutex&                          os_mutex; // held by every write to os
+    std::shared_mutex                    push_access; // shared by producers, exclusive in stop()
+    size_t                               capacity;
+    const char*                          name; // reported with the number of dropped records
+    std::mutex                           rings_mutex; // taken when a thread logs for the first time
+    std::vector<std::shared_ptr<ring>>   rings;
+    std::atomic<bool>                    stopping{false};
+    std::atomic<bool>                    running{false};
+    uint64_t                             dropped = 0; // from rings of threads which have exited
+    std::thread                          writer;
+    std::function<std::string(uint64_t)> drop_record; // record standing for dropped records
+
+    ring& thread_ring()
+    {
+        // One ring per thread and writer, since the log and the trace have separate writers
+        thread_local std::vector<std::pair<const log_async_writer*, std::shared_ptr<ring>>> local;
+        for(auto& r : local)
+            if(r.first == this)
+                return *r.second;
+
+        auto r = std::make_shared<ring>(capacity);
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            rings.push_back(r);
+        }
+        local.emplace_back(this, r);
+        return *r;
+    }
+
+    // Move every pending record into batch, and forget rings of threads which have exited
+    void drain(std::string& batch)
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        for(auto it = rings.begin(); it != rings.end();)
+        {
+            // Checked before draining, so the last records of an exited thread are not lost
+            bool   exited = it->use_count() == 1;
+            ring&  r      = **it;
+            size_t tail   = r.tail.load(std::memory_order_relaxed);
+            size_t head = r.head.load(std::memory_order_acquire);
+            for(; tail != head; ++tail)
+            {
+                // clear() keeps the capacity, so a slot is only allocated once
+                batch += r.slots[tail % capacity];
+                r.slots[tail % capacity].clear();
+            }
+            r.tail.store(tail, std::memory_order_release);
+
+            // The drops happened after the drained records, when the ring was full
+            uint64_t ring_dropped = r.dropped.load(std::memory_order_relaxed);
+            if(drop_record && ring_dropped != r.marked)
+            {
+                batch += drop_record(ring_dropped - r.marked);
+                r.marked = ring_dropped;
+            }
+
+            if(exited)
+            {
+                dropped += r.dropped.load(std::memory_order_relaxed);
+                it = rings.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    // Queue a record in the ring of the calling thread, or count it as dropped if full
+    void push(const char* data, size_t size)
+    {
+        ring&  r    = thread_ring();
+        size_t head = r.head.load(std::memory_order_relaxed);
+        if(head - r.tail.load(std::memory_order_acquire) >= capacity)
+        {
+            r.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        r.slots[head % capacity].assign(data, size);
+        r.head.store(head + 1, std::memory_order_release);
+    }
+
+    void run()
+    {
+        std::string batch;
+        for(;;)
+        {
+            bool stop = stopping.load(std::memory_order_acquire);
+            drain(batch);
+            if(!batch.empty())
+            {
+                write(batch.data(), batch.size(), true);
+                batch.clear();
+            }
+            else if(stop)
+                break;
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+public:
+    log_async_writer(std::ostream*                        os,
+                     std::mutex&                          os_mutex,
+                     size_t                               capacity,
+                     const char*                          name,
+                     std::function<std::string(uint64_t)> drop_record = nullptr)
+        : os(os)
+        , os_mutex(os_mutex)
+        , capacity(capacity)
+        , name(name)
+        , drop_record(std::move(drop_record))
+    {
+        start();
+    }
+
+    log_async_writer(const log_async_writer&) = delete;
+    log_async_writer& operator=(const log_async_writer&) = delete;
+
+    // Queue a record if the writer is running; never blocks on IO. A record queued here
+    // is always written, since stop() waits for the producers before the last drain.
+    bool try_push(const std::string& record)
+    {
+        return try_push(record.data(), record.size());
+    }
+
+    bool try_push(const char* data, size_t size)
+    {
+        std::shared_lock<std::shared_mutex> lock(push_access);
+        if(!running.load(std::memory_order_relaxed))
+            return false;
+        push(data, size);
+        return true;
+    }
+
+    // Write a record to the stream on the calling thread
+    void write(const char* data, size_t size, bool flush)
+    {
+        std::lock_guard<std::mutex> lock(os_mutex);
+        os->write(data, size);
+        if(flush)
+            os->flush();
+    }
+
+    void start()
+    {
+        std::unique_lock<std::shared_mutex> lock(push_access);
+        if(running.load(std::memory_order_relaxed))
+            return;
+        stopping.store(false, std::memory_order_relaxed);
+        writer = std::thread(&log_async_writer::run, this);
+        running.store(true, std::memory_order_relaxed);
+    }
+
+    // Write every pending record and join the writer thread. Once no producer is inside
+    // try_push(), the writer drains the rings a last time before it exits.
+    void stop()
+    {
+        {
+            std::unique_lock<std::shared_mutex> lock(push_access);
+            if(!running.load(std::memory_order_relaxed))
+                return;
+            running.store(false, std::memory_order_relaxed);
+        }
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+
+    // Held from the fork() prepare handler to the parent and child handlers, so that no
+    // thread is registering a ring while the process is copied
+    void lock_rings()
+    {
+        rings_mutex.lock();
+    }
+
+    void unlock_rings()
+    {
+        rings_mutex.unlock();
+    }
+
+    // Drain the remaining records and report the records which were dropped
+    ~log_async_writer()
+    {
+        stop();
+
+        for(auto& r : rings)
+            dropped += r->dropped.load(std::memory_order_relaxed);
+        if(dropped)
+            std::cerr << "[HIPBLASLT] " << dropped << " " << name << " records dropped"
+                      << std::endl;
+    }
+};
+
 class LoggerSingleton
 {
 public:
     std::ostream*           log_os         = nullptr;
     uint32_t                env_layer_mode = 0;
+
+    // Held by every write to log_os and to the trace file
+    std::mutex log_os_mutex;
+    std::mutex trace_os_mutex;
+
+    // Set if HIPBLASLT_LOG_ASYNC=1, otherwise records are written under a lock
+    std::unique_ptr<log_async_writer> async_writer;
+
+    // Binary shape trace, set if HIPBLASLT_TRACE_FILE is set
+    std::unique_ptr<log_async_writer>     trace_writer;
+    std::chrono::steady_clock::time_point trace_start;
     static LoggerSingleton& getInstance()
     {
         static LoggerSingleton gInstance;
         return gInstance;
     }
 
+    // Write out the pending records of the log and the trace. The log falls back to
+    // synchronous writes until start_async() is called.
+    void stop_async()
+    {
+        if(async_writer)
+            async_writer->stop();
+        if(trace_writer)
+            trace_writer->stop();
+    }
+
+    void start_async()
+    {
+        if(async_writer)
+            async_writer->start();
+        if(trace_writer)
+            trace_writer->start();
+    }
+
     // copy contructor
     LoggerSingleton(const LoggerSingleton&) = delete;
     // assignment operator
@@ -221,6 +488,7 @@ public:
 private:
     // logging streams
     std::ofstream log_file_ofs;
+    std::ofstream trace_file_ofs;
 
     LoggerSingleton()
     {
@@ -258,11 +526,100 @@ private:
         if(env_layer_mode != rocblaslt_layer_mode_none)
         {
             open_log_stream(&log_os, &log_file_ofs, "HIPBLASLT_LOG_FILE");
+
+            const char* async = getenv("HIPBLASLT_LOG_ASYNC");
+            if(async && atoi(async))
+            {
+                const char* depth    = getenv("HIPBLASLT_LOG_ASYNC_DEPTH");
+                size_t      capacity = depth ? strtoul(depth, nullptr, 0) : 0;
+                async_writer         = std::make_unique<log_async_writer>(
+                    log_os, log_os_mutex, capacity ? capacity : 4096, "log");
+            }
+        }
+
+        // Open shape trace
+        if(const char* trace_file = getenv("HIPBLASLT_TRACE_FILE"))
+        {
+            std::string trace_pathname = trace_file;
+            size_t      pos            = trace_pathname.find("%i");
+            if(pos != std::string::npos)
+                trace_pathname.replace(pos, 2, std::to_string(getpid()));
+            trace_file_ofs.open(trace_pathname, std::ios::binary);
+            if(trace_file_ofs.is_open())
+            {
+                hipblaslt_trace_header header{};
+                memcpy(header.magic, HIPBLASLT_TRACE_MAGIC, sizeof(HIPBLASLT_TRACE_MAGIC));
+                header.version       = HIPBLASLT_TRACE_VERSION;
+                header.record_size   = sizeof(hipblaslt_trace_record);
+                header.start_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::system_clock::now().time_since_epoch())
+                                           .count();
+                trace_start = std::chrono::steady_clock::now();
+                trace_file_ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                const char* depth    = getenv("HIPBLASLT_TRACE_DEPTH");
+                size_t      capacity = depth ? strtoul(depth, nullptr, 0) : 0;
+                trace_writer         = std::make_unique<log_async_writer>(
+                    &trace_file_ofs,
+                    trace_os_mutex,
+                    capacity ? capacity : 65536,
+                    "trace",
+                    [this](uint64_t count) { return trace_drop_record(count); });
+            }
+            else
+                std::cerr << "cannot open trace file: " << trace_pathname << std::endl;
+        }
+
+        if(async_writer || trace_writer)
+        {
+            // The destructor writes out the pending records at exit, and this handler on
+            // quick_exit(), which skips it. A forked child inherits the rings but not the
+            // writer threads. The singleton is never recreated, so register once.
+            at_quick_exit([] { getInstance().stop_async(); });
+            pthread_atfork(
+                [] {
+                    LoggerSingleton& s = getInstance();
+                    s.stop_async();
+                    if(s.async_writer)
+                        s.async_writer->lock_rings();
+                    if(s.trace_writer)
+                        s.trace_writer->lock_rings();
+                },
+                [] { getInstance().after_fork(true); },
+                [] { getInstance().after_fork(false); });
         }
     }
 
+    // The parent resumes its writer threads. The child writes synchronously, so that only
+    // the parent has a writer thread appending batches to the inherited files.
+    void after_fork(bool parent)
+    {
+        if(async_writer)
+            async_writer->unlock_rings();
+        if(trace_writer)
+            trace_writer->unlock_rings();
+        if(parent)
+            start_async();
+    }
+
+    // Trace record standing for count records the trace ring had no room for
+    std::string trace_drop_record(uint64_t count) const
+    {
+        hipblaslt_trace_record record{};
+        record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - trace_start)
+                                  .count();
+        record.m              = count;
+        record.solution_index = -1;
+        record.flags          = HIPBLASLT_TRACE_DROPPED;
+        return std::string(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+
     ~LoggerSingleton()
     {
+        trace_writer.reset();
+        if(trace_file_ofs.is_open())
+            trace_file_ofs.close();
+        async_writer.reset();
         if(log_file_ofs.is_open())
         {
             log_file_ofs.close();
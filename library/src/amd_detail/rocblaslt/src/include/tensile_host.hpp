@@ -46,6 +46,7 @@
 #include <Tensile/Contractions.hpp>
 #include <Tensile/DataTypes.hpp>
 #include <atomic>
+#include <functional>
 
 // Return the value category for a value, as a double precision value, such
 // such as whether it's 0, 1, -1 or some other value. Tensile uses a double
@@ -369,12 +370,23 @@ std::string getKernelNameFromAlgoIndex(rocblaslt_handle handle, const rocblaslt_
 std::string getSolutionNameFromAlgoIndex(rocblaslt_handle             handle,
                                          const rocblaslt_matmul_algo& algo);
 
+bool isDeterministicFromAlgoIndex(rocblaslt_handle             handle,
+                                  const rocblaslt_matmul_algo& algo,
+                                  uint16_t                     gsu);
+
 /***********************************************************************************
  * Whether Tensile has been initialized for at least one device (used for
  *testing) *
  ***********************************************************************************/
 std::atomic_bool& rocblaslt_internal_tensile_is_initialized();
 
+/***********************************************************************************
+ * Code object residency budget and counters of the adapter of the handle's device *
+ ***********************************************************************************/
+void setCodeObjectBudget(rocblaslt_handle handle, size_t bytes);
+
+rocblaslt::RocCodeObjectResidency getCodeObjectResidency(rocblaslt_handle handle);
+
 /**********************************************
  * Whether to suppress Tensile error messages *
  **********************************************/
@@ -394,6 +406,23 @@ rocblaslt_status getAllSolutions(std::vector<RocblasltContractionProblem>&
                                  std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults,
                                  size_t                                          maxWorkSpaceBytes);
 
+/*******************************************************************************
+ * Hands the solutions getAllSolutions would return to callback in batches,    *
+ * each sent as soon as it is evaluated. Only solutions whose predicates       *
+ * accept the problem are sent. Stops once callback returns false.             *
+ *******************************************************************************/
+rocblaslt_status streamAllSolutions(
+    RocblasltContractionProblem&                                   prob,
+    rocblaslt_handle                                               handle,
+    size_t                                                         maxWorkSpaceBytes,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback);
+
+rocblaslt_status streamAllSolutions(
+    std::vector<RocblasltContractionProblem>&                      probs,
+    rocblaslt_handle                                               handle,
+    size_t                                                         maxWorkSpaceBytes,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback);
+
 rocblaslt_status getAllSolutions(std::shared_ptr<void>                           gemmData,
                                  rocblaslt_handle                                handle,
                                  rocblaslt::RocGemmType                          gemmType,
@@ -33,12 +33,10 @@
 #include "logging.h"
 #include <algorithm>
 #include <exception>
-#include <mutex>
+#include <sstream>
 
 #pragma STDC CX_LIMITED_RANGE ON
 
-static std::mutex log_mutex;
-
 inline bool isAligned(const void* pointer, size_t byte_count)
 {
     return reinterpret_cast<uintptr_t>(pointer) % byte_count == 0;
@@ -196,19 +194,29 @@ static inline rocblaslt_int rocblaslt_clz(rocblaslt_int n)
 std::ostream* get_logger_os();
 uint32_t      get_logger_layer_mode();
 
+// Per-thread buffer which a log record is formatted into before it is submitted
+std::ostringstream& get_logger_buffer();
+
+// Hand a formatted record to the asynchronous writer, or write it under a lock
+void log_submit(std::ostringstream& record, bool flush = false);
+
+// Binary shape trace, see hipblaslt_trace.hpp. trace_submit sets the timestamp.
+bool get_trace_enabled();
+void trace_submit(hipblaslt_trace_record& record);
+
 template <typename H, typename... Ts>
 void log_base(rocblaslt_layer_mode layer_mode, const char* func, H head, Ts&&... xs)
 {
     if(get_logger_layer_mode() & layer_mode)
     {
-        std::lock_guard<std::mutex> lock(log_mutex);
         std::string comma_separator = " ";
 
-        std::ostream* os = get_logger_os();
+        std::ostringstream& os = get_logger_buffer();
 
         std::string prefix_str = prefix(rocblaslt_layer_mode2string(layer_mode), func);
 
-        log_arguments(*os, comma_separator, prefix_str, head, std::forward<Ts>(xs)...);
+        log_arguments(os, comma_separator, prefix_str, head, std::forward<Ts>(xs)...);
+        log_submit(os);
     }
 }
 
@@ -270,11 +278,11 @@ void log_api(const char* func, H head, Ts&&... xs)
 template <typename... Ts>
 void log_bench(const char* func, Ts&&... xs)
 {
-    std::lock_guard<std::mutex> lock(log_mutex);
-    std::ostream* os = get_logger_os();
-    *os << "hipblaslt-bench ";
-    log_arguments_bench(*os, std::forward<Ts>(xs)...);
-    *os << std::endl;
+    std::ostringstream& os = get_logger_buffer();
+    os << "hipblaslt-bench ";
+    log_arguments_bench(os, std::forward<Ts>(xs)...);
+    os << "\n";
+    log_submit(os, true);
 }
 
 // if profile logging is turned on with
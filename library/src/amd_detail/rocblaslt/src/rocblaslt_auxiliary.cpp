@@ -24,11 +24,13 @@
  *
  * ************************************************************************ */
 
+#include "TunedSolutionStore.hpp"
 #include "UserDrivenTuningParser.hpp"
 #include "definitions.h"
 #include "handle.h"
 #include "rocblaslt.h"
 #include "rocblaslt_mat_utils.hpp"
+#include "status.h"
 #include "tensile_host.hpp"
 #include "utility.hpp"
 
@@ -36,8 +38,14 @@
 #include <link.h>
 #endif
 
+#include <Tensile/Metrics.hpp>
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <hip/hip_runtime_api.h>
+#include <iostream>
 #include <map>
+#include <sstream>
 #include <unistd.h>
 #include <utility>
 
@@ -118,11 +126,10 @@ bool problem_override_from_file(rocblaslt_handle&                 handle,
                                 const std::string&                file_path)
 {
 
-    bool success = false;
-    TensileLite::getContractionProblemsFromFile(file_path);
-    TensileLite::OverrideMap& m_override = TensileLite::OverrideMap::getMap();
+    bool success   = false;
+    auto m_override = TensileLite::getContractionProblemsFromFile(file_path);
 
-    if(m_override.size() == 0)
+    if(m_override->empty())
     {
         log_info(__func__, "No valid entries found in override file.");
     }
@@ -131,13 +138,13 @@ bool problem_override_from_file(rocblaslt_handle&                 handle,
         std::vector<rocblaslt_matmul_heuristic_result> overrideResults;
         std::vector<int>                               solutionIndex(1);
         TensileLite::ProblemOverride prob_key(RocblasltContractionProblem2ProblemOverride(problem));
-        auto                         sol_iter = m_override.find(prob_key);
+        auto                         sol_iter = m_override->find(prob_key);
+        std::vector<int>             noSolutions;
+        auto const& candidates = sol_iter == m_override->end() ? noSolutions : sol_iter->second;
 
-        for(auto sol_idx = std::make_reverse_iterator(sol_iter.second);
-            !success && sol_idx != std::make_reverse_iterator(sol_iter.first);
-            sol_idx++)
+        for(auto sol_idx = candidates.rbegin(); !success && sol_idx != candidates.rend(); sol_idx++)
         {
-            solutionIndex[0] = sol_idx->second;
+            solutionIndex[0] = *sol_idx;
 
             if(rocblaslt_status_success
                == getSolutionsFromIndex(
@@ -179,6 +186,44 @@ bool problem_override_from_file(rocblaslt_handle&                 handle,
     return success;
 }
 
+// Use the solution selected by rocblaslt_matmul_autotune for this problem, if any
+bool problem_override_from_store(rocblaslt_handle&                 handle,
+                                 rocblaslt_matmul_preference&      pref,
+                                 RocblasltContractionProblem&      problem,
+                                 rocblaslt_matmul_desc&            matmul_desc,
+                                 rocblaslt_matmul_heuristic_result heuristicResultsArray[])
+{
+    TunedSolutionStore& store = TunedSolutionStore::getInstance();
+    TunedSolution       tuned;
+    if(store.empty()
+       || !store.find(RocblasltContractionProblem2TunedKey(problem, handle->properties), tuned))
+        return false;
+
+    std::vector<rocblaslt_matmul_heuristic_result> tunedResults;
+    std::vector<int>                               solutionIndex(1, tuned.solution_index);
+    size_t                                         required_workspace_size = 0;
+    if(rocblaslt_status_success
+           != getSolutionsFromIndex(handle, solutionIndex, tunedResults, pref->max_workspace_bytes)
+       || tunedResults.empty()
+       || rocblaslt_status_success
+              != isSolutionSupported(handle,
+                                     problem,
+                                     matmul_desc->m_data,
+                                     &tunedResults[0].algo,
+                                     &required_workspace_size))
+    {
+        log_info(__func__, "Tuned solution index is not valid for this problem", solutionIndex[0]);
+        return false;
+    }
+
+    heuristicResult_copy(&heuristicResultsArray[0],
+                         &tunedResults[0],
+                         pref->max_workspace_bytes,
+                         required_workspace_size);
+    log_info(__func__, "Find tuned solution with index:", solutionIndex[0]);
+    return true;
+}
+
 bool problem_override_from_file_cpp(
     rocblaslt_handle&                               handle,
     rocblaslt::RocGemmType&                         gemmType,
@@ -188,11 +233,10 @@ bool problem_override_from_file_cpp(
     const std::string&                              file_path)
 {
 
-    bool success = false;
-    TensileLite::getContractionProblemsFromFile(file_path);
-    TensileLite::OverrideMap& m_override = TensileLite::OverrideMap::getMap();
+    bool success   = false;
+    auto m_override = TensileLite::getContractionProblemsFromFile(file_path);
 
-    if(m_override.size() == 0)
+    if(m_override->empty())
     {
         log_info(__func__, "No valid entries found in override file.");
     }
@@ -201,13 +245,13 @@ bool problem_override_from_file_cpp(
         std::vector<rocblaslt_matmul_heuristic_result> overrideResults;
         std::vector<int>                               solutionIndex(1);
         TensileLite::ProblemOverride prob_key(TensileDataGemm2ProblemOverride(gemmData));
-        auto                         sol_iter = m_override.find(prob_key);
+        auto                         sol_iter = m_override->find(prob_key);
+        std::vector<int>             noSolutions;
+        auto const& candidates = sol_iter == m_override->end() ? noSolutions : sol_iter->second;
 
-        for(auto sol_idx = std::make_reverse_iterator(sol_iter.second);
-            !success && sol_idx != std::make_reverse_iterator(sol_iter.first);
-            sol_idx++)
+        for(auto sol_idx = candidates.rbegin(); !success && sol_idx != candidates.rend(); sol_idx++)
         {
-            solutionIndex[0]        = sol_idx->second;
+            solutionIndex[0]        = *sol_idx;
             size_t maxWorkspaceSize = std::numeric_limits<size_t>::max();
             if(rocblaslt_status_success
                == getSolutionsFromIndex(handle, solutionIndex, overrideResults, maxWorkspaceSize))
@@ -1535,39 +1579,54 @@ rocblaslt_status
             handle, matmul_desc, matA, matB, matC, matD, &alpha, &beta, pref->max_workspace_bytes);
 
         OverrideSingleton& override         = OverrideSingleton::getInstance();
-        bool               override_success = false;
-        if(override.env_mode)
+        bool               override_success = problem_override_from_store(
+            handle, pref, prob, matmul_desc, heuristicResultsArray);
+        if(!override_success && override.env_mode)
         {
             override_success = problem_override_from_file(
                 handle, pref, prob, matmul_desc, heuristicResultsArray, override.file_path);
-            if(override_success)
-                requestedAlgoCount--;
 
             log_api(__func__, "returnAlogCount", override_success ? 1 : 0);
         }
+        if(override_success)
+        {
+            requestedAlgoCount--;
+            *returnAlgoCount = 0;
+        }
 
-        if(requestedAlgoCount > 0)
+        if(requestedAlgoCount > 0 && !override_success)
         {
             status = getBestSolutions(prob,
                                       handle,
                                       tensile_data,
                                       requestedAlgoCount,
-                                      override_success ? &heuristicResultsArray[1]
-                                                       : heuristicResultsArray,
+                                      heuristicResultsArray,
                                       returnAlgoCount,
                                       pref->max_workspace_bytes);
         }
-
-        if(override_success)
+        else if(requestedAlgoCount > 0)
         {
-
-            int oriReturnAlgoCount = *returnAlgoCount;
-            if(!heuristicResult_check_duplicated(
-                   &heuristicResultsArray[1], &heuristicResultsArray[0], oriReturnAlgoCount, true))
+            // The heuristic may return the tuned or overriding solution too: ask for one more
+            // and skip it, so it is listed once and the remaining slots are still filled.
+            std::vector<rocblaslt_matmul_heuristic_result> heuristic(requestedAlgoCount + 1);
+            int                                            heuristicCount = 0;
+            status = getBestSolutions(prob,
+                                      handle,
+                                      tensile_data,
+                                      requestedAlgoCount + 1,
+                                      heuristic.data(),
+                                      &heuristicCount,
+                                      pref->max_workspace_bytes);
+            for(int i = 0; i < heuristicCount && *returnAlgoCount < requestedAlgoCount; i++)
             {
-                (*returnAlgoCount)++;
+                if(*(int*)heuristic[i].algo.data != *(int*)heuristicResultsArray[0].algo.data)
+                    heuristicResultsArray[1 + (*returnAlgoCount)++] = heuristic[i];
             }
+        }
 
+        if(override_success)
+        {
+            (*returnAlgoCount)++;
             requestedAlgoCount++;
         }
 
@@ -1653,17 +1712,24 @@ void rocblaslt_init_gemmData(rocblaslt_handle       handle,
                         gemmData);
 }
 
-rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
-    rocblaslt_handle                                handle,
-    rocblaslt::RocGemmType                          typeGemm,
-    hipblasOperation_t                              opA,
-    hipblasOperation_t                              opB,
-    hipDataType                                     typeA,
-    hipDataType                                     typeB,
-    hipDataType                                     typeC,
-    hipDataType                                     typeD,
-    rocblaslt_compute_type                          typeCompute,
-    std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults)
+// The solution search only matches the gemm type, so the sizes merely shape the workspace and
+// roofline estimates of the returned candidates. With a callback the candidates are streamed to
+// it instead of returned, and only those whose predicates accept the m x n x k problem are sent.
+static rocblaslt_status getAllAlgosForSize(
+    rocblaslt_handle                                               handle,
+    rocblaslt::RocGemmType                                         typeGemm,
+    hipblasOperation_t                                             opA,
+    hipblasOperation_t                                             opB,
+    hipDataType                                                    typeA,
+    hipDataType                                                    typeB,
+    hipDataType                                                    typeC,
+    hipDataType                                                    typeD,
+    rocblaslt_compute_type                                         typeCompute,
+    int64_t                                                        m,
+    int64_t                                                        n,
+    int64_t                                                        k,
+    std::vector<rocblaslt_matmul_heuristic_result>&                heuristicResults,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>* callback = nullptr)
 {
     // Check if handle is valid
     if(handle == nullptr)
@@ -1671,11 +1737,16 @@ rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
         log_error(__func__, "invalid pointer");
         return rocblaslt_status_invalid_handle;
     }
+    if(m <= 0 || n <= 0 || k <= 0)
+    {
+        log_error(__func__, "invalid problem size", m, n, k);
+        return rocblaslt_status_invalid_size;
+    }
     // Create dummy
-    auto initMat = [](_rocblaslt_matrix_layout& mat, hipDataType type) {
-        mat.m    = 1;
-        mat.n    = 1;
-        mat.ld   = 1;
+    auto initMat = [](_rocblaslt_matrix_layout& mat, hipDataType type, int64_t rows, int64_t cols) {
+        mat.m    = rows;
+        mat.n    = cols;
+        mat.ld   = rows;
         mat.type = type;
     };
     _rocblaslt_matmul_desc   matmul_desc;
@@ -1683,10 +1754,10 @@ rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
     _rocblaslt_matrix_layout matB;
     _rocblaslt_matrix_layout matC;
     _rocblaslt_matrix_layout matD;
-    initMat(matA, typeA);
-    initMat(matB, typeB);
-    initMat(matC, typeC);
-    initMat(matD, typeD);
+    initMat(matA, typeA, opA == HIPBLAS_OP_N ? m : k, opA == HIPBLAS_OP_N ? k : m);
+    initMat(matB, typeB, opB == HIPBLAS_OP_N ? k : n, opB == HIPBLAS_OP_N ? n : k);
+    initMat(matC, typeC, m, n);
+    initMat(matD, typeD, m, n);
     matmul_desc.op_A                  = opA;
     matmul_desc.op_B                  = opB;
     matmul_desc.compute_type          = typeCompute;
@@ -1703,12 +1774,18 @@ rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
             handle, &matmul_desc, &matA, &matB, &matC, &matD, &alpha, &beta, maxWorkspaceSize);
         if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
         {
-            status = getAllSolutions(prob, handle, heuristicResults, maxWorkspaceSize);
+            if(callback)
+                status = streamAllSolutions(prob, handle, maxWorkspaceSize, *callback);
+            else
+                status = getAllSolutions(prob, handle, heuristicResults, maxWorkspaceSize);
         }
         else if(typeGemm == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
         {
             std::vector<RocblasltContractionProblem> probs = {prob};
-            status = getAllSolutions(probs, handle, heuristicResults, maxWorkspaceSize);
+            if(callback)
+                status = streamAllSolutions(probs, handle, maxWorkspaceSize, *callback);
+            else
+                status = getAllSolutions(probs, handle, heuristicResults, maxWorkspaceSize);
         }
         else
         {
@@ -1728,6 +1805,71 @@ rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
     return rocblaslt_status_success;
 }
 
+rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
+    rocblaslt_handle                                handle,
+    rocblaslt::RocGemmType                          typeGemm,
+    hipblasOperation_t                              opA,
+    hipblasOperation_t                              opB,
+    hipDataType                                     typeA,
+    hipDataType                                     typeB,
+    hipDataType                                     typeC,
+    hipDataType                                     typeD,
+    rocblaslt_compute_type                          typeCompute,
+    std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults)
+{
+    return getAllAlgosForSize(handle,
+                              typeGemm,
+                              opA,
+                              opB,
+                              typeA,
+                              typeB,
+                              typeC,
+                              typeD,
+                              typeCompute,
+                              1,
+                              1,
+                              1,
+                              heuristicResults);
+}
+
+rocblaslt_status rocblaslt_matmul_get_all_algos_cpp(
+    rocblaslt_handle                                               handle,
+    rocblaslt::RocGemmType                                         typeGemm,
+    hipblasOperation_t                                             opA,
+    hipblasOperation_t                                             opB,
+    hipDataType                                                    typeA,
+    hipDataType                                                    typeB,
+    hipDataType                                                    typeC,
+    hipDataType                                                    typeD,
+    rocblaslt_compute_type                                         typeCompute,
+    int64_t                                                        m,
+    int64_t                                                        n,
+    int64_t                                                        k,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback)
+{
+    if(!callback)
+    {
+        log_error(__func__, "invalid callback");
+        return rocblaslt_status_invalid_pointer;
+    }
+
+    std::vector<rocblaslt_matmul_heuristic_result> unused;
+    return getAllAlgosForSize(handle,
+                              typeGemm,
+                              opA,
+                              opB,
+                              typeA,
+                              typeB,
+                              typeC,
+                              typeD,
+                              typeCompute,
+                              m,
+                              n,
+                              k,
+                              unused,
+                              &callback);
+}
+
 rocblaslt_status rocblaslt_matmul_get_algos_from_index_cpp(
     rocblaslt_handle                                handle,
     std::vector<int>&                               solutionIndex,
@@ -1983,3 +2125,424 @@ extern "C" int rocblaslt_matmul_is_tuned(rocblaslt_handle        handle,
 
     return 0;
 }
+
+namespace
+{
+    size_t layout_bytes(rocblaslt_matrix_layout mat)
+    {
+        size_t elementSize
+            = TensileLite::DataTypeInfo::Get(hipDataType_to_tensile_type(mat->type)).elementSize;
+        size_t matrix = mat->order == HIPBLASLT_ORDER_COL ? mat->ld * mat->n : mat->ld * mat->m;
+        size_t batches = mat->batch_count > 1 ? mat->batch_stride * (mat->batch_count - 1) : 0;
+        return (matrix + batches) * elementSize;
+    }
+
+    // Device memory and events of an autotune call, released on every exit path
+    struct AutotuneResources
+    {
+        std::vector<void*> ptrs;
+        hipEvent_t         start = nullptr;
+        hipEvent_t         stop  = nullptr;
+
+        void* alloc(size_t bytes)
+        {
+            void* ptr = nullptr;
+            THROW_IF_HIP_ERROR(hipMalloc(&ptr, bytes));
+            ptrs.push_back(ptr);
+            return ptr;
+        }
+
+        ~AutotuneResources()
+        {
+            for(auto ptr : ptrs)
+                static_cast<void>(hipFree(ptr));
+            if(start)
+                static_cast<void>(hipEventDestroy(start));
+            if(stop)
+                static_cast<void>(hipEventDestroy(stop));
+        }
+    };
+}
+
+extern "C" rocblaslt_status
+    rocblaslt_matmul_autotune(rocblaslt_handle                   handle,
+                              rocblaslt_matmul_desc              matmul_desc,
+                              const void*                        alpha,
+                              const void*                        A,
+                              rocblaslt_matrix_layout            matA,
+                              const void*                        B,
+                              rocblaslt_matrix_layout            matB,
+                              const void*                        beta,
+                              const void*                        C,
+                              rocblaslt_matrix_layout            matC,
+                              void*                              D,
+                              rocblaslt_matrix_layout            matD,
+                              rocblaslt_matmul_preference        pref,
+                              int                                candidateCount,
+                              int                                iterations,
+                              size_t                             rotatingBytes,
+                              rocblaslt_matmul_heuristic_result* result,
+                              hipStream_t                        stream)
+{
+    if(handle == nullptr || matmul_desc == nullptr || pref == nullptr || matA == nullptr
+       || matB == nullptr || matC == nullptr || matD == nullptr)
+    {
+        log_error(__func__, "invalid handle pointer");
+        return rocblaslt_status_invalid_handle;
+    }
+
+    if(alpha == nullptr || beta == nullptr || A == nullptr || B == nullptr || D == nullptr
+       || result == nullptr)
+    {
+        log_error(__func__, "invalid data pointer");
+        return rocblaslt_status_invalid_pointer;
+    }
+
+    if(candidateCount < 1 || iterations < 1)
+    {
+        log_error(__func__, "invalid candidate or iteration count", candidateCount, iterations);
+        return rocblaslt_status_invalid_value;
+    }
+
+    try
+    {
+        std::vector<rocblaslt_matmul_heuristic_result> candidates(candidateCount);
+        int                                            returnedAlgoCount = 0;
+        rocblaslt_status status = rocblaslt_matmul_algo_get_heuristic(handle,
+                                                                      matmul_desc,
+                                                                      matA,
+                                                                      matB,
+                                                                      matC,
+                                                                      matD,
+                                                                      pref,
+                                                                      candidateCount,
+                                                                      candidates.data(),
+                                                                      &returnedAlgoCount);
+        if(status != rocblaslt_status_success)
+            throw status;
+        if(returnedAlgoCount == 0)
+        {
+            log_info(__func__, "no solution found");
+            throw rocblaslt_status_invalid_value;
+        }
+        candidates.resize(returnedAlgoCount);
+
+        AutotuneResources resources;
+        size_t            workspaceSize = 0;
+        for(auto& candidate : candidates)
+            workspaceSize = std::max(workspaceSize, candidate.workspaceSize);
+        void* workspace = workspaceSize ? resources.alloc(workspaceSize) : nullptr;
+
+        // Copy 0 is the caller's buffers. The other copies make the timed calls read A, B
+        // and C from memory instead of the cache, like a real workload does.
+        bool   inPlace   = C == D;
+        size_t sizeA     = layout_bytes(matA);
+        size_t sizeB     = layout_bytes(matB);
+        size_t sizeC     = C && !inPlace ? layout_bytes(matC) : 0;
+        size_t sizeD     = layout_bytes(matD);
+        size_t copyBytes = sizeA + sizeB + sizeC + sizeD;
+        int    copies    = std::max<size_t>(
+            1,
+            std::min<size_t>(iterations,
+                             (rotatingBytes + copyBytes - 1) / std::max<size_t>(copyBytes, 1)));
+
+        std::vector<const void*> a(copies, A), b(copies, B), c(copies, C);
+        std::vector<void*>       d(copies, D);
+        for(int i = 1; i < copies; i++)
+        {
+            void* dA = resources.alloc(sizeA);
+            void* dB = resources.alloc(sizeB);
+            THROW_IF_HIP_ERROR(hipMemcpyAsync(dA, A, sizeA, hipMemcpyDeviceToDevice, stream));
+            THROW_IF_HIP_ERROR(hipMemcpyAsync(dB, B, sizeB, hipMemcpyDeviceToDevice, stream));
+            a[i] = dA;
+            b[i] = dB;
+            d[i] = resources.alloc(sizeD);
+            if(inPlace)
+            {
+                THROW_IF_HIP_ERROR(
+                    hipMemcpyAsync(d[i], D, sizeD, hipMemcpyDeviceToDevice, stream));
+                c[i] = d[i];
+            }
+            else if(C)
+            {
+                void* dC = resources.alloc(sizeC);
+                THROW_IF_HIP_ERROR(hipMemcpyAsync(dC, C, sizeC, hipMemcpyDeviceToDevice, stream));
+                c[i] = dC;
+            }
+        }
+
+        THROW_IF_HIP_ERROR(hipEventCreate(&resources.start));
+        THROW_IF_HIP_ERROR(hipEventCreate(&resources.stop));
+
+        int   best   = -1;
+        float bestMs = std::numeric_limits<float>::max();
+        for(int s = 0; s < returnedAlgoCount; s++)
+        {
+            auto run = [&](int i) {
+                return rocblaslt_matmul(handle,
+                                        matmul_desc,
+                                        alpha,
+                                        a[i],
+                                        matA,
+                                        b[i],
+                                        matB,
+                                        beta,
+                                        c[i],
+                                        matC,
+                                        d[i],
+                                        matD,
+                                        &candidates[s].algo,
+                                        workspace,
+                                        workspaceSize,
+                                        stream);
+            };
+
+            // Warm up, a candidate that cannot run is skipped
+            if(run(0) != rocblaslt_status_success)
+                continue;
+
+            // A launch failing part way through leaves the timing meaningless, drop the candidate
+            rocblaslt_status runStatus = rocblaslt_status_success;
+            THROW_IF_HIP_ERROR(hipEventRecord(resources.start, stream));
+            for(int i = 0; i < iterations && runStatus == rocblaslt_status_success; i++)
+                runStatus = run(i % copies);
+            THROW_IF_HIP_ERROR(hipEventRecord(resources.stop, stream));
+            THROW_IF_HIP_ERROR(hipEventSynchronize(resources.stop));
+            if(runStatus != rocblaslt_status_success)
+            {
+                log_info(__func__,
+                         "solution index",
+                         *(int*)candidates[s].algo.data,
+                         "failed while timed, status",
+                         runStatus);
+                continue;
+            }
+
+            float ms = 0;
+            THROW_IF_HIP_ERROR(hipEventElapsedTime(&ms, resources.start, resources.stop));
+            log_info(__func__,
+                     "solution index",
+                     *(int*)candidates[s].algo.data,
+                     "us",
+                     ms * 1000 / iterations);
+            if(ms < bestMs)
+            {
+                best   = s;
+                bestMs = ms;
+            }
+        }
+
+        if(best < 0)
+        {
+            log_info(__func__, "no candidate could run");
+            throw rocblaslt_status_invalid_value;
+        }
+
+        *result = candidates[best];
+
+        auto prob = construct_rocblaslt_problem(handle,
+                                                matmul_desc,
+                                                matA,
+                                                matB,
+                                                matC,
+                                                matD,
+                                                alpha,
+                                                beta,
+                                                pref->max_workspace_bytes);
+        TunedSolutionStore::getInstance().add(
+            RocblasltContractionProblem2TunedKey(prob, handle->properties),
+            {*(int*)result->algo.data, bestMs * 1000.0 / iterations});
+    }
+    catch(const rocblaslt_status& status)
+    {
+        return status;
+    }
+    return rocblaslt_status_success;
+}
+
+extern "C" rocblaslt_status rocblaslt_tuned_solutions_save(const char* path)
+{
+    if(path == nullptr)
+        return rocblaslt_status_invalid_pointer;
+    return TunedSolutionStore::getInstance().save(path) ? rocblaslt_status_success
+                                                        : rocblaslt_status_internal_error;
+}
+
+extern "C" rocblaslt_status rocblaslt_tuned_solutions_load(const char* path)
+{
+    if(path == nullptr)
+        return rocblaslt_status_invalid_pointer;
+    return TunedSolutionStore::getInstance().load(path) ? rocblaslt_status_success
+                                                        : rocblaslt_status_invalid_value;
+}
+
+extern "C" void rocblaslt_tuned_solutions_clear()
+{
+    TunedSolutionStore::getInstance().clear();
+}
+
+extern "C" rocblaslt_status rocblaslt_tuning_override_convert(const char* src, const char* dst)
+{
+    if(src == nullptr || dst == nullptr)
+        return rocblaslt_status_invalid_pointer;
+    auto table = TensileLite::readOverrideFile(src);
+    if(!table)
+        return rocblaslt_status_invalid_value;
+    return TensileLite::writeOverrideBinary(*table, dst) ? rocblaslt_status_success
+                                                         : rocblaslt_status_internal_error;
+}
+
+extern "C" rocblaslt_status rocblaslt_tuning_override_lookup(const char* path,
+                                                             const char* row,
+                                                             int         reload_interval_ms,
+                                                             int*        solution_index)
+{
+    if(path == nullptr || row == nullptr || solution_index == nullptr)
+        return rocblaslt_status_invalid_pointer;
+
+    std::vector<std::string> entries;
+    std::stringstream        row_ss(row);
+    std::string              entry;
+    while(getline(row_ss, entry, ','))
+        entries.push_back(entry);
+    auto problem = TensileLite::problemFromEntries(entries);
+    if(problem.second < 0)
+    {
+        log_error(__func__, "invalid tuning row", row);
+        return rocblaslt_status_invalid_value;
+    }
+
+    // Kept apart from the table of HIPBLASLT_TUNING_OVERRIDE_FILE, which has its own path
+    static TensileLite::OverrideMap lookupMap;
+    auto                            table = lookupMap.table(path, reload_interval_ms);
+    auto                            it    = table->find(problem.first);
+
+    *solution_index = it == table->end() || it->second.empty() ? -1 : it->second.back();
+    return rocblaslt_status_success;
+}
+
+extern "C" void rocblaslt_metrics_enable(int enable)
+{
+    TensileLite::Metrics::Instance().setEnabled(enable != 0);
+}
+
+extern "C" void rocblaslt_metrics_reset()
+{
+    TensileLite::Metrics::Instance().reset();
+}
+
+extern "C" rocblaslt_status rocblaslt_metrics_dump(const char* path)
+{
+    if(path == nullptr)
+    {
+        TensileLite::Metrics::Instance().dump(std::cout);
+        return rocblaslt_status_success;
+    }
+    std::ofstream file(path);
+    if(!file)
+    {
+        log_error(__func__, "cannot open", path);
+        return rocblaslt_status_internal_error;
+    }
+    TensileLite::Metrics::Instance().dump(file);
+    return rocblaslt_status_success;
+}
+
+extern "C" rocblaslt_status rocblaslt_set_code_object_budget(rocblaslt_handle handle, size_t bytes)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "handle", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    log_api(__func__, "handle", handle, "bytes", bytes);
+    setCodeObjectBudget(handle, bytes);
+    return rocblaslt_status_success;
+}
+
+extern "C" rocblaslt_status rocblaslt_set_available_cus(rocblaslt_handle handle, int cus)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "handle", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    if(cus < 0)
+    {
+        log_error(__func__, "invalid CU count", cus);
+        return rocblaslt_status_invalid_value;
+    }
+    log_api(__func__, "handle", handle, "cus", cus);
+    int cuCount                       = handle->properties.multiProcessorCount;
+    handle->available_cus             = cus < cuCount ? cus : 0;
+    handle->available_cus_from_stream = false;
+    return rocblaslt_status_success;
+}
+
+extern "C" rocblaslt_status rocblaslt_set_available_cus_from_stream(rocblaslt_handle handle,
+                                                                    hipStream_t      stream)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "handle", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    int                   cuCount = handle->properties.multiProcessorCount;
+    std::vector<uint32_t> mask((cuCount + 31) / 32);
+
+    hipError_t err = hipExtStreamGetCUMask(stream, mask.size(), mask.data());
+    if(err != hipSuccess)
+    {
+        log_error(__func__, "cannot read the CU mask of stream", stream, hipGetErrorString(err));
+        return rocblaslt_status_internal_error;
+    }
+    int cus = 0;
+    for(auto bits : mask)
+        cus += __builtin_popcount(bits);
+    log_api(__func__, "handle", handle, "stream", stream, "cus", cus);
+    handle->available_cus             = cus < cuCount ? cus : 0;
+    handle->available_cus_from_stream = false;
+    return rocblaslt_status_success;
+}
+
+extern "C" rocblaslt_status rocblaslt_set_deterministic(rocblaslt_handle handle, int deterministic)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "handle", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    log_api(__func__, "handle", handle, "deterministic", deterministic);
+    handle->deterministic = deterministic != 0;
+    return rocblaslt_status_success;
+}
+
+rocblaslt_status rocblaslt_get_code_object_residency(rocblaslt_handle                   handle,
+                                                     rocblaslt::RocCodeObjectResidency& stats)
+{
+    if(handle == nullptr)
+    {
+        log_error(__func__, "handle", handle);
+        return rocblaslt_status_invalid_handle;
+    }
+    stats = getCodeObjectResidency(handle);
+    return rocblaslt_status_success;
+}
+
+std::vector<rocblaslt::RocMetric> rocblaslt_metrics_get()
+{
+    std::vector<rocblaslt::RocMetric> metrics;
+    for(auto const& s : TensileLite::Metrics::Instance().snapshot())
+    {
+        rocblaslt::RocMetric m;
+        m.name     = s.name;
+        m.timed    = s.timed;
+        m.count    = s.count;
+        m.total_ns = s.totalNs;
+        m.max_ns   = s.maxNs;
+        if(s.timed)
+            m.histogram.assign(s.histogram.begin(), s.histogram.end());
+        metrics.push_back(m);
+    }
+    return metrics;
+}
@@ -1679,3 +1679,10 @@ std::string rocblaslt_get_solution_name_from_algo(rocblaslt_handle             h
 {
     return getSolutionNameFromAlgoIndex(handle, algo);
 }
+
+bool rocblaslt_is_algo_deterministic(rocblaslt_handle             handle,
+                                     const rocblaslt_matmul_algo& algo,
+                                     uint16_t                     gsu)
+{
+    return isDeterministicFromAlgoIndex(handle, algo, gsu);
+}
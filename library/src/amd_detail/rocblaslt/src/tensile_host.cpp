@@ -34,6 +34,7 @@
  *****************************************************************************/
 
 #include "Debug.hpp"
+#include "PreloadProfile.hpp"
 #include "rocblaslt-types.h"
 #include "rocblaslt_mat_utils.hpp"
 #include "tensile_host.hpp"
@@ -42,6 +43,7 @@
 #include <Tensile/Contractions.hpp>
 #include <Tensile/EmbeddedLibrary.hpp>
 #include <Tensile/MasterSolutionLibrary.hpp>
+#include <Tensile/Metrics.hpp>
 #include <Tensile/PlaceholderLibrary.hpp>
 #include <Tensile/Tensile.hpp>
 #include <Tensile/TensorDescriptor.hpp>
@@ -50,11 +52,18 @@
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
 #include <atomic>
+#include <chrono>
 #include <complex>
+#include <condition_variable>
+#include <deque>
 #include <exception>
+#include <functional>
 #include <iomanip>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -65,6 +74,7 @@
 #include <link.h>
 #include <regex>
 #include <string_view>
+#include <thread>
 #include <unistd.h>
 
 #define HIPBLASLT_LIB_PATH "/opt/rocm/lib"
@@ -666,6 +676,123 @@ namespace
                     tensileActivationtType_to_bench_string(problem.getParams().activationEnum()));
     }
 
+    hipblasComputeType_t tensileComputeType_to_hipblas(TensileLite::DataType typeCompute,
+                                                       TensileLite::DataType F32XdlMathOp,
+                                                       TensileLite::DataType typeComputeInput,
+                                                       TensileLite::DataType typeA,
+                                                       TensileLite::DataType typeB)
+    {
+        switch(typeCompute)
+        {
+        case TensileLite::DataType::Double:
+            return HIPBLAS_COMPUTE_64F;
+        case TensileLite::DataType::Int32:
+            return HIPBLAS_COMPUTE_32I;
+        default:
+            break;
+        }
+
+        if(F32XdlMathOp == TensileLite::DataType::XFloat32)
+            return HIPBLAS_COMPUTE_32F_FAST_TF32;
+        else if(typeComputeInput == TensileLite::DataType::BFloat16
+                && typeA == TensileLite::DataType::Half && typeB == TensileLite::DataType::Half)
+            return HIPBLAS_COMPUTE_32F_FAST_16BF;
+        else if(typeComputeInput == TensileLite::DataType::Half
+                && (typeA == TensileLite::DataType::Float8 && typeB == TensileLite::DataType::Half
+                    || typeA == TensileLite::DataType::Half
+                           && typeB == TensileLite::DataType::Float8))
+            return HIPBLAS_COMPUTE_32F_FAST_16F;
+        return HIPBLAS_COMPUTE_32F;
+    }
+
+    inline void traceFromTensileDataGemm(const TensileLite::ContractionProblemGemm& problem,
+                                         const TensileLite::ContractionInputs&      inputs,
+                                         int                                        solutionIndex,
+                                         bool                                       isCpp,
+                                         hipStream_t                                stream,
+                                         uint32_t                                   groupIndex = 0,
+                                         uint32_t                                   groupCount = 1)
+    {
+        const auto& e = problem.tensor(TensileLite::ContractionProblemGemm::TENSOR::E);
+
+        hipblaslt_trace_record r{};
+        r.stream       = reinterpret_cast<uintptr_t>(stream);
+        r.m            = problem.c().sizes()[0];
+        r.n            = problem.c().sizes()[1];
+        r.k            = problem.a().sizes()[problem.boundIndices()[0].a];
+        r.batch_count  = problem.batchSize(0);
+        r.lda          = problem.a().strides()[1];
+        r.ldb          = problem.b().strides()[1];
+        r.ldc          = problem.c().strides()[1];
+        r.ldd          = problem.d().strides()[1];
+        r.lde          = e.strides().size() ? e.strides()[1] : 0;
+        r.stride_a     = problem.a().strides()[2];
+        r.stride_b     = problem.b().strides()[2];
+        r.stride_c     = problem.c().strides()[2];
+        r.stride_d     = problem.d().strides()[2];
+        r.stride_e     = e.strides().size() ? e.strides()[2] : 0;
+        r.alpha        = TensileLite::constVariantCast<double>(inputs.alpha);
+        r.beta         = TensileLite::constVariantCast<double>(inputs.beta);
+        r.a_type       = tensile2HipType(problem.a().dataType());
+        r.b_type       = tensile2HipType(problem.b().dataType());
+        r.c_type       = tensile2HipType(problem.c().dataType());
+        r.d_type       = tensile2HipType(problem.d().dataType());
+        r.scale_type   = tensile2HipType(problem.alphaType());
+        r.bias_type    = tensile2HipType(problem.bias().dataType());
+        r.compute_type = tensileComputeType_to_hipblas(problem.computeType(),
+                                                       problem.f32XdlMathOp(),
+                                                       problem.computeInputType(),
+                                                       problem.a().dataType(),
+                                                       problem.b().dataType());
+        r.bias_source  = problem.useBias() ? problem.biasSrc() : 0;
+        r.scale_a = r.scale_b
+            = problem.useScaleAB().empty() ? 0 : (problem.useScaleAB() == "Vector" ? 2 : 1);
+        r.solution_index = solutionIndex;
+        r.splitk         = problem.getParams().gsu();
+        r.wgm            = problem.getParams().wgm();
+        r.group_index    = groupIndex;
+        r.group_count    = groupCount;
+
+        switch(problem.getParams().activationEnum())
+        {
+        case TensileLite::ActivationType::Relu:
+            r.activation = HIPBLASLT_TRACE_ACTIVATION_RELU;
+            break;
+        case TensileLite::ActivationType::Gelu:
+            r.activation = HIPBLASLT_TRACE_ACTIVATION_GELU;
+            break;
+        case TensileLite::ActivationType::DGelu:
+            r.activation = HIPBLASLT_TRACE_ACTIVATION_DGELU;
+            break;
+        default:
+            r.activation = HIPBLASLT_TRACE_ACTIVATION_NONE;
+            break;
+        }
+
+        r.flags = (problem.transA() ? HIPBLASLT_TRACE_TRANS_A : 0)
+                  | (problem.transB() ? HIPBLASLT_TRACE_TRANS_B : 0)
+                  | (problem.useScaleCD() ? HIPBLASLT_TRACE_SCALE_CD : 0)
+                  | (problem.useScaleAlphaVec() ? HIPBLASLT_TRACE_SCALE_ALPHA_VEC : 0)
+                  | (problem.useGradient() ? HIPBLASLT_TRACE_GRADIENT : 0)
+                  | (problem.useE() ? HIPBLASLT_TRACE_USE_E : 0)
+                  | (problem.useBias() ? HIPBLASLT_TRACE_BIAS : 0)
+                  | (isCpp ? HIPBLASLT_TRACE_CPP_API : 0);
+
+        trace_submit(r);
+    }
+
+    inline void traceFromTensileDataGemm(const TensileLite::ContractionProblemGroupedGemm& problem,
+                                         const TensileLite::ContractionGroupedInputs&      inputs,
+                                         int         solutionIndex,
+                                         bool        isCpp,
+                                         hipStream_t stream)
+    {
+        uint32_t gemmCount = problem.gemms.size();
+        for(uint32_t i = 0; i < gemmCount; ++i)
+            traceFromTensileDataGemm(
+                problem.gemms[i], inputs.grouped[i], solutionIndex, isCpp, stream, i, gemmCount);
+    }
+
     inline void
         logBenchFromTensileDataGemm(const TensileLite::ContractionProblemGroupedGemm& problem,
                                     const TensileLite::ContractionGroupedInputs&      inputs,
@@ -898,6 +1025,8 @@ namespace
  ****************************************************************/
     auto ConstructTensileProblem(const RocblasltContractionProblem& prob)
     {
+        TensileLite::ScopedMetricTimer timer(TensileLite::MetricTimer::ProblemConstruction);
+
         auto a_type       = hipDataType_to_tensile_type(prob.a_type);
         auto b_type       = hipDataType_to_tensile_type(prob.b_type);
         auto c_type       = hipDataType_to_tensile_type(prob.c_type);
@@ -1106,6 +1235,8 @@ namespace
     void updateTensileProblem(const RocblasltContractionProblem&   prob,
                               TensileLite::ContractionProblemGemm& tensileProblem)
     {
+        TensileLite::ScopedMetricTimer timer(TensileLite::MetricTimer::ProblemConstruction);
+
         auto a_type       = hipDataType_to_tensile_type(prob.a_type);
         auto b_type       = hipDataType_to_tensile_type(prob.b_type);
         auto c_type       = hipDataType_to_tensile_type(prob.c_type);
@@ -1431,6 +1562,170 @@ namespace
         return TensileLite::LazyLoadingInit::None;
     }
 
+    // Profile preloads that have not finished yet
+    std::atomic<int> g_pendingPreloads{0};
+
+    /*****************************************************************************
+     * Host latency of the first call of every solution while a preload profile *
+     * is set, from the entry of runContractionProblem, so the solution lookup  *
+     * is included, to the return of the launch. Calls made while the preload   *
+     * is still running are reported apart from the calls made after it        *
+     *****************************************************************************/
+    class FirstCallLatency
+    {
+    public:
+        void setProfiled(int32_t deviceId, std::vector<int> const& indices)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            for(int index : indices)
+                m_profiled.emplace(deviceId, index);
+        }
+
+        bool seen(int32_t deviceId, int index) const
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            return m_calls.count({deviceId, index}) != 0;
+        }
+
+        void record(int32_t deviceId, int index, double us, bool duringPreload)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            m_calls.emplace(std::make_pair(deviceId, index), Call{us, duringPreload});
+        }
+
+        // Writes a record built here rather than with log_info, since the summary at exit
+        // is written after the thread local log buffers are gone
+        void logSummary(const char* when) const
+        {
+            if(!(get_logger_layer_mode() & rocblaslt_layer_mode_log_info))
+                return;
+
+            struct Stats
+            {
+                size_t count = 0;
+                double total = 0;
+                double max   = 0;
+            } during, after, unprofiled;
+
+            std::ostringstream record;
+            std::string        prefix_str = prefix(
+                rocblaslt_layer_mode2string(rocblaslt_layer_mode_log_info), "preload profile");
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                if(m_calls.empty())
+                    return;
+                for(auto const& [key, call] : m_calls)
+                {
+                    const char* name  = "not in the profile";
+                    Stats*      stats = &unprofiled;
+                    if(m_profiled.count(key))
+                    {
+                        name  = call.duringPreload ? "during the preload" : "after the preload";
+                        stats = call.duringPreload ? &during : &after;
+                    }
+                    stats->count++;
+                    stats->total += call.us;
+                    stats->max = std::max(stats->max, call.us);
+                    record << prefix_str << " device " << key.first << " solution " << key.second
+                           << " first call " << call.us << " us, " << name << "\n";
+                }
+            }
+
+            auto summary = [&](const char* name, Stats const& stats) {
+                record << ", " << stats.count << " " << name;
+                if(stats.count)
+                    record << " mean " << stats.total / stats.count << " us max " << stats.max
+                           << " us";
+            };
+            record << prefix_str << " first call latency " << when;
+            summary("during the preload", during);
+            summary("after the preload", after);
+            summary("not in the profile", unprofiled);
+            record << "\n";
+            log_submit(record, true);
+        }
+
+    private:
+        struct Call
+        {
+            double us;
+            bool   duringPreload;
+        };
+
+        mutable std::shared_mutex               m_mutex;
+        std::set<std::pair<int32_t, int>>       m_profiled;
+        std::map<std::pair<int32_t, int>, Call> m_calls;
+    };
+
+    // Outlives the TensileHost, which logs the summary again at exit
+    FirstCallLatency g_firstCallLatency;
+
+    /*************************************************************************
+     * Resolves the kernels of the solutions recorded in a preload profile, *
+     * so the first call of each profiled problem finds its code object and *
+     * kernel handle already loaded. Runs on a background thread per device *
+     *************************************************************************/
+    void preloadProfiledKernels(
+        TensileLite::hip::SolutionAdapter& adapter,
+        std::shared_ptr<TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>>
+                                 library,
+        int32_t                  deviceId,
+        std::string const&       profile,
+        std::atomic<bool> const& stop)
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        static_cast<void>(hipSetDevice(deviceId));
+        hipDeviceProp_t prop;
+        HIP_CHECK_EXC(hipGetDeviceProperties(&prop, deviceId));
+        auto        hardware = TensileLite::hip::GetDevice(prop);
+        std::string arch(prop.gcnArchName);
+        arch = arch.substr(0, arch.find(":"));
+
+        auto   indices  = readPreloadProfile(profile, arch);
+        size_t resolved = 0;
+        g_firstCallLatency.setProfiled(deviceId, indices);
+        for(int index : indices)
+        {
+            if(stop.load(std::memory_order_relaxed))
+                break;
+
+            auto solution = library->getSolutionByIndex(*hardware, index);
+            if(!solution)
+                continue;
+
+            auto codeObjectFile = solution->codeObjectFilename.load();
+            if(!codeObjectFile.empty())
+                adapter.FindCodeObject(codeObjectFile);
+            if(adapter.initKernel(solution->KernelName()) == hipSuccess)
+                resolved++;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+                                                              - start)
+                        .count();
+        log_info(__func__,
+                 "device",
+                 deviceId,
+                 "resolved",
+                 resolved,
+                 "of",
+                 indices.size(),
+                 "profiled solutions from",
+                 profile,
+                 "in",
+                 ms,
+                 "ms");
+        g_pendingPreloads--;
+        g_firstCallLatency.logSummary("at preload completion");
+    }
+    catch(const std::exception& e)
+    {
+        g_pendingPreloads--;
+        log_error(__func__, "kernel preload failed:", e.what());
+    }
+
     /**************************************************
  * The TensileHost struct interfaces with Tensile *
  **************************************************/
@@ -1453,11 +1748,15 @@ namespace
         {
             mutable std::atomic<TensileLite::hip::SolutionAdapter*> adapter{nullptr};
             mutable std::mutex                                      mutex;
+            mutable std::thread                                     preloader;
         };
 
         // Each device contains an adapter
         std::vector<adapter_s> const m_adapters;
 
+        // Tells profile preloaders to stop early when the host is destroyed
+        std::atomic<bool> m_stopPreload{false};
+
     public:
         TensileHost()
             : m_adapters(GetDeviceCount())
@@ -1487,8 +1786,15 @@ namespace
 
         ~TensileHost()
         {
+            m_stopPreload = true;
             for(auto& a : m_adapters)
+            {
+                if(a.preloader.joinable())
+                    a.preloader.join();
                 delete a.adapter;
+            }
+            if(!rocblaslt::Debug::Instance().preloadProfile().empty())
+                g_firstCallLatency.logSummary("at exit");
         }
 
         auto& get_library() const
@@ -1567,7 +1873,8 @@ namespace
             // only load modules for the current architecture
             auto dir = path + "/*" + processor + "*co";
 #if ROCBLASLT_TENSILE_LAZY_LOAD == 0
-            bool no_match = false;
+            bool                     no_match = false;
+            std::vector<std::string> codeObjectFiles;
 #ifdef WIN32
             std::replace(dir.begin(), dir.end(), '/', '\\');
             WIN32_FIND_DATAA finddata;
@@ -1576,8 +1883,7 @@ namespace
             {
                 do
                 {
-                    std::string codeObjectFile = path + "\\" + finddata.cFileName;
-                    static_cast<void>(adapter.loadCodeObjectFile(codeObjectFile.c_str()));
+                    codeObjectFiles.push_back(path + "\\" + finddata.cFileName);
                 } while(FindNextFileA(hfine, &finddata));
             }
             else
@@ -1591,7 +1897,7 @@ namespace
             if(!g)
             {
                 for(size_t i = 0; i < glob_result.gl_pathc; ++i)
-                    static_cast<void>(adapter.loadCodeObjectFile(glob_result.gl_pathv[i]));
+                    codeObjectFiles.push_back(glob_result.gl_pathv[i]);
             }
             else if(g == GLOB_NOMATCH)
             {
@@ -1612,6 +1918,10 @@ namespace
             }
             globfree(&glob_result);
 #endif
+            // Code objects are read and loaded concurrently, TENSILE_DB=0x20 prints the
+            // time spent on each one
+            static_cast<void>(adapter.loadCodeObjectFiles(codeObjectFiles));
+
             if(no_match)
             {
                 // static rocblaslt_internal_ostream& once
@@ -1693,6 +2003,24 @@ namespace
                         = TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>;
                     m_library        = std::dynamic_pointer_cast<MSL>(lib);
                     m_tensileLibPath = tensileLibPath;
+#if ROCBLASLT_TENSILE_LAZY_LOAD
+                    // Index lookups consult a directory of which placeholder library holds
+                    // each solution. It is read from next to the library, and otherwise built
+                    // once and cached per user, since the install tree is usually read-only.
+                    // HIPBLASLT_TENSILE_INDEX_DIRECTORY replaces both locations.
+                    const char* indexEnv = getenv("HIPBLASLT_TENSILE_INDEX_DIRECTORY");
+                    if(m_library && indexEnv)
+                    {
+                        m_library->indexDirectoryFile      = indexEnv;
+                        m_library->indexDirectoryCacheFile = indexEnv;
+                    }
+                    else if(m_library)
+                    {
+                        m_library->indexDirectoryFile = tensileLibPath + ".index";
+                        m_library->indexDirectoryCacheFile
+                            = TensileLite::SolutionIndexDirectory::UserCachePath(tensileLibPath);
+                    }
+#endif
                 }
                 return 0;
             }();
@@ -1706,18 +2034,25 @@ namespace
             }
         }
 
-#if ROCBLASLT_TENSILE_LAZY_LOAD
-        // A workaround for getSolutionsFromIndex and isSolutionSupported with lazy_lib_load.
-        // preload() shouldn't be called more than once.
-        void preload()
+        // Starts resolving the kernels of HIPBLASLT_PRELOAD_PROFILE for an adapter in the
+        // background. Callers that get there first simply load the kernel themselves.
+        void startPreload(adapter_s const&                   a,
+                          TensileLite::hip::SolutionAdapter& adapter,
+                          int32_t                            deviceId)
         {
-            auto lib = TensileLite::LoadLibraryFilePreload<TensileLite::ContractionProblemGemm>(
-                m_tensileLibPath,
-                std::vector<TensileLite::LazyLoadingInit>{m_deviceSet.begin(), m_deviceSet.end()});
-            using MSL = TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>;
-            m_library = std::dynamic_pointer_cast<MSL>(lib);
+            auto const& profile = rocblaslt::Debug::Instance().preloadProfile();
+            if(profile.empty() || !m_library)
+                return;
+
+            g_pendingPreloads++;
+            a.preloader = std::thread(preloadProfiledKernels,
+                                      std::ref(adapter),
+                                      m_library,
+                                      deviceId,
+                                      profile,
+                                      std::cref(m_stopPreload));
         }
-#endif
+
     };
 
     // Return the library and adapter for the current HIP device
@@ -1726,12 +2061,7 @@ namespace
             library
         = nullptr,
         std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1
-#if ROCBLASLT_TENSILE_LAZY_LOAD
-        ,
-        bool isPreload = false
-#endif
-    )
+        int                               device     = -1)
     try
     {
         // TensileHost is initialized on the first call
@@ -1758,22 +2088,13 @@ namespace
 
                 // Initialize the adapter and possibly the library
                 host.initialize(*adapter, device);
+                host.startPreload(a, *adapter, device);
 
                 // Atomically change the adapter stored for this device ID
                 a.adapter.store(adapter, std::memory_order_release);
             }
         }
 
-#if ROCBLASLT_TENSILE_LAZY_LOAD
-        // A workaround for getSolutionsFromIndex and isSolutionSupported when lazy_lib_load is on.
-        // preload() shouldn't be called more than once.
-        if(isPreload)
-            static int once = [&] {
-                host.preload();
-                *library = host.get_library();
-                return 0;
-            }();
-#endif
         // If an adapter is found, it is assumed that the library is initialized
         if(library)
             *library = host.get_library();
@@ -1821,6 +2142,258 @@ namespace
             std::cerr << msg << std::endl;
     }
 #endif
+
+    /**************************************************************************
+    * Dense matrix core flops per CU per clock for the math type of a problem.*
+    * The table is approximate; it only has to rank solutions and classify   *
+    * problems as compute or memory bound.                                   *
+    **************************************************************************/
+    double peakFlopsPerCuPerClock(const std::string& arch, TensileLite::DataType mathType)
+    {
+        bool gfx94x = arch.rfind("gfx94", 0) == 0;
+        bool gfx950 = arch.rfind("gfx950", 0) == 0;
+        bool gfx12  = arch.rfind("gfx12", 0) == 0;
+        bool wmma   = arch.rfind("gfx11", 0) == 0 || gfx12;
+
+        switch(mathType)
+        {
+        case TensileLite::DataType::Double:
+            return wmma ? 32 : gfx94x ? 256 : 128;
+        case TensileLite::DataType::Float:
+            return 256;
+        case TensileLite::DataType::XFloat32:
+            return gfx94x || gfx950 ? 1024 : 256;
+        case TensileLite::DataType::Half:
+        case TensileLite::DataType::BFloat16:
+            return gfx950 ? 4096 : gfx94x ? 2048 : wmma ? 512 : 1024;
+        case TensileLite::DataType::Float8:
+        case TensileLite::DataType::BFloat8:
+        case TensileLite::DataType::Float8BFloat8:
+        case TensileLite::DataType::BFloat8Float8:
+        case TensileLite::DataType::Int8:
+        case TensileLite::DataType::Int8x4:
+            return gfx950 ? 8192 : gfx94x ? 4096 : gfx12 ? 1024 : wmma ? 512 : 1024;
+        default:
+            return 256;
+        }
+    }
+
+    /**************************************************************************
+    * Fill predictedTimeUs, efficiency and boundType of a heuristic result   *
+    * from a roofline of the problem on the device. The compute roof is     *
+    * derated by the tile granularity of the solution, so solutions that     *
+    * waste work on partial tiles or idle CUs get a longer predicted time.   *
+    **************************************************************************/
+    void estimateRoofline(const TensileLite::ContractionSolution&   solution,
+                          const TensileLite::ContractionProblemGemm& problem,
+                          const TensileLite::Hardware&               hardware,
+                          rocblaslt_matmul_heuristic_result&         result)
+    {
+        auto gpu = dynamic_cast<const TensileLite::hip::HipAMDGPU*>(&hardware);
+        if(!gpu || gpu->properties.clockRate <= 0 || gpu->properties.memoryClockRate <= 0)
+            return;
+        const hipDeviceProp_t& prop = gpu->properties;
+
+        double M     = problem.freeSizeA(0);
+        double N     = problem.freeSizeB(0);
+        double K     = problem.boundSize(0);
+        double batch = 1;
+        for(size_t i = 0; i < problem.batchIndices().size(); i++)
+            batch *= problem.batchSize(i);
+        double flops = 2.0 * M * N * K * batch;
+        if(flops <= 0)
+            return;
+
+        auto   granularities = solution.computeGranularities(hardware, M, N, K, batch);
+        double granularity   = solution.isStreamK()
+                                   ? granularities.tile0Granularity * granularities.tile1Granularity
+                                   : granularities.totalGranularity;
+        if(!(granularity > 0.0) || granularity > 1.0)
+            granularity = 1.0;
+
+        TensileLite::DataType mathType = problem.computeInputType();
+        if(mathType == TensileLite::DataType::Float
+           && problem.f32XdlMathOp() == TensileLite::DataType::XFloat32)
+            mathType = TensileLite::DataType::XFloat32;
+
+        std::string arch      = prop.gcnArchName;
+        double      peakFlops = peakFlopsPerCuPerClock(arch, mathType) * prop.multiProcessorCount
+                           * prop.clockRate * 1e3;
+        // The HBM3 of gfx94x/gfx95x moves four transfers per reported memory clock
+        double transfers = arch.rfind("gfx94", 0) == 0 || arch.rfind("gfx95", 0) == 0 ? 4 : 2;
+        double peakBytes = prop.memoryClockRate * 1e3 * (prop.memoryBusWidth / 8.0) * transfers;
+
+        auto tensorBytes = [](const TensileLite::TensorDescriptor& t) {
+            return double(t.totalLogicalElements()) * TensileLite::GetElementSize(t.dataType());
+        };
+        double bytes = tensorBytes(problem.a()) + tensorBytes(problem.b())
+                       + tensorBytes(problem.d());
+        if(problem.beta() != 0.0)
+            bytes += tensorBytes(problem.c());
+
+        double computeUs = flops / (peakFlops * granularity) * 1e6;
+        double memoryUs  = bytes / peakBytes * 1e6;
+        double timeUs    = std::max(computeUs, memoryUs);
+
+        result.predictedTimeUs = static_cast<float>(timeUs);
+        result.efficiency      = static_cast<float>(flops / (timeUs * 1e-6) / peakFlops);
+        result.boundType       = computeUs >= memoryUs ? HIPBLASLT_BOUND_COMPUTE
+                                                       : HIPBLASLT_BOUND_MEMORY;
+    }
+
+    /**************************************************************************
+     * Host worker threads shared by every parallelForRange call. They are    *
+     * started on first use and sleep until work is submitted. A child        *
+     * process forked after that has no workers; parallelForRange still       *
+     * completes there because the caller runs every chunk nobody claimed.    *
+     **************************************************************************/
+    class HostWorkerPool
+    {
+    public:
+        static HostWorkerPool& instance()
+        {
+            static HostWorkerPool pool;
+            return pool;
+        }
+
+        size_t size() const
+        {
+            return m_workers.size();
+        }
+
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_ready.notify_one();
+        }
+
+        ~HostWorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_ready.notify_all();
+            for(auto& worker : m_workers)
+                worker.join();
+        }
+
+    private:
+        // A few thousand solutions do not keep more workers than this busy
+        static constexpr size_t maxWorkers = 15;
+
+        HostWorkerPool()
+        {
+            size_t workers = std::min<size_t>(
+                std::max(1u, std::thread::hardware_concurrency()) - 1, maxWorkers);
+            m_workers.reserve(workers);
+            for(size_t i = 0; i < workers; i++)
+                m_workers.emplace_back([this] { run(); });
+        }
+
+        void run()
+        {
+            while(true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_ready.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                    if(m_tasks.empty())
+                        return;
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex                        m_mutex;
+        std::condition_variable           m_ready;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::thread>          m_workers;
+        bool                              m_stop = false;
+    };
+
+    /**************************************************************************
+     * Split [0, count) into contiguous chunks and run body(begin, end) on    *
+     * each, spread over the calling thread and the HostWorkerPool. Ranges    *
+     * smaller than two chunks of minPerThread stay on the calling thread,    *
+     * where handing off would cost more than the work. The caller claims     *
+     * chunks like any worker, so it never waits for a chunk nobody started.  *
+     * The first exception thrown by any chunk is rethrown once all of them   *
+     * have finished.                                                         *
+     **************************************************************************/
+    template <typename Body>
+    void parallelForRange(size_t count, size_t minPerThread, Body&& body)
+    {
+        auto&  pool   = HostWorkerPool::instance();
+        size_t chunks = std::min<size_t>(pool.size() + 1,
+                                         count / std::max<size_t>(minPerThread, 1));
+        if(chunks <= 1)
+        {
+            body(size_t(0), count);
+            return;
+        }
+
+        struct Batch
+        {
+            std::atomic<size_t>     next{0};
+            size_t                  done = 0;
+            std::exception_ptr      error;
+            std::mutex              mutex;
+            std::condition_variable finished;
+        };
+        auto   batch = std::make_shared<Batch>();
+        size_t chunk = (count + chunks - 1) / chunks;
+
+        // Helpers that start after every chunk was claimed return without touching body
+        auto work = [batch, chunks, chunk, count, &body] {
+            for(size_t c = batch->next++; c < chunks; c = batch->next++)
+            {
+                std::exception_ptr error;
+                try
+                {
+                    body(std::min(count, c * chunk), std::min(count, (c + 1) * chunk));
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                if(error && !batch->error)
+                    batch->error = error;
+                if(++batch->done == chunks)
+                    batch->finished.notify_all();
+            }
+        };
+        for(size_t t = 1; t < chunks; t++)
+            pool.submit(work);
+        work();
+
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->finished.wait(lock, [&] { return batch->done == chunks; });
+        if(batch->error)
+            std::rethrow_exception(batch->error);
+    }
+
+    // CUs of the stream mask the stream-K grid of a gemm on stream is sized for, 0 to use
+    // the CUs of the handle. A fixed count is already in the hardware of the handle.
+    uint16_t streamKAvailableCUs(rocblaslt_handle handle, hipStream_t stream, int cuCount)
+    {
+        if(!handle->available_cus_from_stream)
+            return 0;
+        std::vector<uint32_t> mask((cuCount + 31) / 32);
+        if(hipExtStreamGetCUMask(stream, mask.size(), mask.data()) != hipSuccess)
+            return 0;
+        int cus = 0;
+        for(auto bits : mask)
+            cus += __builtin_popcount(bits);
+        return cus < cuCount ? cus : 0;
+    }
 } // namespace
 
 struct TensileDataGemm
@@ -1847,30 +2420,56 @@ struct TensileDataGroupedGemm
 TensileLite::ProblemOverride
     RocblasltContractionProblem2ProblemOverride(const RocblasltContractionProblem& problem)
 {
+    int scaleABMode = (problem.scaleA == nullptr && problem.scaleB == nullptr)
+                          ? 0
+                          : (problem.isScaleAVec || problem.isScaleBVec ? 2 : 1);
     return TensileLite::ProblemOverride(problem.trans_a == HIPBLAS_OP_N ? false : true,
                                         problem.trans_b == HIPBLAS_OP_N ? false : true,
                                         hipDataType_to_tensile_type(problem.a_type),
+                                        hipDataType_to_tensile_type(problem.b_type),
                                         roc2TensileType(problem.compute_type),
                                         hipDataType_to_tensile_type(problem.c_type),
+                                        hipDataType_to_tensile_type(problem.d_type),
                                         problem.m,
                                         problem.n,
                                         problem.k,
-                                        problem.batch_count);
+                                        problem.batch_count,
+                                        problem.col_stride_a,
+                                        problem.col_stride_b,
+                                        problem.col_stride_c,
+                                        problem.col_stride_d,
+                                        getTensileActivationType(problem.epilogue),
+                                        tensileUseBias(problem.epilogue),
+                                        scaleABMode);
 }
 
 TensileLite::ProblemOverride TensileDataGemm2ProblemOverride(std::shared_ptr<void> gemmData)
 {
     std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
 
-    return TensileLite::ProblemOverride(data->problem.transA(),
-                                        data->problem.transB(),
-                                        data->problem.a().dataType(),
-                                        data->problem.computeInputType(),
-                                        data->problem.c().dataType(),
-                                        data->problem.freeSizeA(0),
-                                        data->problem.freeSizeB(0),
-                                        data->problem.boundSize(0),
-                                        data->problem.batchSize(0));
+    auto const& problem     = data->problem;
+    bool        bias        = problem.getParams().biasEnum() != TensileLite::DataType::None;
+    int         scaleABMode = problem.useScaleAB().empty()
+                                  ? 0
+                                  : (problem.useScaleAB() == "Vector" ? 2 : 1);
+    return TensileLite::ProblemOverride(problem.transA(),
+                                        problem.transB(),
+                                        problem.a().dataType(),
+                                        problem.b().dataType(),
+                                        problem.computeInputType(),
+                                        problem.c().dataType(),
+                                        problem.d().dataType(),
+                                        problem.freeSizeA(0),
+                                        problem.freeSizeB(0),
+                                        problem.boundSize(0),
+                                        problem.batchSize(0),
+                                        problem.a().strides()[1],
+                                        problem.b().strides()[1],
+                                        problem.c().strides()[1],
+                                        problem.d().strides()[1],
+                                        problem.getParams().activationEnum(),
+                                        bias,
+                                        scaleABMode);
 }
 
 void initTensileGemmData(rocblaslt_handle       handle,
@@ -1946,6 +2545,10 @@ rocblaslt_status runContractionProblem(rocblaslt_handle                   handle
                                        std::shared_ptr<void>              gemmData)
 {
     rocblaslt_status status = rocblaslt_status_internal_error;
+    // With a preload profile the first call of every solution is timed, lookup included
+    bool timeFirstCall = !rocblaslt::Debug::Instance().preloadProfile().empty();
+    auto start         = timeFirstCall ? std::chrono::steady_clock::now()
+                                       : std::chrono::steady_clock::time_point{};
     try
     {
         std::shared_ptr<TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>>
@@ -1960,7 +2563,7 @@ rocblaslt_status runContractionProblem(rocblaslt_handle                   handle
             return rocblaslt_status_invalid_pointer;
         }
 
-        hardware = TensileLite::hip::GetDevice(*deviceProp);
+        hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
         std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
         rocblaslt_matmul_heuristic_result heuristicResult;
@@ -1983,6 +2586,12 @@ rocblaslt_status runContractionProblem(rocblaslt_handle                   handle
             logBenchFromTensileDataGemm(data->problem, data->inputs, data->algoIndex, false);
         }
 
+        if(get_trace_enabled())
+        {
+            traceFromTensileDataGemm(
+                data->problem, data->inputs, data->algoIndex, false, prob.stream);
+        }
+
         if(get_logger_layer_mode() & rocblaslt_layer_mode_log_profile)
         {
             logProfileFromTensileDataGemm(data->problem, data->inputs, false);
@@ -1998,10 +2607,17 @@ rocblaslt_status runContractionProblem(rocblaslt_handle                   handle
         }
         else
         {
+            // Only the launch sees the CUs left to the stream. Workspace sizes stay computed
+            // for all CUs, which is the larger grid.
+            data->problem.setParams().setAvailableCUs(
+                streamKAvailableCUs(handle, prob.stream, deviceProp->multiProcessorCount));
             auto kernels = solution->solve(data->problem, GetTensileInputs(prob), *hardware);
+            data->problem.setParams().setAvailableCUs(0);
             // Remove this after supports getting comgr buffers from hip.
+            // A preload profile replaces resolving every kernel of the gemm type
             bool isPreloaded = false;
-            if(rocblaslt::Debug::Instance().preload())
+            if(rocblaslt::Debug::Instance().preload()
+               && rocblaslt::Debug::Instance().preloadProfile().empty())
             {
                 for(size_t i = 0; i < kernels.size(); i++)
                 {
@@ -2030,8 +2646,19 @@ rocblaslt_status runContractionProblem(rocblaslt_handle                   handle
                 }
                 isPreloaded = true;
             }
+
             status = hip2RocStatus(
                 adapter->launchKernels(kernels, prob.stream, nullptr, nullptr, isPreloaded));
+
+            // The first call pays for loading its code object unless it was preloaded
+            if(timeFirstCall && !g_firstCallLatency.seen(handle->device, data->algoIndex))
+            {
+                double us = std::chrono::duration<double, std::micro>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+                g_firstCallLatency.record(
+                    handle->device, data->algoIndex, us, g_pendingPreloads.load() > 0);
+            }
         }
     }
     catch(const std::exception& e)
@@ -2233,7 +2860,7 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
             return rocblaslt_status_invalid_pointer;
         }
 
-        hardware = TensileLite::hip::GetDevice(*deviceProp);
+        hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
         int* solutionIndex = (int*)algo.data;
         if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
@@ -2263,7 +2890,10 @@ rocblaslt_status makeArgument(rocblaslt_handle             handle,
 
             data->inputs.ws = workspace;
 
+            data->problem.setParams().setAvailableCUs(
+                streamKAvailableCUs(handle, stream, deviceProp->multiProcessorCount));
             data->kernels = solution->solve(data->problem, data->inputs, *hardware);
+            data->problem.setParams().setAvailableCUs(0);
         }
         else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
         {
@@ -2388,6 +3018,11 @@ rocblaslt_status runKernelFromInvocation(rocblaslt_handle       handle,
             {
                 logProfileFromTensileDataGemm(data->problem, data->inputs, true);
             }
+            if(get_trace_enabled())
+            {
+                traceFromTensileDataGemm(
+                    data->problem, data->inputs, data->algoIndex, true, stream);
+            }
             status = hip2RocStatus(adapter->launchKernels(data->kernels, stream, start, stop));
         }
         else if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GROUPED_GEMM)
@@ -2404,6 +3039,11 @@ rocblaslt_status runKernelFromInvocation(rocblaslt_handle       handle,
             {
                 logBenchFromTensileDataGemm(data->problem, data->inputs, data->algoIndex, true);
             }
+            if(get_trace_enabled())
+            {
+                traceFromTensileDataGemm(
+                    data->problem, data->inputs, data->algoIndex, true, stream);
+            }
             //TODO: add profile logging for grouped gemm
             /*if(get_logger_layer_mode() & rocblaslt_layer_mode_log_profile)
             {
@@ -2460,8 +3100,7 @@ rocblaslt_status getDeviceUserArgumentsValuesFromContractionProblem(rocblaslt_ha
         {
             std::shared_ptr<TensileDataGroupedGemm> data
                 = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
-            auto  solution = library->getSolutionByIndex(*hardware, data->algoIndex);
-            auto& problem  = data->problem.gemms[0];
+            auto& problem = data->problem.gemms[0];
             if(problem.activationComputeType() == TensileLite::DataType::Float)
             {
                 setDeviceUserArgs(data->problem.gemms,
@@ -2524,10 +3163,16 @@ rocblaslt_status runKernelFromNewDeviceUserArguments(rocblaslt_handle       hand
         {
             std::shared_ptr<TensileDataGroupedGemm> data
                 = std::static_pointer_cast<TensileDataGroupedGemm>(gemmData);
+
+            // Called once per step, so the solution is looked up once for all kernels
+            hardware      = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
+            auto solution = library->getSolutionByIndex(*hardware, data->algoIndex);
+            if(!solution)
+                return rocblaslt_status_invalid_value;
+
             for(auto& it : data->kernels)
             {
-                uint8_t* arg      = it.args.rawdata();
-                auto     solution = library->getSolutionByIndex(*hardware, data->algoIndex);
+                uint8_t* arg = it.args.rawdata();
                 if(solution->internalArgsSupport.useUniversalArgs)
                 {
                     if(deviceUserArgs != nullptr)
@@ -2644,7 +3289,8 @@ void _convertToHeuristicResultArray(
     int*                                                            returnAlgoCount,
     size_t                                                          maxWorkSpaceBytes,
     const TensileLite::ContractionProblemGemm&                      problem,
-    const TensileLite::Hardware&                                    hardware)
+    const TensileLite::Hardware&                                    hardware,
+    bool                                                            withRoofline = true)
 {
     *returnAlgoCount = std::min((int)solutions.size(), requestedAlgoCount);
     for(size_t i = 0; i < *returnAlgoCount; i++)
@@ -2657,6 +3303,8 @@ void _convertToHeuristicResultArray(
         heuristicResultsArray[i].algo.fallback            = false;
         heuristicResultsArray[i].state                    = rocblaslt_status_success;
         heuristicResultsArray[i].workspaceSize = solution->requiredWorkspaceSize(problem, hardware);
+        if(withRoofline)
+            estimateRoofline(*solution, problem, hardware, heuristicResultsArray[i]);
     }
     for(size_t i = *returnAlgoCount; i < requestedAlgoCount; i++)
     {
@@ -2697,10 +3345,11 @@ std::vector<std::shared_ptr<TensileLite::ContractionSolution>>
         return {};
     }
 
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
     std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
     updateTensileProblem(prob, data->problem);
+    data->problem.setDeterministicMode(handle->deterministic);
 
     bool enableEpilogue = prob.epilogue == ROCBLASLT_EPILOGUE_DEFAULT ? false : true;
 
@@ -2740,10 +3389,11 @@ rocblaslt_status getBestSolutions(RocblasltContractionProblem const& prob,
         return rocblaslt_status_invalid_pointer;
     }
 
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
     std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
     updateTensileProblem(prob, data->problem);
+    data->problem.setDeterministicMode(handle->deterministic);
 
     bool enableEpilogue = prob.epilogue == ROCBLASLT_EPILOGUE_DEFAULT ? false : true;
 
@@ -2772,90 +3422,205 @@ rocblaslt_status getBestSolutions(RocblasltContractionProblem const& prob,
     return rocblaslt_status_success;
 }
 
-template <typename MyProblem>
-rocblaslt_status getAllSolutions(MyProblem&                                      prob,
-                                 rocblaslt_handle                                handle,
-                                 std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults,
-                                 size_t                                          maxWorkSpaceBytes)
+namespace
 {
-    std::shared_ptr<TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>>
-                                           library;
-    std::shared_ptr<hipDeviceProp_t>       deviceProp;
-    std::shared_ptr<TensileLite::Hardware> hardware;
-
-    // auto &adapter =
-    static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device));
-
-    if(!library)
+    /**************************************************************************
+     * Every solution matching the gemm type of prob, each index once.        *
+     * hardware receives the device the search ran for.                       *
+     **************************************************************************/
+    template <typename MyProblem>
+    rocblaslt_status
+        findUniqueSolutions(MyProblem&                                                 prob,
+                            rocblaslt_handle                                           handle,
+                            std::shared_ptr<TensileLite::Hardware>&                    hardware,
+                            std::vector<std::shared_ptr<TensileLite::ContractionSolution>>& unique)
     {
-        return rocblaslt_status_invalid_pointer;
-    }
+        std::shared_ptr<TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>>
+                                         library;
+        std::shared_ptr<hipDeviceProp_t> deviceProp;
 
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+        // auto &adapter =
+        static_cast<void>(get_library_and_adapter(&library, &deviceProp, handle->device));
 
-    std::set<std::shared_ptr<TensileLite::ContractionSolution>> solutions;
-    std::shared_ptr<void>                                       tensile_prob;
+        if(!library)
+        {
+            return rocblaslt_status_invalid_pointer;
+        }
 
-    if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGemm>::value)
-    {
-        solutions = library->findAllSolutions(
-            prob, *hardware, TensileLite::SolutionLibrarySearchType::GEMM_TYPE_ONLY);
-    }
-    else if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGroupedGemm>::value)
-    {
-        solutions = library->findAllSolutionsGroupedGemm(
-            prob.gemms, *hardware, TensileLite::SolutionLibrarySearchType::GEMM_TYPE_ONLY);
-    }
-    log_api(__func__, "Found hardware solutions: ", solutions.size());
+        hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
+
+        std::set<std::shared_ptr<TensileLite::ContractionSolution>> solutions;
 
-    // when there is no solution for xfloat32, fallback comput_type to fp32
-    if(solutions.size() == 0 && prob.f32XdlMathOp() == TensileLite::DataType::XFloat32)
-    {
-        prob.setF32XdlMathOp(TensileLite::DataType::Float);
         if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGemm>::value)
         {
+            prob.setDeterministicMode(handle->deterministic);
             solutions = library->findAllSolutions(
                 prob, *hardware, TensileLite::SolutionLibrarySearchType::GEMM_TYPE_ONLY);
         }
         else if constexpr(std::is_same<MyProblem,
                                        TensileLite::ContractionProblemGroupedGemm>::value)
         {
+            for(auto& gemm : prob.gemms)
+                gemm.setDeterministicMode(handle->deterministic);
             solutions = library->findAllSolutionsGroupedGemm(
                 prob.gemms, *hardware, TensileLite::SolutionLibrarySearchType::GEMM_TYPE_ONLY);
         }
-    }
+        log_api(__func__, "Found hardware solutions: ", solutions.size());
 
-    heuristicResults.resize(solutions.size());
+        // when there is no solution for xfloat32, fallback comput_type to fp32
+        if(solutions.size() == 0 && prob.f32XdlMathOp() == TensileLite::DataType::XFloat32)
+        {
+            prob.setF32XdlMathOp(TensileLite::DataType::Float);
+            if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGemm>::value)
+            {
+                solutions = library->findAllSolutions(
+                    prob, *hardware, TensileLite::SolutionLibrarySearchType::GEMM_TYPE_ONLY);
+            }
+            else if constexpr(std::is_same<MyProblem,
+                                           TensileLite::ContractionProblemGroupedGemm>::value)
+            {
+                solutions = library->findAllSolutionsGroupedGemm(
+                    prob.gemms, *hardware, TensileLite::SolutionLibrarySearchType::GEMM_TYPE_ONLY);
+            }
+        }
+
+        //workaround: findAllSolutions should get all solutions without duplications.
+        //Solution indices are dense, so a bitmap keeps the de-duplication linear.
+        int maxIndex = -1;
+        for(auto const& solution : solutions)
+            maxIndex = std::max(maxIndex, solution->index);
+        std::vector<bool> emitted(maxIndex + 1, false);
+        unique.clear();
+        unique.reserve(solutions.size());
+        for(auto const& solution : solutions)
+        {
+            if(solution->index < 0 || emitted[solution->index])
+                continue;
+            emitted[solution->index] = true;
+            unique.push_back(solution);
+        }
+        return rocblaslt_status_success;
+    }
 
-    int i = 0;
-    for(auto solution : solutions)
+    // The workspace and roofline evaluation of one solution, independent of all others
+    template <typename MyProblem>
+    void fillAllSolutionsResult(TensileLite::ContractionSolution const& solution,
+                                MyProblem const&                        prob,
+                                TensileLite::Hardware const&            hardware,
+                                size_t                                  maxWorkSpaceBytes,
+                                rocblaslt_matmul_heuristic_result&      result)
     {
-        //workaround: findAllSolutions should get all solutions without duplications
-        bool duplicated_sol = false;
-        for(int j = 0; j < i; j++)
-            if(*(int*)(heuristicResults[j].algo.data) == solution->index)
-                duplicated_sol = true;
-        if(duplicated_sol)
-            continue;
-        memset(&heuristicResults[i], 0, sizeof(rocblaslt_matmul_heuristic_result));
-        memset(heuristicResults[i].algo.data, 0, sizeof(heuristicResults[i].algo.data));
-        int* solutionIndex                           = (int*)(heuristicResults[i].algo.data);
-        *solutionIndex                               = solution->index;
-        heuristicResults[i].algo.max_workspace_bytes = maxWorkSpaceBytes;
-        heuristicResults[i].algo.fallback            = false;
-        heuristicResults[i].state                    = rocblaslt_status_success;
+        memset(&result, 0, sizeof(rocblaslt_matmul_heuristic_result));
+        int* solutionIndex              = (int*)(result.algo.data);
+        *solutionIndex                  = solution.index;
+        result.algo.max_workspace_bytes = maxWorkSpaceBytes;
+        result.algo.fallback            = false;
+        result.state                    = rocblaslt_status_success;
         if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGemm>::value)
-            heuristicResults[i].workspaceSize = solution->requiredWorkspaceSize(prob, *hardware);
-        else
-            heuristicResults[i].workspaceSize = 0;
-        i++;
+        {
+            result.workspaceSize = solution.requiredWorkspaceSize(prob, hardware);
+            estimateRoofline(solution, prob, hardware, result);
+        }
     }
-    heuristicResults.resize(i);
+} // namespace
+
+template <typename MyProblem>
+rocblaslt_status getAllSolutions(MyProblem&                                      prob,
+                                 rocblaslt_handle                                handle,
+                                 std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults,
+                                 size_t                                          maxWorkSpaceBytes)
+{
+    std::shared_ptr<TensileLite::Hardware>                         hardware;
+    std::vector<std::shared_ptr<TensileLite::ContractionSolution>> unique;
+
+    auto status = findUniqueSolutions(prob, handle, hardware, unique);
+    if(status != rocblaslt_status_success)
+        return status;
+
+    heuristicResults.resize(unique.size());
+    parallelForRange(unique.size(), 64, [&](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++)
+            fillAllSolutionsResult(
+                *unique[i], prob, *hardware, maxWorkSpaceBytes, heuristicResults[i]);
+    });
     log_api(__func__, "Final hardware solutions: ", heuristicResults.size());
 
     return rocblaslt_status_success;
 }
 
+template <typename MyProblem>
+rocblaslt_status streamAllSolutions(
+    MyProblem&                                                     prob,
+    rocblaslt_handle                                               handle,
+    size_t                                                         maxWorkSpaceBytes,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback)
+{
+    // Solutions evaluated per round before their results are handed to callback
+    constexpr size_t batchSize = 256;
+
+    std::shared_ptr<TensileLite::Hardware>                         hardware;
+    std::vector<std::shared_ptr<TensileLite::ContractionSolution>> unique;
+
+    auto status = findUniqueSolutions(prob, handle, hardware, unique);
+    if(status != rocblaslt_status_success)
+        return status;
+
+    if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGemm>::value)
+        prob.setWorkspaceSize(maxWorkSpaceBytes);
+
+    size_t                                         streamed = 0;
+    std::vector<rocblaslt_matmul_heuristic_result> results(batchSize);
+    std::vector<char>                              accepted(batchSize);
+    for(size_t first = 0; first < unique.size(); first += batchSize)
+    {
+        size_t count = std::min(batchSize, unique.size() - first);
+
+        // The size predicates are the expensive part of the search; run them with the
+        // workspace and roofline evaluation on the pool.
+        parallelForRange(count, 16, [&](size_t begin, size_t end) {
+            for(size_t i = begin; i < end; i++)
+            {
+                auto const& solution = *unique[first + i];
+                accepted[i]          = true;
+                if constexpr(std::is_same<MyProblem, TensileLite::ContractionProblemGemm>::value)
+                    accepted[i] = (*solution.problemPredicate)(prob)
+                                  && (!handle->deterministic || solution.isDeterministic(prob));
+                if(accepted[i])
+                    fillAllSolutionsResult(
+                        solution, prob, *hardware, maxWorkSpaceBytes, results[i]);
+            }
+        });
+
+        std::vector<rocblaslt_matmul_heuristic_result*> ready;
+        for(size_t i = 0; i < count; i++)
+            if(accepted[i])
+                ready.push_back(&results[i]);
+
+        // Fastest predicted first within the batch; no estimate keeps the library order at the end
+        std::stable_sort(ready.begin(),
+                         ready.end(),
+                         [](const rocblaslt_matmul_heuristic_result* a,
+                            const rocblaslt_matmul_heuristic_result* b) {
+                             if(a->predictedTimeUs <= 0 || b->predictedTimeUs <= 0)
+                                 return a->predictedTimeUs > 0 && b->predictedTimeUs <= 0;
+                             return a->predictedTimeUs < b->predictedTimeUs;
+                         });
+
+        for(auto result : ready)
+        {
+            streamed++;
+            if(!callback(*result))
+            {
+                log_api(__func__, "streamed", streamed, "of at most", unique.size());
+                return rocblaslt_status_success;
+            }
+        }
+    }
+    log_api(__func__, "streamed", streamed, "of at most", unique.size());
+
+    return rocblaslt_status_success;
+}
+
 rocblaslt_status getAllSolutions(RocblasltContractionProblem&                    prob,
                                  rocblaslt_handle                                handle,
                                  std::vector<rocblaslt_matmul_heuristic_result>& heuristicResults,
@@ -2879,6 +3644,31 @@ rocblaslt_status getAllSolutions(std::vector<RocblasltContractionProblem>&
     return getAllSolutions(tensile_probs, handle, heuristicResults, maxWorkSpaceBytes);
 }
 
+rocblaslt_status streamAllSolutions(
+    RocblasltContractionProblem&                                   prob,
+    rocblaslt_handle                                               handle,
+    size_t                                                         maxWorkSpaceBytes,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback)
+{
+    auto tensile_prob = ConstructTensileProblem(prob);
+    return streamAllSolutions(tensile_prob, handle, maxWorkSpaceBytes, callback);
+}
+
+rocblaslt_status streamAllSolutions(
+    std::vector<RocblasltContractionProblem>&                      probs,
+    rocblaslt_handle                                               handle,
+    size_t                                                         maxWorkSpaceBytes,
+    const std::function<bool(rocblaslt_matmul_heuristic_result&)>& callback)
+{
+    TensileLite::ContractionProblemGroupedGemm tensile_probs;
+    for(int i = 0; i < probs.size(); i++)
+    {
+        tensile_probs.gemms.push_back(ConstructTensileProblem(probs[i]));
+        tensile_probs.gemms[i].setGroupedGemm(true);
+    }
+    return streamAllSolutions(tensile_probs, handle, maxWorkSpaceBytes, callback);
+}
+
 rocblaslt_status getAllSolutions(std::shared_ptr<void>                           gemmData,
                                  rocblaslt_handle                                handle,
                                  rocblaslt::RocGemmType                          gemmType,
@@ -2917,29 +3707,36 @@ rocblaslt_status
     std::shared_ptr<hipDeviceProp_t>       deviceProp;
     std::shared_ptr<TensileLite::Hardware> hardware;
 
-#if ROCBLASLT_TENSILE_LAZY_LOAD
-    // isPreload = true is to load placeholder libraries except code objects
-    auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, true);
-#else
+    // With lazy loading, index lookups load only the placeholder library holding the index
     auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
-#endif
 
     if(!library)
     {
         return rocblaslt_status_invalid_pointer;
     }
 
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
-    int  lastSolutionIndex = library->solutions.rbegin()->first;
+    // The bound is only needed for indices that are not found. Asking for it up front would
+    // build the index directory even when every index is already resident.
+    int  lastSolutionIndex = -1;
+    bool boundKnown        = false;
     bool isOutOfBound      = true;
     int  i                 = 0;
     for(auto index : solutionIndex)
     {
-        isOutOfBound  = isOutOfBound && (index > lastSolutionIndex);
         auto solution = library->getSolutionByIndex(*hardware, index);
         if(!solution)
+        {
+            if(!boundKnown)
+            {
+                lastSolutionIndex = library->lastSolutionIndex();
+                boundKnown        = true;
+            }
+            isOutOfBound = isOutOfBound && (index > lastSolutionIndex);
             continue;
+        }
+        isOutOfBound = false;
         rocblaslt_matmul_heuristic_result result;
         memset(&result, 0, sizeof(rocblaslt_matmul_heuristic_result));
         memset(result.algo.data, 0, sizeof(result.algo.data));
@@ -2970,19 +3767,14 @@ rocblaslt_status isSolutionSupported(rocblaslt_handle       handle,
     std::shared_ptr<hipDeviceProp_t>       deviceProp;
     std::shared_ptr<TensileLite::Hardware> hardware;
 
-#if ROCBLASLT_TENSILE_LAZY_LOAD
-    // isPreload = true is a workaround for lazy_lib_load
-    auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device, true);
-#else
     auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
-#endif
 
     if(!library)
     {
         return rocblaslt_status_invalid_pointer;
     }
 
-    hardware              = TensileLite::hip::GetDevice(*deviceProp);
+    hardware              = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
     *workspaceSizeInBytes = 0;
 
     int* solutionIndex = (int*)algo->data;
@@ -3036,6 +3828,11 @@ rocblaslt_status isSolutionSupported(rocblaslt_handle       handle,
             log_error(__func__, "Solution is not supported");
             return rocblaslt_status_invalid_value;
         }
+        else if(handle->deterministic && !solution->isDeterministic(tensile_prob))
+        {
+            log_error(__func__, "Solution is not deterministic");
+            return rocblaslt_status_invalid_value;
+        }
         else
         {
             *workspaceSizeInBytes = solution->requiredWorkspaceSize(tensile_prob, *hardware);
@@ -3102,6 +3899,11 @@ rocblaslt_status isSolutionSupported(rocblaslt_handle       handle,
             log_error(__func__, "Solution is not supported");
             return rocblaslt_status_invalid_value;
         }
+        if(handle->deterministic && !solution->isDeterministic(tensile_prob.gemms[0]))
+        {
+            log_error(__func__, "Solution is not deterministic");
+            return rocblaslt_status_invalid_value;
+        }
         *workspaceSizeInBytes = problemWs;
     }
     return rocblaslt_status_success;
@@ -3196,12 +3998,13 @@ rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
         return rocblaslt_status_invalid_pointer;
     }
 
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
     if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
     {
         std::shared_ptr<TensileDataGemm> data = std::static_pointer_cast<TensileDataGemm>(gemmData);
         data->problem.setWorkspaceSize(workspaceBytes);
+        data->problem.setDeterministicMode(handle->deterministic);
         auto solutions = getSolutions(data->inputs,
                                       library,
                                       hardware,
@@ -3241,6 +4044,7 @@ rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
         {
             data->problem.gemms[i].setWorkspaceSize(workspaceBytes);
             data->problem.gemms[i].setGroupedGemmCount(data->problem.gemms.size());
+            data->problem.gemms[i].setDeterministicMode(handle->deterministic);
         }
 
         auto solutions = library->findTopSolutionsGroupedGemm(
@@ -3257,7 +4061,8 @@ rocblaslt_status getBestSolutions(rocblaslt_handle       handle,
                                        &returnAlgoCount,
                                        workspaceBytes,
                                        data->problem.gemms[0],
-                                       *hardware);
+                                       *hardware,
+                                       false);
     }
 
     return rocblaslt_status_success;
@@ -3329,7 +4134,7 @@ std::string getSolutionNameFromData(rocblaslt_handle             handle,
 
     std::shared_ptr<TensileLite::Hardware> hardware;
 
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
     if(gemmType == rocblaslt::RocGemmType::ROCBLASLT_GEMM)
     {
@@ -3375,7 +4180,7 @@ std::string getKernelNameFromAlgoIndex(rocblaslt_handle handle, const rocblaslt_
 
     auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
     std::shared_ptr<TensileLite::Hardware> hardware;
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
     if(!library)
     {
@@ -3395,7 +4200,7 @@ std::string getSolutionNameFromAlgoIndex(rocblaslt_handle handle, const rocblasl
 
     auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
     std::shared_ptr<TensileLite::Hardware> hardware;
-    hardware = TensileLite::hip::GetDevice(*deviceProp);
+    hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
 
     if(!library)
     {
@@ -3407,6 +4212,29 @@ std::string getSolutionNameFromAlgoIndex(rocblaslt_handle handle, const rocblasl
     return solution->solutionName;
 }
 
+bool isDeterministicFromAlgoIndex(rocblaslt_handle             handle,
+                                  const rocblaslt_matmul_algo& algo,
+                                  uint16_t                     gsu)
+{
+    std::shared_ptr<TensileLite::MasterSolutionLibrary<TensileLite::ContractionProblemGemm>>
+                                     library;
+    std::shared_ptr<hipDeviceProp_t> deviceProp;
+
+    auto adapter = get_library_and_adapter(&library, &deviceProp, handle->device);
+    if(!library)
+        return false;
+    auto hardware = TensileLite::hip::GetDevice(*deviceProp, handle->available_cus);
+
+    auto solution = library->getSolutionByIndex(*hardware, *(int*)algo.data);
+    if(!solution)
+        return false;
+
+    // Only the GSU of the problem, set by a tuning, changes the classification
+    TensileLite::ContractionProblemGemm problem;
+    problem.setParams().setGSU(gsu);
+    return solution->isDeterministic(problem);
+}
+
 /***************************************************************
  * ! \brief  Initialize rocblaslt for the current HIP device, to *
  * avoid costly startup time at the first call on that device. *
@@ -3426,6 +4254,27 @@ std::atomic_bool& rocblaslt_internal_tensile_is_initialized()
     return init;
 }
 
+void setCodeObjectBudget(rocblaslt_handle handle, size_t bytes)
+{
+    if(auto adapter = get_library_and_adapter(nullptr, nullptr, handle->device))
+        adapter->setCodeObjectBudget(bytes);
+}
+
+rocblaslt::RocCodeObjectResidency getCodeObjectResidency(rocblaslt_handle handle)
+{
+    rocblaslt::RocCodeObjectResidency residency;
+    if(auto adapter = get_library_and_adapter(nullptr, nullptr, handle->device))
+    {
+        auto stats                = adapter->residencyStats();
+        residency.loaded_modules  = stats.loadedModules;
+        residency.resident_bytes  = stats.residentBytes;
+        residency.evicted_modules = stats.evictedModules;
+        residency.evicted_bytes   = stats.evictedBytes;
+        residency.reloads         = stats.reloads;
+    }
+    return residency;
+}
+
 /***********************************************************************************
  * Templates for backward compatibility with old rocBLASLt API
  ***********************************************************************************/
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include "utility.hpp"
+#include <mutex>
 #include <sys/types.h>
 #include <unistd.h>
 std::ostream* get_logger_os()
@@ -32,6 +33,47 @@ std::ostream* get_logger_os()
     return s.log_os;
 }
 
+std::ostringstream& get_logger_buffer()
+{
+    thread_local std::ostringstream buffer;
+    buffer.str({});
+    buffer.clear();
+    return buffer;
+}
+
+std::mutex& get_logger_os_mutex()
+{
+    return LoggerSingleton::getInstance().log_os_mutex;
+}
+
+void log_submit(std::ostringstream& record, bool flush)
+{
+    LoggerSingleton& s = LoggerSingleton::getInstance();
+    if(s.async_writer && s.async_writer->try_push(record.str()))
+        return;
+
+    std::lock_guard<std::mutex> lock(s.log_os_mutex);
+    *s.log_os << record.str();
+    if(flush)
+        s.log_os->flush();
+}
+
+bool get_trace_enabled()
+{
+    return LoggerSingleton::getInstance().trace_writer != nullptr;
+}
+
+void trace_submit(hipblaslt_trace_record& record)
+{
+    LoggerSingleton& s  = LoggerSingleton::getInstance();
+    record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - s.trace_start)
+                              .count();
+    auto data = reinterpret_cast<const char*>(&record);
+    if(!s.trace_writer->try_push(data, sizeof(record)))
+        s.trace_writer->write(data, sizeof(record), true);
+}
+
 uint32_t get_logger_layer_mode()
 {
     LoggerSingleton& s = LoggerSingleton::getInstance();
@@ -40,23 +82,24 @@ uint32_t get_logger_layer_mode()
 
 std::string prefix(const char* layer, const char* caller)
 {
-    time_t now   = time(0);
-    tm*    local = localtime(&now);
+    time_t now = time(0);
+    tm     local;
+    localtime_r(&now, &local); // localtime is not thread safe
 
-    std::string             format = "[%d-%02d-%02d %02d:%02d:%02d][HIPBLASLT][%lu][%s][%s]\0";
-    std::unique_ptr<char[]> buf(new char[255]);
-    std::sprintf(buf.get(),
-                 format.c_str(),
-                 1900 + local->tm_year,
-                 1 + local->tm_mon,
-                 local->tm_mday,
-                 local->tm_hour,
-                 local->tm_min,
-                 local->tm_sec,
-                 getpid(),
-                 layer,
-                 caller);
-    return std::string(buf.get());
+    char buf[256];
+    std::snprintf(buf,
+                  sizeof(buf),
+                  "[%d-%02d-%02d %02d:%02d:%02d][HIPBLASLT][%lu][%s][%s]",
+                  1900 + local.tm_year,
+                  1 + local.tm_mon,
+                  local.tm_mday,
+                  local.tm_hour,
+                  local.tm_min,
+                  local.tm_sec,
+                  (unsigned long)getpid(),
+                  layer,
+                  caller);
+    return std::string(buf);
 }
 
 const char* hipDataType_to_string(hipDataType type)
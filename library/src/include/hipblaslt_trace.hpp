@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/*! \file
+ * \brief Binary shape trace. When HIPBLASLT_TRACE_FILE is set the library appends one
+ * fixed size record per launched gemm, which hipblaslt-trace-replay re-executes. The file
+ * is a hipblaslt_trace_header followed by hipblaslt_trace_record entries in call order.
+ * Records the library could not queue are replaced by a HIPBLASLT_TRACE_DROPPED record,
+ * so readers know the trace is incomplete.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define HIPBLASLT_TRACE_MAGIC "HBLTTRC"
+#define HIPBLASLT_TRACE_VERSION 2
+
+typedef enum hipblaslt_trace_flag_ : uint32_t
+{
+    HIPBLASLT_TRACE_TRANS_A         = 1 << 0,
+    HIPBLASLT_TRACE_TRANS_B         = 1 << 1,
+    HIPBLASLT_TRACE_SCALE_CD        = 1 << 2,
+    HIPBLASLT_TRACE_SCALE_ALPHA_VEC = 1 << 3,
+    HIPBLASLT_TRACE_GRADIENT        = 1 << 4,
+    HIPBLASLT_TRACE_USE_E           = 1 << 5,
+    HIPBLASLT_TRACE_BIAS            = 1 << 6,
+    HIPBLASLT_TRACE_CPP_API         = 1 << 7,
+    HIPBLASLT_TRACE_DROPPED         = 1 << 8, // not a gemm, m calls were dropped before it
+} hipblaslt_trace_flag;
+
+typedef enum hipblaslt_trace_activation_ : int32_t
+{
+    HIPBLASLT_TRACE_ACTIVATION_NONE  = 0,
+    HIPBLASLT_TRACE_ACTIVATION_RELU  = 1,
+    HIPBLASLT_TRACE_ACTIVATION_GELU  = 2,
+    HIPBLASLT_TRACE_ACTIVATION_DGELU = 3,
+} hipblaslt_trace_activation;
+
+struct hipblaslt_trace_header
+{
+    char     magic[8]; // HIPBLASLT_TRACE_MAGIC
+    uint32_t version; // HIPBLASLT_TRACE_VERSION
+    uint32_t record_size; // sizeof(hipblaslt_trace_record)
+    uint64_t start_time_ns; // system clock when the trace was opened, ns since the epoch
+};
+
+struct hipblaslt_trace_record
+{
+    uint64_t timestamp_ns; // host submission time since start_time_ns
+    uint64_t stream; // hipStream_t of the call, identifies the stream only
+    int64_t  m, n, k, batch_count;
+    int64_t  lda, ldb, ldc, ldd, lde;
+    int64_t  stride_a, stride_b, stride_c, stride_d, stride_e;
+    double   alpha, beta;
+    int32_t  a_type, b_type, c_type, d_type, scale_type, bias_type; // hipDataType
+    int32_t  compute_type; // hipblasComputeType_t
+    int32_t  activation; // hipblaslt_trace_activation
+    int32_t  bias_source; // 0 a, 1 b, 3 d, as in the bench --bias_source
+    int32_t  scale_a, scale_b; // 0 none, 1 scalar, 2 vector, as in the bench --scaleA/--scaleB
+    int32_t  solution_index;
+    uint32_t splitk, wgm;
+    uint32_t group_index, group_count; // position in a grouped gemm, group_count is 1 for gemm
+    uint32_t flags; // hipblaslt_trace_flag
+    uint32_t reserved;
+};
+
+static_assert(sizeof(hipblaslt_trace_record) == 216, "trace record layout changed");
+
+// Records describing the same problem, ignoring when and on which stream it was called
+inline bool hipblaslt_trace_same_problem(const hipblaslt_trace_record& a,
+                                         const hipblaslt_trace_record& b)
+{
+    constexpr size_t offset = offsetof(hipblaslt_trace_record, m);
+    return memcmp(reinterpret_cast<const char*>(&a) + offset,
+                  reinterpret_cast<const char*>(&b) + offset,
+                  sizeof(hipblaslt_trace_record) - offset)
+           == 0;
+}
+
+// Hash of the fields compared by hipblaslt_trace_same_problem
+struct hipblaslt_trace_problem_hash
+{
+    size_t operator()(const hipblaslt_trace_record& r) const
+    {
+        constexpr size_t offset = offsetof(hipblaslt_trace_record, m);
+        const auto*      bytes  = reinterpret_cast<const unsigned char*>(&r) + offset;
+        uint64_t         hash   = 14695981039346656037ull; // FNV-1a
+        for(size_t i = 0; i < sizeof(hipblaslt_trace_record) - offset; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        return hash;
+    }
+};
+
+struct hipblaslt_trace_problem_equal
+{
+    bool operator()(const hipblaslt_trace_record& a, const hipblaslt_trace_record& b) const
+    {
+        return hipblaslt_trace_same_problem(a, b);
+    }
+};
@@ -205,6 +205,18 @@ namespace TensileLite
         int         skFullTiles      = 1;
         std::string deviceName;
 
+        // CUs left to the gemm when it shares the device, e.g. under a CU mask, 0 for all.
+        // Performance models and stream-K grids use availableCUs(). Library selection and
+        // the workgroup to XCC mapping keep the physical computeUnitCount.
+        int availableComputeUnitCount = 0;
+
+        int availableCUs() const
+        {
+            return availableComputeUnitCount > 0 && availableComputeUnitCount < computeUnitCount
+                       ? availableComputeUnitCount
+                       : computeUnitCount;
+        }
+
         virtual bool   runsKernelTargeting(Processor p) const;
         virtual size_t id() const
         {
@@ -255,7 +267,8 @@ namespace TensileLite
 
         bool operator==(AMDGPU const& rhs) const
         {
-            return processor == rhs.processor && computeUnitCount == rhs.computeUnitCount;
+            return processor == rhs.processor && computeUnitCount == rhs.computeUnitCount
+                   && availableCUs() == rhs.availableCUs();
         }
     };
 
@@ -31,6 +31,7 @@
 #include <unordered_map>
 
 #include <Tensile/ContractionProblem.hpp>
+#include <Tensile/Metrics.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 
 #include <Tensile/AMDGPU_Detail.hpp>
@@ -52,7 +53,7 @@ namespace TensileLite
     };
 
     /**
-     * Thread-safe multi-valued cache.
+     * Thread-safe multi-valued cache. add() replaces the value already stored under the same keys.
      *
      * Note that due to a quirk with templates, the order of the keys in find() and add() is *opposite* of that in the type.
      *
@@ -87,6 +88,7 @@ namespace TensileLite
         template <typename... Ks>
         Value find(Ks const&... keys)
         {
+            ScopedMetricTimer                         timer(MetricTimer::CacheLookup);
             std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
 
             auto rv = find_impl(m_map, keys...);
@@ -98,6 +100,9 @@ namespace TensileLite
                     m_hits++;
             }
 
+            Metrics::Instance().increment(rv != m_nullValue ? MetricCounter::CacheHits
+                                                            : MetricCounter::CacheMisses);
+
             return rv;
         }
 
@@ -135,7 +140,7 @@ namespace TensileLite
         template <typename SubMap, typename K>
         void add_impl(SubMap& map, Value const& value, K const& key)
         {
-            map.emplace(key, value);
+            map.insert_or_assign(key, value);
         }
 
         template <typename SubMap, typename K, typename... Ks>
@@ -159,16 +164,46 @@ namespace TensileLite
     public:
         using Library = SolutionLibrary<MyProblem, MySolution>;
         using Cache  = CacheMap<std::tuple<std::shared_ptr<MySolution>, double>, AMDGPU, MyProblem>;
-        using Caches = CacheMap<SolutionVector<MySolution>, AMDGPU, MyProblem>;
-        using CachesGroupedGemm
-            = CacheMap<SolutionVector<MySolution>, AMDGPU, std::vector<MyProblem>>;
+
+        /**
+         * A cached top-N list. An empty list is a remembered "no solution" answer, so only a
+         * null pointer means the problem has not been searched yet.
+         */
+        using TopSolutions      = std::shared_ptr<SolutionVector<MySolution> const>;
+        using Caches            = CacheMap<TopSolutions, int, AMDGPU, MyProblem>;
+        using CachesGroupedGemm = CacheMap<TopSolutions, int, AMDGPU, std::vector<MyProblem>>;
+
+        /**
+         * Ranked candidates found for a workspace budget class. exhaustive is set when the
+         * library returned fewer solutions than were asked for, i.e. nothing further exists.
+         */
+        struct Candidates
+        {
+            SolutionVector<MySolution> solutions;
+            bool                       exhaustive = false;
+        };
+        using CandidateCaches = CacheMap<std::shared_ptr<Candidates const>, AMDGPU, MyProblem>;
 
         CachingLibrary(std::shared_ptr<Library> subLibrary)
             : m_subLibrary(subLibrary)
             , m_cache(std::make_tuple(nullptr, std::numeric_limits<double>::max()))
-            , m_caches(SolutionVector<MySolution>{})
-            , m_cachesGroupedGemm(SolutionVector<MySolution>{})
+            , m_caches(TopSolutions{})
+            , m_candidates(std::shared_ptr<Candidates const>{})
+            , m_cachesGroupedGemm(TopSolutions{})
+        {
+        }
+
+        /**
+         * Workspace budgets are grouped by rounding up to a power of two. The library only
+         * compares the budget against what a solution needs, so a search made with the class
+         * budget returns a superset of every budget in the class, in the same order.
+         */
+        static size_t workspaceBudgetClass(size_t bytes)
         {
+            size_t budget = 1;
+            while(budget < bytes && budget <= std::numeric_limits<size_t>::max() / 2)
+                budget <<= 1;
+            return bytes == 0 ? 0 : std::max(budget, bytes);
         }
 
         virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
@@ -188,6 +223,13 @@ namespace TensileLite
                 double cachedFitness = std::numeric_limits<double>::max();
                 fitness              = (fitness) ? fitness : &cachedFitness;
 
+                // The best solution of the library may not be deterministic
+                if(problem.deterministicMode())
+                {
+                    auto solutions = findTopSolutions(problem, hardware, 1);
+                    return solutions.empty() ? nullptr : solutions.front();
+                }
+
                 auto const&                 amdgpu = dynamic_cast<AMDGPU const&>(hardware);
                 std::shared_ptr<MySolution> solution;
                 std::tie(solution, *fitness) = m_cache.find(problem, amdgpu);
@@ -213,7 +255,10 @@ namespace TensileLite
                              SolutionLibrarySearchType searchType
                              = SolutionLibrarySearchType::DEFAULT) const override
         {
-            return m_subLibrary->findAllSolutions(problem, hardware, searchType);
+            auto solutions = m_subLibrary->findAllSolutions(problem, hardware, searchType);
+            if(problem.deterministicMode())
+                removeNonDeterministic(solutions, problem);
+            return solutions;
         }
 
         virtual SolutionSet<MySolution>
@@ -222,7 +267,11 @@ namespace TensileLite
                                         SolutionLibrarySearchType     searchType
                                         = SolutionLibrarySearchType::DEFAULT) const override
         {
-            return m_subLibrary->findAllSolutionsGroupedGemm(problems, hardware, searchType);
+            auto solutions
+                = m_subLibrary->findAllSolutionsGroupedGemm(problems, hardware, searchType);
+            if(!problems.empty() && problems[0].deterministicMode())
+                removeNonDeterministic(solutions, problems[0]);
+            return solutions;
         }
 
         std::shared_ptr<MySolution> findSolutionInCache(MyProblem const& problem,
@@ -253,18 +302,15 @@ namespace TensileLite
         {
             try
             {
-                auto const&                amdgpu = dynamic_cast<AMDGPU const&>(hardware);
-                SolutionVector<MySolution> solutions;
-                solutions = m_caches.find(problem, amdgpu);
-
-                if(solutions.size() != 0)
-                    return solutions;
+                auto const& amdgpu = dynamic_cast<AMDGPU const&>(hardware);
+                if(auto cached = m_caches.find(problem, amdgpu, numSolutions))
+                    return *cached;
 
-                solutions = m_subLibrary->findTopSolutions(problem, hardware, numSolutions);
-                if(solutions.size() != 0)
-                    m_caches.add(solutions, problem, amdgpu);
+                auto solutions = std::make_shared<SolutionVector<MySolution> const>(
+                    findFeasibleSolutions(problem, amdgpu, numSolutions));
+                m_caches.add(solutions, problem, amdgpu, numSolutions);
 
-                return solutions;
+                return *solutions;
             }
             catch(std::bad_cast const& exc)
             {
@@ -280,19 +326,18 @@ namespace TensileLite
         {
             try
             {
-                auto const&                amdgpu = dynamic_cast<AMDGPU const&>(hardware);
-                SolutionVector<MySolution> solutions;
-                solutions = m_cachesGroupedGemm.find(problems, amdgpu);
-
-                if(solutions.size() != 0)
-                    return solutions;
+                auto const& amdgpu = dynamic_cast<AMDGPU const&>(hardware);
+                if(auto cached = m_cachesGroupedGemm.find(problems, amdgpu, numSolutions))
+                    return *cached;
 
-                solutions
+                auto found
                     = m_subLibrary->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
-                if(solutions.size() != 0)
-                    m_cachesGroupedGemm.add(solutions, problems, amdgpu);
+                if(!problems.empty() && problems[0].deterministicMode())
+                    removeNonDeterministic(found, problems[0]);
+                auto solutions = std::make_shared<SolutionVector<MySolution> const>(found);
+                m_cachesGroupedGemm.add(solutions, problems, amdgpu, numSolutions);
 
-                return solutions;
+                return *solutions;
             }
             catch(std::bad_cast const& exc)
             {
@@ -302,9 +347,76 @@ namespace TensileLite
         }
 
     private:
+        // The deterministic mode of a problem excludes solutions that reduce with atomics
+        template <typename Solutions>
+        static void removeNonDeterministic(Solutions& solutions, MyProblem const& problem)
+        {
+            for(auto it = solutions.begin(); it != solutions.end();)
+            {
+                if((*it)->isDeterministic(problem))
+                    ++it;
+                else
+                    it = solutions.erase(it);
+            }
+        }
+
+        /**
+         * The best numSolutions solutions whose workspace fits the budget of problem, and that
+         * are deterministic when the problem asks for it. They are picked from the candidates of
+         * the budget class, which are widened from the library only when filtering leaves fewer
+         * than numSolutions and more candidates may exist.
+         */
+        SolutionVector<MySolution> findFeasibleSolutions(MyProblem const& problem,
+                                                         AMDGPU const&    hardware,
+                                                         int              numSolutions) const
+        {
+            SolutionVector<MySolution> feasible;
+            if(numSolutions <= 0)
+                return feasible;
+            size_t wanted = numSolutions;
+
+            MyProblem budgetClass = problem;
+            budgetClass.setWorkspaceSize(workspaceBudgetClass(problem.workspaceSize()));
+
+            auto candidates = m_candidates.find(budgetClass, hardware);
+            while(true)
+            {
+                feasible.clear();
+                if(candidates)
+                {
+                    for(auto const& solution : candidates->solutions)
+                    {
+                        if(solution->requiredWorkspaceSize(problem, hardware)
+                           > problem.workspaceSize())
+                            continue;
+                        if(problem.deterministicMode() && !solution->isDeterministic(problem))
+                            continue;
+                        feasible.push_back(solution);
+                        if(feasible.size() == wanted)
+                            break;
+                    }
+                    if(feasible.size() == wanted || candidates->exhaustive)
+                        break;
+                }
+
+                int fetch = numSolutions;
+                if(candidates)
+                    fetch = std::max<int>(candidates->solutions.size() * 2, numSolutions);
+
+                auto widened        = std::make_shared<Candidates>();
+                widened->solutions  = m_subLibrary->findTopSolutions(budgetClass, hardware, fetch);
+                widened->exhaustive = widened->solutions.size() < static_cast<size_t>(fetch);
+                m_candidates.add(widened, budgetClass, hardware);
+                candidates = widened;
+            }
+
+            return feasible;
+        }
+
         std::shared_ptr<Library>  m_subLibrary;
         mutable Cache             m_cache;
         mutable Caches            m_caches;
+        mutable CandidateCaches   m_candidates;
         mutable CachesGroupedGemm m_cachesGroupedGemm;
     };
 
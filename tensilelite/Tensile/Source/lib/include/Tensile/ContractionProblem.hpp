@@ -138,6 +138,17 @@ namespace TensileLite
             return m_activationType;
         }
 
+        // CUs the gemm may use, 0 for all CUs of the device. Only sizes the stream-K grid.
+        void setAvailableCUs(uint16_t cus)
+        {
+            m_availableCUs = cus;
+        }
+
+        uint16_t availableCUs() const
+        {
+            return m_availableCUs;
+        }
+
         void resetInternalArgs()
         {
             m_gsu = 0;
@@ -153,6 +164,7 @@ namespace TensileLite
         DataType       m_biasType       = DataType::None;
         int            m_factorDim      = 0;
         ActivationType m_activationType = ActivationType::None;
+        uint16_t       m_availableCUs   = 0; // default value
     };
 
     /**
@@ -29,7 +29,9 @@
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <Tensile/Tensile.hpp>
@@ -44,6 +46,8 @@
 
 namespace TensileLite
 {
+    struct AMDGPU;
+
     template <typename TAct>
     struct DeviceUserArguments
     {
@@ -151,6 +155,50 @@ namespace TensileLite
         bool globalSplitUWorkGroupMappingRoundRobin = false;
     };
 
+    /**
+ * Predicted stream-K grid sizes of one solution, keyed by everything the grid depends on
+ * besides the process wide TENSILE_STREAMK_* settings. Copies start empty.
+ */
+    class StreamKGridCache
+    {
+    public:
+        struct Key
+        {
+            size_t tiles; // tiles launched for the problem
+            size_t outputTiles; // tiles seen by the grid size prediction
+            size_t itersPerTile;
+            size_t cuCount;
+
+            bool operator==(Key const& rhs) const
+            {
+                return tiles == rhs.tiles && outputTiles == rhs.outputTiles
+                       && itersPerTile == rhs.itersPerTile && cuCount == rhs.cuCount;
+            }
+        };
+
+        // Dynamic shapes keep adding keys, so the cache starts over once it holds this many
+        static constexpr size_t MaxEntries = 4096;
+
+        StreamKGridCache() = default;
+        StreamKGridCache(StreamKGridCache const&) {}
+        StreamKGridCache& operator=(StreamKGridCache const&)
+        {
+            return *this;
+        }
+
+        bool find(Key const& key, size_t& grid) const;
+        void insert(Key const& key, size_t grid);
+
+    private:
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const;
+        };
+
+        mutable std::mutex                       m_access;
+        std::unordered_map<Key, size_t, KeyHash> m_grids;
+    };
+
     /**
  * Represents a single kernel or set of kernels that can perform a single
  * tensor contraction.
@@ -272,6 +320,12 @@ namespace TensileLite
                                            std::ostream&             stream,
                                            bool                      debug = false) const;
 
+        /**
+   * Whether repeated runs of problem write bitwise identical results. Stream-K with an
+   * atomic fixup and GSU accumulating the splits with atomics are not.
+   */
+        bool isDeterministic(Problem const& problem) const;
+
         /**
    * Calculate required workspace size.
    */
@@ -281,7 +335,20 @@ namespace TensileLite
         size_t requiredHostSizeGroupedGemmSingle(Problem const&  problem,
                                                  Hardware const& hardware) const;
 
+        /**
+   * Stream-K grid size. The predicted grid of TENSILE_STREAMK_DYNAMIC_GRID=3 is cached per
+   * tile count, iterations per tile and CU count, the others are computed directly. The
+   * problem's availableCUs() param, when set, lowers the CU count the grid is sized for.
+   */
         size_t getSKGrid(Problem const& problem, Hardware const& hardware, size_t tiles) const;
+        // Uncached stream-K grid size for cuCount CUs and an x by y by z problem
+        size_t getSKGrid(AMDGPU const& gpu,
+                         size_t        tiles,
+                         size_t        cuCount,
+                         size_t        x,
+                         size_t        y,
+                         size_t        z,
+                         size_t        batch) const;
         size_t partialTileSize(size_t skGrid) const;
 
         static float computeGranularity(float x);
@@ -552,6 +619,8 @@ namespace TensileLite
         LinearModel           linearModel;
         MatchingTag           tag{MatchingTag::Estimated};
 
+        mutable StreamKGridCache skGridCache;
+
         uint32_t magicNumberAlg1(uint32_t x, uint32_t* magicShift) const;
         uint32_t magicNumberAlg2(uint32_t x, uint32_t* magicShift) const;
         uint32_t magicNumber(int magicDivAlg, uint32_t x, uint32_t* magicShift) const;
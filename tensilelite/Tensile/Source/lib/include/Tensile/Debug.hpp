@@ -91,6 +91,12 @@ namespace TensileLite
 
         bool gridBasedBatchExp() const;
 
+        // Bytes of lazily loaded code objects kept resident, 0 for no limit
+        size_t getCodeObjectBudget() const;
+
+        // Threads loading code objects in parallel, 0 for the default
+        size_t getCodeObjectLoadThreads() const;
+
         __attribute__((always_inline)) inline void markerStart(const char* name) const
         {
 #ifdef Tensile_ENABLE_MARKER
@@ -139,7 +145,35 @@ namespace TensileLite
         bool        m_gridbasedKdTree     = false;
         bool        m_gridbasedBatchExp   = false;
         bool        m_printMarker         = false;
+        size_t      m_codeObjectBudget    = 0;
+        size_t      m_codeObjectThreads   = 0;
 
         Debug();
     };
+
+    /**
+ * @brief Marker range covering the lifetime of the scope, so that early returns and
+ * exceptions still pop the range.
+ */
+    class ScopedMarker
+    {
+    public:
+        explicit ScopedMarker(const char* name)
+        {
+            Debug::Instance().markerStart(name);
+        }
+
+        ScopedMarker(const char* name, const std::string& payload)
+        {
+            Debug::Instance().markerStart(name, payload);
+        }
+
+        ~ScopedMarker()
+        {
+            Debug::Instance().markerStop();
+        }
+
+        ScopedMarker(const ScopedMarker&)            = delete;
+        ScopedMarker& operator=(const ScopedMarker&) = delete;
+    };
 } // namespace TensileLite
@@ -27,10 +27,14 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
+#include <iostream>
 #include <map>
 #include <memory>
 
 #include <Tensile/Debug.hpp>
+#include <Tensile/Metrics.hpp>
+#include <Tensile/SolutionIndexDirectory.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 #include <Tensile/Tensile.hpp>
 
@@ -51,6 +55,8 @@ namespace TensileLite
         // If lazy loading is used, this may be updated in const functions
         SolutionMap<MySolution>* solutions;
         std::mutex*              solutionsGuard;
+        // Loaders of the placeholder libraries, keyed by file prefix
+        std::map<std::string, std::function<void()>>* placeholders;
     };
 
     /**
@@ -89,13 +95,66 @@ namespace TensileLite
         std::string                                             version;
         mutable std::mutex                                      solutionsGuard;
 
+        // Lazy loading only: the placeholder libraries by file prefix, the file this library
+        // was read from, where its solution index directory is shipped, and the writable
+        // location it is cached in when the shipped one is missing or stale.
+        std::map<std::string, std::function<void()>> placeholders;
+        std::string                                  libraryFile;
+        std::string                                  indexDirectoryFile;
+        std::string                                  indexDirectoryCacheFile;
+
         MasterSolutionLibrary() = default;
 
+        /**
+         * Makes the solution with this index resident by loading only the placeholder library
+         * that holds it. Returns false if no library holds the index.
+         */
+        bool loadSolutionByIndex(int index) const
+        {
+            if(placeholders.empty())
+                return solutions.find(index) != solutions.end();
+            {
+                std::lock_guard<std::mutex> guard(solutionsGuard);
+                if(solutions.find(index) != solutions.end())
+                    return true;
+            }
+
+            std::string const* prefix;
+            {
+                std::lock_guard<std::mutex> guard(indexDirectoryGuard);
+                buildIndexDirectory();
+                prefix = indexDirectory.find(index);
+            }
+            auto loader = prefix ? placeholders.find(*prefix) : placeholders.end();
+            if(loader == placeholders.end())
+                return false;
+            loader->second();
+
+            std::lock_guard<std::mutex> guard(solutionsGuard);
+            return solutions.find(index) != solutions.end();
+        }
+
+        // Largest solution index of the whole library, including placeholders not yet loaded.
+        int lastSolutionIndex() const
+        {
+            int last = -1;
+            if(!placeholders.empty())
+            {
+                std::lock_guard<std::mutex> guard(indexDirectoryGuard);
+                buildIndexDirectory();
+                last = indexDirectory.lastIndex();
+            }
+            std::lock_guard<std::mutex> guard(solutionsGuard);
+            if(!solutions.empty())
+                last = std::max(last, solutions.rbegin()->first);
+            return last;
+        }
+
         virtual std::shared_ptr<MySolution> getSolutionByIndex(MyProblem const& problem,
                                                                Hardware const&  hardware,
                                                                const int index) const override
         {
-            if(solutions.find(index) == solutions.end())
+            if(!loadSolutionByIndex(index))
             {
                 return std::shared_ptr<MySolution>();
             }
@@ -111,7 +170,7 @@ namespace TensileLite
         virtual std::shared_ptr<MySolution> getSolutionByIndex(Hardware const& hardware,
                                                                const int       index) const override
         {
-            if(solutions.find(index) == solutions.end())
+            if(!loadSolutionByIndex(index))
             {
                 return std::shared_ptr<MySolution>();
             }
@@ -152,6 +211,8 @@ namespace TensileLite
                                                              double*          fitness
                                                              = nullptr) const override
         {
+            ScopedMarker      marker("findBestSolution");
+            ScopedMetricTimer timer(MetricTimer::HeuristicSelection);
             if(Debug::Instance().printSolutionSelectionTime())
             {
                 auto start  = std::chrono::steady_clock::now();
@@ -231,6 +292,8 @@ namespace TensileLite
                                                             Hardware const&  hardware,
                                                             int numSolutions) const override
         {
+            ScopedMarker      marker("findTopSolutions");
+            ScopedMetricTimer timer(MetricTimer::HeuristicSelection);
             return library->findTopSolutions(problem, hardware, numSolutions);
         }
 
@@ -239,8 +302,67 @@ namespace TensileLite
                                         Hardware const&               hardware,
                                         int                           numSolutions) const override
         {
+            ScopedMarker      marker("findTopSolutionsGroupedGemm");
+            ScopedMetricTimer timer(MetricTimer::HeuristicSelection);
             return library->findTopSolutionsGroupedGemm(problems, hardware, numSolutions);
         }
+
+    private:
+        /**
+         * Reads the index directory from indexDirectoryFile, then from indexDirectoryCacheFile.
+         * If both are missing or were built from a different library file, every placeholder
+         * library is loaded once to build it and the result is written to
+         * indexDirectoryCacheFile for later processes. Called with indexDirectoryGuard.
+         */
+        void buildIndexDirectory() const
+        {
+            if(indexDirectoryBuilt)
+                return;
+            indexDirectoryBuilt = true;
+
+            ScopedMarker marker("buildIndexDirectory");
+            auto         stamp = SolutionIndexDirectory::SourceStamp(libraryFile);
+            if(!stamp.empty())
+                for(auto const* file : {&indexDirectoryFile, &indexDirectoryCacheFile})
+                    if(!file->empty() && indexDirectory.load(*file, stamp))
+                        return;
+
+            for(auto const& placeholder : placeholders)
+                placeholder.second();
+
+            std::lock_guard<std::mutex> guard(solutionsGuard);
+            indexDirectory.clear();
+            int         first = -1, last = -1;
+            std::string prefix;
+            for(auto const& entry : solutions)
+            {
+                // Placeholder solutions are tagged with the code object "<prefix>.co"
+                auto const& coFile = entry.second->codeObjectFilename;
+                if(coFile.size() <= 3 || coFile.compare(coFile.size() - 3, 3, ".co") != 0)
+                    continue;
+                auto entryPrefix = coFile.substr(0, coFile.size() - 3);
+                if(entryPrefix != prefix)
+                {
+                    if(!prefix.empty())
+                        indexDirectory.add(first, last, prefix);
+                    prefix = entryPrefix;
+                    first  = entry.first;
+                }
+                last = entry.first;
+            }
+            if(!prefix.empty())
+                indexDirectory.add(first, last, prefix);
+
+            if(!stamp.empty() && !indexDirectoryCacheFile.empty()
+               && !indexDirectory.save(indexDirectoryCacheFile, stamp)
+               && Debug::Instance().printCodeObjectInfo())
+                std::cout << "could not write solution index directory "
+                          << indexDirectoryCacheFile << std::endl;
+        }
+
+        mutable std::mutex             indexDirectoryGuard;
+        mutable bool                   indexDirectoryBuilt = false;
+        mutable SolutionIndexDirectory indexDirectory;
     };
 
 } // namespace TensileLite
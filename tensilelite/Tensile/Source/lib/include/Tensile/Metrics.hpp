@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <Tensile/Singleton.hpp>
+
+namespace TensileLite
+{
+    /**
+ * Host side stages of a gemm call whose latency is recorded.
+ */
+    enum class MetricTimer : int
+    {
+        ProblemConstruction,
+        CacheLookup,
+        HeuristicSelection,
+        ArgumentBuilding,
+        CodeObjectLoading,
+        KernelLaunch,
+        Count
+    };
+
+    /**
+ * Plain event counters.
+ */
+    enum class MetricCounter : int
+    {
+        CacheHits,
+        CacheMisses,
+        CodeObjectsLoaded,
+        CodeObjectsEvicted,
+        KernelsLaunched,
+        Count
+    };
+
+    std::string ToString(MetricTimer timer);
+    std::string ToString(MetricCounter counter);
+
+    struct MetricSnapshot
+    {
+        static constexpr int HistogramBuckets = 24;
+
+        // Upper bound of histogram bucket i: 128 ns << i. The last bucket is open ended.
+        static constexpr uint64_t BucketBoundNs(int i)
+        {
+            return uint64_t(128) << i;
+        }
+
+        std::string name;
+        bool        timed   = false; // false for counters, which only have count
+        uint64_t    count   = 0;
+        uint64_t    totalNs = 0;
+        uint64_t    maxNs   = 0;
+
+        std::array<uint64_t, HistogramBuckets> histogram{};
+
+        // Upper bucket bound below which the given fraction of the samples fall
+        uint64_t percentileNs(double fraction) const;
+    };
+
+    /**
+ * Process wide registry of host overhead counters and latency histograms.
+ *
+ * Recording is off unless HIPBLASLT_METRICS is set to a nonzero value or it is enabled
+ * through setEnabled(), and a disabled registry costs one relaxed atomic load per call
+ * site. All updates are relaxed atomics, so snapshots taken while other threads record
+ * are consistent per field only. When HIPBLASLT_METRICS_FILE is set the registry is
+ * dumped to that file at process exit.
+ */
+    class Metrics : public LazySingleton<Metrics>
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        ~Metrics();
+
+        bool enabled() const
+        {
+            return m_enabled.load(std::memory_order_relaxed);
+        }
+
+        void setEnabled(bool enabled)
+        {
+            m_enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        void record(MetricTimer timer, uint64_t ns);
+
+        void increment(MetricCounter counter, uint64_t n = 1)
+        {
+            if(enabled())
+                m_counters[int(counter)].fetch_add(n, std::memory_order_relaxed);
+        }
+
+        std::vector<MetricSnapshot> snapshot() const;
+        void                        reset();
+        void                        dump(std::ostream& stream) const;
+
+    private:
+        friend LazySingleton<Metrics>;
+
+        Metrics();
+
+        struct Histogram
+        {
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> totalNs{0};
+            std::atomic<uint64_t> maxNs{0};
+
+            std::array<std::atomic<uint64_t>, MetricSnapshot::HistogramBuckets> buckets{};
+        };
+
+        std::atomic<bool> m_enabled{false};
+        std::string       m_dumpFile;
+
+        std::array<Histogram, int(MetricTimer::Count)>               m_timers;
+        std::array<std::atomic<uint64_t>, int(MetricCounter::Count)> m_counters{};
+    };
+
+    /**
+ * Records the lifetime of the scope into a timer, reading the clock only when metrics
+ * are enabled.
+ */
+    class ScopedMetricTimer
+    {
+    public:
+        explicit ScopedMetricTimer(MetricTimer timer)
+            : m_timer(timer)
+            , m_enabled(Metrics::Instance().enabled())
+        {
+            if(m_enabled)
+                m_start = Metrics::Clock::now();
+        }
+
+        ~ScopedMetricTimer()
+        {
+            if(m_enabled)
+            {
+                auto elapsed = Metrics::Clock::now() - m_start;
+                Metrics::Instance().record(
+                    m_timer,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+
+        ScopedMetricTimer(const ScopedMetricTimer&)            = delete;
+        ScopedMetricTimer& operator=(const ScopedMetricTimer&) = delete;
+
+    private:
+        MetricTimer                m_timer;
+        bool                       m_enabled;
+        Metrics::Clock::time_point m_start;
+    };
+} // namespace TensileLite
@@ -138,7 +138,8 @@ namespace TensileLite
             // If condition in case two threads got into this function
             if(!library)
             {
-                std::string path       = (libraryDirectory + "/" + filePrefix + suffix).c_str();
+                ScopedMarker marker("loadPlaceholderLibrary", filePrefix);
+                std::string  path = (libraryDirectory + "/" + filePrefix + suffix).c_str();
                 auto        newLibrary = LoadLibraryFile<MyProblem, MySolution>(path);
                 auto        mLibrary
                     = static_cast<MasterSolutionLibrary<MyProblem, MySolution>*>(newLibrary.get());
@@ -57,6 +57,9 @@ namespace TensileLite
                     auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
                     lib.masterSolutions = ctx->solutions;
                     lib.solutionsGuard  = ctx->solutionsGuard;
+                    if(ctx->placeholders)
+                        (*ctx->placeholders)[lib.filePrefix]
+                            = [&lib]() { lib.loadPlaceholderLibrary(); };
 
                     //Extract directory where TensileLibrary.dat/yaml file is located
                     lib.libraryDirectory = ctx->filename;
@@ -163,6 +163,8 @@ namespace TensileLite
                     auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
                     ctx->solutions      = &lib.solutions;
                     ctx->solutionsGuard = &lib.solutionsGuard;
+                    ctx->placeholders   = &lib.placeholders;
+                    lib.libraryFile     = ctx->filename;
                 }
 
                 std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> innerLibrary;
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace TensileLite
+{
+    /**
+ * Maps ranges of solution indices of a lazy loading library to the file prefix of the
+ * placeholder library that holds them, so that an index lookup only needs to load one
+ * placeholder library and its code object.
+ *
+ * The directory is kept in a small text file stamped with the size and a hash of the
+ * contents of the library file it was built from; a file with a different stamp is ignored.
+ * The stamp survives copying and installing the library, so a directory shipped next to it
+ * stays valid.
+ */
+    class SolutionIndexDirectory
+    {
+    public:
+        void clear();
+        bool empty() const;
+
+        // Adds [first, last] to the ranges held by prefix.
+        void add(int first, int last, std::string const& prefix);
+
+        // Returns the prefix holding index, or nullptr when no range contains it.
+        std::string const* find(int index) const;
+
+        // Largest index of any range, -1 when empty.
+        int lastIndex() const;
+
+        bool load(std::string const& path, std::string const& stamp);
+        // Writes through a temporary file, so concurrent readers never see a partial file.
+        // Creates the parent directory if needed.
+        bool save(std::string const& path, std::string const& stamp) const;
+
+        // Stamp identifying the current contents of libraryFile.
+        static std::string SourceStamp(std::string const& libraryFile);
+
+        // Per-user location for the directory of libraryFile, under $XDG_CACHE_HOME or
+        // $HOME/.cache. Used when no directory is shipped next to a read-only library.
+        static std::string UserCachePath(std::string const& libraryFile);
+
+    private:
+        std::map<int, std::pair<int, std::string>> m_ranges;
+    };
+} // namespace TensileLite
@@ -48,5 +48,7 @@ namespace TensileLite
         std::shared_ptr<Hardware> GetCurrentDevice();
         std::shared_ptr<Hardware> GetDevice(int deviceId);
         std::shared_ptr<Hardware> GetDevice(hipDeviceProp_t const& prop);
+        // Device whose gemms may only use availableCUs of its CUs, 0 for all of them
+        std::shared_ptr<Hardware> GetDevice(hipDeviceProp_t const& prop, int availableCUs);
     } // namespace hip
 } // namespace TensileLite
@@ -31,7 +31,10 @@
 #include <hip/hip_runtime.h>
 #include <unordered_set>
 
+#include <atomic>
+#include <list>
 #include <mutex>
+#include <shared_mutex>
 
 namespace TensileLite
 {
@@ -40,6 +43,26 @@ namespace TensileLite
         class SolutionAdapter : public TensileLite::SolutionAdapter
         {
         public:
+            /**
+             * Code object residency counters. Only code objects loaded on demand
+             * through FindCodeObject() can be evicted; they are unloaded least
+             * recently used first once their total size exceeds the budget, which
+             * starts at Debug::getCodeObjectBudget().
+             *
+             * Before unloading, eviction waits for the last launch this adapter made
+             * on each stream. It is skipped while the launching stream is capturing,
+             * and a code object with a kernel captured into a graph is never evicted,
+             * since the graph keeps the kernel handle.
+             */
+            struct ResidencyStats
+            {
+                size_t loadedModules  = 0;
+                size_t residentBytes  = 0;
+                size_t evictedModules = 0;
+                size_t evictedBytes   = 0;
+                size_t reloads        = 0;
+            };
+
             SolutionAdapter();
             SolutionAdapter(bool debug);
             SolutionAdapter(bool debug, std::string const& name);
@@ -52,6 +75,13 @@ namespace TensileLite
 
             hipError_t loadCodeObjectFile(std::string const& path);
 
+            /**
+             * Loads the code object files on a pool of threads, each reading its file and
+             * creating the module, then publishes the modules in the order given. Files that
+             * fail to load are skipped and the first error is returned.
+             */
+            hipError_t loadCodeObjectFiles(std::vector<std::string> const& paths);
+
             hipError_t initializeLazyLoading(std::string architecture, std::string codeObjectDir);
 
             hipError_t loadCodeObject(const void* image);
@@ -87,20 +117,68 @@ namespace TensileLite
 
             hipError_t initKernels(std::vector<std::string> const& kernelNames);
 
-        private:
-            hipError_t getKernel(hipFunction_t& rv, std::string const& name);
+            ResidencyStats residencyStats() const;
 
-            std::mutex m_access;
+            // Budget in bytes for code objects loaded on demand, 0 for no limit
+            void setCodeObjectBudget(size_t bytes);
 
-            std::vector<hipModule_t>                       m_modules;
-            std::unordered_map<std::string, hipFunction_t> m_kernels;
-            bool                                           m_debug           = false;
-            bool                                           m_debugSkipLaunch = false;
-            std::string                                    m_name            = "HipSolutionAdapter";
-            std::string                                    m_codeObjectDirectory;
+        private:
+            struct LoadedModule
+            {
+                hipModule_t module = nullptr;
+                std::string coFile;
+                size_t      bytes     = 0;
+                uint64_t    lastUse   = 0;
+                bool        evictable = false;
+            };
+
+            struct CachedKernel
+            {
+                hipFunction_t function = nullptr;
+                LoadedModule* owner    = nullptr;
+            };
+
+            hipError_t getKernel(hipFunction_t&     rv,
+                                 std::string const& name,
+                                 LoadedModule**     owner = nullptr);
+
+            // canEvict is false when the caller's stream is capturing
+            bool FindCodeObject(std::string const& codeObjectFile, bool canEvict);
+
+            hipError_t
+                loadCodeObjectFile(std::string const& path, bool evictable, bool canEvict = true);
+
+            // Records the launch of a kernel of owner on stream, m_access must not be held
+            void recordLaunch(LoadedModule* owner, hipStream_t stream);
+
+            // Records a loaded module, m_access must be held
+            LoadedModule* addModule(hipModule_t        module,
+                                    std::string const& coFile,
+                                    size_t             bytes,
+                                    bool               evictable);
+
+            void enforceBudget(LoadedModule const* keep);
+
+            mutable std::mutex m_access;
+            // Held shared from kernel lookup through launch, unique while unloading
+            std::shared_mutex m_residency;
+
+            // std::list keeps the owner pointers in m_kernels stable across eviction
+            std::list<LoadedModule>                       m_modules;
+            std::unordered_map<std::string, CachedKernel> m_kernels;
+            bool                                          m_debug            = false;
+            bool                                          m_debugSkipLaunch  = false;
+            std::string                                   m_name             = "HipSolutionAdapter";
+            std::string                                   m_codeObjectDirectory;
+            std::atomic<size_t>                           m_codeObjectBudget{0};
+            uint64_t                                      m_useTick          = 0;
+            // Event after the last launch on each stream, waited for before eviction
+            std::unordered_map<hipStream_t, hipEvent_t> m_streamEvents;
 
             std::vector<std::string>        m_loadedModuleNames;
             std::unordered_set<std::string> m_loadedCOFiles;
+            std::unordered_set<std::string> m_evictedCOFiles;
+            ResidencyStats                  m_stats;
 
             friend std::ostream& operator<<(std::ostream& stream, SolutionAdapter const& adapter);
         };
@@ -75,7 +75,10 @@ namespace TensileLite
     {
         std::ostringstream rv;
 
-        rv << deviceName << "(" << computeUnitCount << "-CU " << processor << ")";
+        rv << deviceName << "(" << computeUnitCount << "-CU " << processor;
+        if(availableCUs() != computeUnitCount)
+            rv << ", " << availableCUs() << " CUs available";
+        rv << ")";
 
         return rv.str();
     }
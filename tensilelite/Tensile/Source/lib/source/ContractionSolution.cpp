@@ -29,7 +29,9 @@
 #include <Tensile/hip/HipUtils.hpp>
 
 #include <Tensile/AMDGPU.hpp>
+#include <Tensile/Comparison.hpp>
 #include <Tensile/ContractionProblem.hpp>
+#include <Tensile/Metrics.hpp>
 #include <Tensile/Utils.hpp>
 
 #include <algorithm>
@@ -2491,6 +2493,8 @@ namespace TensileLite
                                    ContractionSolution::Inputs const&  inputs,
                                    Hardware const&                     hardware) const
     {
+        ScopedMarker      marker("ContractionSolution::solve");
+        ScopedMetricTimer timer(MetricTimer::ArgumentBuilding);
         if(Debug::Instance().printWinningKernelName())
             std::cout << "Running kernel: " << this->KernelName() << std::endl;
 
@@ -2621,6 +2625,8 @@ namespace TensileLite
         size_t                                           hipHostMemorySize,
         hipStream_t                                      stream) const
     {
+        ScopedMarker      marker("ContractionSolution::solveGroupedGemm");
+        ScopedMetricTimer timer(MetricTimer::ArgumentBuilding);
         if(Debug::Instance().printWinningKernelName())
             std::cout << "Running kernel: " << this->KernelName() << std::endl;
 
@@ -2756,6 +2762,8 @@ namespace TensileLite
                                                  const void*                 workspace,
                                                  hipStream_t                 stream) const
     {
+        ScopedMarker      marker("ContractionSolution::solveGroupedGemmGPU");
+        ScopedMetricTimer timer(MetricTimer::ArgumentBuilding);
         if(!problemType.supportDeviceUserArguments)
         {
             throw std::runtime_error("Currently this solution does not support user args.");
@@ -2809,8 +2817,9 @@ namespace TensileLite
             static_cast<void>(hipHostMalloc(dUAHost, requiredSize, 0));
             setDeviceUserArgs(problems, inputs, (DeviceUserArguments<float>*)(*dUAHost));
             static_cast<void>(hipMalloc(dUA, requiredSize));
-            static_cast<void>(hipMemcpy(*dUA, *dUAHost, requiredSize, hipMemcpyHostToDevice));
-            static_cast<void>(hipDeviceSynchronize());
+            // Ordered before the gemm on the same stream, so no device wide synchronization
+            static_cast<void>(
+                hipMemcpyAsync(*dUA, *dUAHost, requiredSize, hipMemcpyHostToDevice, stream));
         }
         else
         {
@@ -2940,6 +2949,18 @@ namespace TensileLite
         return pass;
     }
 
+    bool ContractionSolution::isDeterministic(Problem const& problem) const
+    {
+        if(sizeMapping.streamK != 0)
+            return sizeMapping.streamKAtomic == 0;
+
+        auto gsu
+            = problem.getParams().gsu() > 0 ? problem.getParams().gsu() : sizeMapping.globalSplitU;
+        // MultipleBuffer modes reduce the partial results of the splits in a fixed order
+        return gsu <= 1 || sizeMapping.globalAccumulation == 2
+               || sizeMapping.globalAccumulation == 3;
+    }
+
     size_t ContractionSolution::requiredWorkspaceSize(Problem const&  problem,
                                                       Hardware const& hardware) const
     {
@@ -3039,6 +3060,31 @@ namespace TensileLite
         return h_args.size();
     }
 
+    bool StreamKGridCache::find(Key const& key, size_t& grid) const
+    {
+        std::lock_guard<std::mutex> lock(m_access);
+
+        auto it = m_grids.find(key);
+        if(it == m_grids.end())
+            return false;
+        grid = it->second;
+        return true;
+    }
+
+    void StreamKGridCache::insert(Key const& key, size_t grid)
+    {
+        std::lock_guard<std::mutex> lock(m_access);
+
+        if(m_grids.size() >= MaxEntries)
+            m_grids.clear();
+        m_grids[key] = grid;
+    }
+
+    size_t StreamKGridCache::KeyHash::operator()(Key const& key) const
+    {
+        return hash_combine(key.tiles, key.outputTiles, key.itersPerTile, key.cuCount);
+    }
+
     size_t ContractionSolution::getSKGrid(Problem const&  problem,
                                           Hardware const& hardware,
                                           size_t          tiles) const
@@ -3055,23 +3101,77 @@ namespace TensileLite
         AMDGPU const* pAMDGPU = dynamic_cast<AMDGPU const*>(&hardware);
 
         assert(pAMDGPU != nullptr && pAMDGPU->computeUnitCount != 0);
-        size_t cuCount = pAMDGPU->computeUnitCount;
+        size_t cuCount = pAMDGPU->availableCUs();
+
+        // Size the grid for the CUs left to this gemm, e.g. by a CU mask or by
+        // communication kernels running next to it.
+        size_t availableCUs = problem.getParams().availableCUs();
+        if(availableCUs > 0)
+            cuCount = min(cuCount, availableCUs);
+
+        size_t x     = 1;
+        size_t y     = 1;
+        size_t batch = 1;
+        for(size_t i = 0; i < problem.freeIndicesA().size(); i++)
+        {
+            x *= problem.freeSizeA(i);
+        }
+        for(size_t i = 0; i < problem.freeIndicesB().size(); i++)
+        {
+            y *= problem.freeSizeB(i);
+        }
+        for(size_t i = 0; i < problem.batchIndices().size(); ++i)
+        {
+            batch *= problem.batchSize(i);
+        }
+
+        // Only the predicted grid is worth the lock of the cache, the others are a few
+        // integer operations
+        if(pAMDGPU->skFixedGrid > 0 || pAMDGPU->skDynamicGrid != 3)
+            return getSKGrid(*pAMDGPU, tiles, cuCount, x, y, z, batch);
+
+        StreamKGridCache::Key key{
+            tiles,
+            streamk::number_of_output_tiles(
+                sizeMapping.macroTile.x, sizeMapping.macroTile.y, x, y, batch),
+            streamk::num_iters_per_tile(sizeMapping.depthU, z),
+            cuCount};
+
+        // The grid prediction prints every candidate, so it is not cached when debugging
+        static const bool debug = Debug::Instance().printStreamKGridInfo();
+
+        size_t skGrid;
+        if(!debug && skGridCache.find(key, skGrid))
+            return skGrid;
 
+        skGrid = getSKGrid(*pAMDGPU, tiles, cuCount, x, y, z, batch);
+        skGridCache.insert(key, skGrid);
+        return skGrid;
+    }
+
+    size_t ContractionSolution::getSKGrid(AMDGPU const& gpu,
+                                          size_t        tiles,
+                                          size_t        cuCount,
+                                          size_t        x,
+                                          size_t        y,
+                                          size_t        z,
+                                          size_t        batch) const
+    {
         // User-specified grid size for Stream-K kernel.
-        if(pAMDGPU->skFixedGrid > 0)
+        if(gpu.skFixedGrid > 0)
         {
-            return pAMDGPU->skFixedGrid;
+            return gpu.skFixedGrid;
         }
 
         // Dynamically pick the minimum between the cuCount or number of tiles.
-        else if(pAMDGPU->skDynamicGrid == 1)
+        else if(gpu.skDynamicGrid == 1)
         {
             return min(cuCount, tiles);
         }
 
         // Dynamically pick the minimum between the cuCount or number of tiles,
         // and scale down really large sizes to use fewer CUs for power/energy savings.
-        else if(pAMDGPU->skDynamicGrid == 2)
+        else if(gpu.skDynamicGrid == 2)
         {
             size_t skGrid = cuCount;
             if(tiles > skGrid)
@@ -3097,24 +3197,8 @@ namespace TensileLite
         // step and the cost of processing MAC-loop instructions. When the cost of fix-up
         // is the bottleneck, use smaller grid size.
         // Architecture dependent.
-        else if(pAMDGPU->skDynamicGrid == 3)
+        else if(gpu.skDynamicGrid == 3)
         {
-            size_t x = 1;
-            size_t y = 1;
-            size_t batch = 1;
-            for(size_t i = 0; i < problem.freeIndicesA().size(); i++)
-            {
-                x *= problem.freeSizeA(i);
-            }
-            for(size_t i = 0; i < problem.freeIndicesB().size(); i++)
-            {
-                y *= problem.freeSizeB(i);
-            }
-            for(size_t i = 0; i < problem.batchIndices().size(); ++i)
-            {
-                batch *= problem.batchSize(i);
-            }
-
             return streamk::best_predicted_grid_size(sizeMapping.macroTile.x,
                                                      sizeMapping.macroTile.y,
                                                      sizeMapping.depthU,
@@ -3128,16 +3212,16 @@ namespace TensileLite
 
         // Limit the CUs Stream-K is launched on either max or the specified,
         // whichever is minimum.
-        else if(pAMDGPU->skMaxCUs > 0)
+        else if(gpu.skMaxCUs > 0)
         {
-            return min(cuCount, pAMDGPU->skMaxCUs);
+            return min(cuCount, gpu.skMaxCUs);
         }
 
         // Multiply the cuCount with a constant factor (c), and launch
         // c * cuCount number of workgroups for Stream-K.
-        else if(pAMDGPU->skGridMultiplier > 1)
+        else if(gpu.skGridMultiplier > 1)
         {
-            return cuCount * pAMDGPU->skGridMultiplier;
+            return cuCount * gpu.skGridMultiplier;
         }
 
         // If no option is specified, launch exactly cuCount worth of workgroups.
@@ -3176,7 +3260,7 @@ namespace TensileLite
         AMDGPU const* pAMDGPU = dynamic_cast<AMDGPU const*>(&hardware);
         assert(pAMDGPU);
 
-        double NumCUs        = pAMDGPU->computeUnitCount;
+        double NumCUs        = pAMDGPU->availableCUs();
         double wavefrontSize = pAMDGPU->wavefrontSize;
         double simdPerCu     = pAMDGPU->simdPerCu;
 
@@ -165,6 +165,16 @@ namespace TensileLite
         return m_gridbasedBatchExp;
     }
 
+    size_t Debug::getCodeObjectBudget() const
+    {
+        return m_codeObjectBudget;
+    }
+
+    size_t Debug::getCodeObjectLoadThreads() const
+    {
+        return m_codeObjectThreads;
+    }
+
     Debug::Debug()
         : m_value(DEBUG_SM)
         , m_value2(DEBUG_SM2)
@@ -217,7 +227,22 @@ namespace TensileLite
         if(tensile_gridbased_batch_exp)
             m_gridbasedBatchExp = strtol(tensile_gridbased_batch_exp, nullptr, 0) != 0;
 
+        const char* co_budget = std::getenv("TENSILE_CODE_OBJECT_BUDGET_MB");
+        if(!co_budget)
+            co_budget = std::getenv("HIPBLASLT_CODE_OBJECT_BUDGET_MB");
+        if(co_budget)
+            m_codeObjectBudget = size_t(strtoull(co_budget, nullptr, 0)) << 20;
+
+        const char* co_threads = std::getenv("TENSILE_CODE_OBJECT_LOAD_THREADS");
+        if(!co_threads)
+            co_threads = std::getenv("HIPBLASLT_CODE_OBJECT_LOAD_THREADS");
+        if(co_threads)
+            m_codeObjectThreads = strtoull(co_threads, nullptr, 0);
+
+        // hipBLASLt's marker switch also enables the nested Tensile ranges
         const char* tensile_marker = std::getenv("TENSILE_ENABLE_MARKER");
+        if(!tensile_marker)
+            tensile_marker = std::getenv("HIPBLASLT_ENABLE_MARKER");
         if(tensile_marker)
         {
             m_printMarker = strtol(tensile_marker, nullptr, 0) != 0;
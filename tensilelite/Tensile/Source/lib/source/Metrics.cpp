@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/Metrics.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+namespace TensileLite
+{
+    std::string ToString(MetricTimer timer)
+    {
+        switch(timer)
+        {
+        case MetricTimer::ProblemConstruction:
+            return "problem_construction";
+        case MetricTimer::CacheLookup:
+            return "cache_lookup";
+        case MetricTimer::HeuristicSelection:
+            return "heuristic_selection";
+        case MetricTimer::ArgumentBuilding:
+            return "argument_building";
+        case MetricTimer::CodeObjectLoading:
+            return "code_object_loading";
+        case MetricTimer::KernelLaunch:
+            return "kernel_launch";
+        case MetricTimer::Count:;
+        }
+        return "unknown";
+    }
+
+    std::string ToString(MetricCounter counter)
+    {
+        switch(counter)
+        {
+        case MetricCounter::CacheHits:
+            return "cache_hits";
+        case MetricCounter::CacheMisses:
+            return "cache_misses";
+        case MetricCounter::CodeObjectsLoaded:
+            return "code_objects_loaded";
+        case MetricCounter::CodeObjectsEvicted:
+            return "code_objects_evicted";
+        case MetricCounter::KernelsLaunched:
+            return "kernels_launched";
+        case MetricCounter::Count:;
+        }
+        return "unknown";
+    }
+
+    uint64_t MetricSnapshot::percentileNs(double fraction) const
+    {
+        uint64_t target = uint64_t(fraction * count);
+        uint64_t seen   = 0;
+        for(int i = 0; i < HistogramBuckets - 1; i++)
+        {
+            seen += histogram[i];
+            if(seen > target)
+                return BucketBoundNs(i);
+        }
+        return maxNs;
+    }
+
+    Metrics::Metrics()
+    {
+        const char* enable = std::getenv("HIPBLASLT_METRICS");
+        m_enabled          = enable && strtol(enable, nullptr, 0) != 0;
+
+        const char* dumpFile = std::getenv("HIPBLASLT_METRICS_FILE");
+        if(dumpFile)
+            m_dumpFile = dumpFile;
+    }
+
+    Metrics::~Metrics()
+    {
+        if(m_dumpFile.empty())
+            return;
+
+        std::ofstream file(m_dumpFile);
+        if(file)
+            dump(file);
+    }
+
+    void Metrics::record(MetricTimer timer, uint64_t ns)
+    {
+        Histogram& h = m_timers[int(timer)];
+
+        int bucket = 0;
+        while(bucket < MetricSnapshot::HistogramBuckets - 1
+              && ns >= MetricSnapshot::BucketBoundNs(bucket))
+            bucket++;
+
+        h.count.fetch_add(1, std::memory_order_relaxed);
+        h.totalNs.fetch_add(ns, std::memory_order_relaxed);
+        h.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t max = h.maxNs.load(std::memory_order_relaxed);
+        while(ns > max && !h.maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+            ;
+    }
+
+    std::vector<MetricSnapshot> Metrics::snapshot() const
+    {
+        std::vector<MetricSnapshot> rv;
+        for(int i = 0; i < int(MetricTimer::Count); i++)
+        {
+            Histogram const& h = m_timers[i];
+            MetricSnapshot   s;
+            s.name    = ToString(MetricTimer(i));
+            s.timed   = true;
+            s.count   = h.count.load(std::memory_order_relaxed);
+            s.totalNs = h.totalNs.load(std::memory_order_relaxed);
+            s.maxNs   = h.maxNs.load(std::memory_order_relaxed);
+            for(int b = 0; b < MetricSnapshot::HistogramBuckets; b++)
+                s.histogram[b] = h.buckets[b].load(std::memory_order_relaxed);
+            rv.push_back(s);
+        }
+        for(int i = 0; i < int(MetricCounter::Count); i++)
+        {
+            MetricSnapshot s;
+            s.name  = ToString(MetricCounter(i));
+            s.count = m_counters[i].load(std::memory_order_relaxed);
+            rv.push_back(s);
+        }
+        return rv;
+    }
+
+    void Metrics::reset()
+    {
+        for(auto& h : m_timers)
+        {
+            h.count.store(0, std::memory_order_relaxed);
+            h.totalNs.store(0, std::memory_order_relaxed);
+            h.maxNs.store(0, std::memory_order_relaxed);
+            for(auto& b : h.buckets)
+                b.store(0, std::memory_order_relaxed);
+        }
+        for(auto& c : m_counters)
+            c.store(0, std::memory_order_relaxed);
+    }
+
+    void Metrics::dump(std::ostream& stream) const
+    {
+        auto metrics = snapshot();
+
+        stream << std::left << std::setw(22) << "timer" << std::right << std::setw(12) << "count"
+               << std::setw(14) << "total_us" << std::setw(12) << "mean_us" << std::setw(12)
+               << "p50_us" << std::setw(12) << "p99_us" << std::setw(12) << "max_us"
+               << std::endl;
+        for(auto const& m : metrics)
+        {
+            if(!m.timed)
+                continue;
+            double mean = m.count ? double(m.totalNs) / m.count : 0.0;
+            stream << std::left << std::setw(22) << m.name << std::right << std::setw(12)
+                   << m.count << std::fixed << std::setprecision(3) << std::setw(14)
+                   << m.totalNs / 1000.0 << std::setw(12) << mean / 1000.0 << std::setw(12)
+                   << m.percentileNs(0.5) / 1000.0 << std::setw(12)
+                   << m.percentileNs(0.99) / 1000.0 << std::setw(12) << m.maxNs / 1000.0
+                   << std::defaultfloat << std::endl;
+        }
+
+        stream << std::endl << std::left << std::setw(22) << "counter" << std::right
+               << std::setw(12) << "count" << std::endl;
+        for(auto const& m : metrics)
+        {
+            if(m.timed)
+                continue;
+            stream << std::left << std::setw(22) << m.name << std::right << std::setw(12)
+                   << m.count << std::endl;
+        }
+    }
+} // namespace TensileLite
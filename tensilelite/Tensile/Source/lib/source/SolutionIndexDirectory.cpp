@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/SolutionIndexDirectory.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace TensileLite
+{
+    namespace
+    {
+        constexpr char const* DirectoryHeader = "tensile-solution-index-directory 2";
+
+        // 64-bit FNV-1a
+        constexpr uint64_t FnvOffset = 0xcbf29ce484222325ull;
+        constexpr uint64_t FnvPrime  = 0x100000001b3ull;
+
+        uint64_t fnv1a(char const* data, size_t size, uint64_t hash = FnvOffset)
+        {
+            for(size_t i = 0; i < size; i++)
+                hash = (hash ^ uint8_t(data[i])) * FnvPrime;
+            return hash;
+        }
+    }
+
+    void SolutionIndexDirectory::clear()
+    {
+        m_ranges.clear();
+    }
+
+    bool SolutionIndexDirectory::empty() const
+    {
+        return m_ranges.empty();
+    }
+
+    void SolutionIndexDirectory::add(int first, int last, std::string const& prefix)
+    {
+        m_ranges[first] = std::make_pair(last, prefix);
+    }
+
+    std::string const* SolutionIndexDirectory::find(int index) const
+    {
+        auto iter = m_ranges.upper_bound(index);
+        if(iter == m_ranges.begin())
+            return nullptr;
+        --iter;
+        if(index > iter->second.first)
+            return nullptr;
+        return &iter->second.second;
+    }
+
+    int SolutionIndexDirectory::lastIndex() const
+    {
+        return m_ranges.empty() ? -1 : m_ranges.rbegin()->second.first;
+    }
+
+    bool SolutionIndexDirectory::load(std::string const& path, std::string const& stamp)
+    {
+        std::ifstream file(path);
+        if(!file)
+            return false;
+
+        std::string header, fileStamp;
+        if(!std::getline(file, header) || header != DirectoryHeader
+           || !std::getline(file, fileStamp) || fileStamp != stamp)
+            return false;
+
+        std::map<int, std::pair<int, std::string>> ranges;
+        std::string                                 line;
+        while(std::getline(file, line))
+        {
+            std::istringstream entry(line);
+            int                first, last;
+            std::string        prefix;
+            if(!(entry >> first >> last >> prefix) || last < first)
+                return false;
+            ranges[first] = std::make_pair(last, prefix);
+        }
+
+        m_ranges = std::move(ranges);
+        return !m_ranges.empty();
+    }
+
+    bool SolutionIndexDirectory::save(std::string const& path, std::string const& stamp) const
+    {
+        std::error_code ec;
+        auto            parent = std::filesystem::path(path).parent_path();
+        if(!parent.empty())
+            std::filesystem::create_directories(parent, ec);
+
+        std::string tmpPath
+            = path + ".tmp."
+              + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+        {
+            std::ofstream file(tmpPath, std::ios::trunc);
+            if(!file)
+                return false;
+            file << DirectoryHeader << "\n" << stamp << "\n";
+            for(auto const& range : m_ranges)
+                file << range.first << " " << range.second.first << " " << range.second.second
+                     << "\n";
+            if(!file)
+            {
+                file.close();
+                std::remove(tmpPath.c_str());
+                return false;
+            }
+        }
+        if(std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    std::string SolutionIndexDirectory::SourceStamp(std::string const& libraryFile)
+    {
+        std::ifstream file(libraryFile, std::ios::binary);
+        if(!file)
+            return "";
+
+        uint64_t          size = 0, hash = FnvOffset;
+        std::vector<char> buffer(1 << 20);
+        while(file)
+        {
+            file.read(buffer.data(), buffer.size());
+            hash = fnv1a(buffer.data(), file.gcount(), hash);
+            size += file.gcount();
+        }
+        if(file.bad())
+            return "";
+
+        std::ostringstream stamp;
+        stamp << size << " " << std::hex << hash;
+        return stamp.str();
+    }
+
+    std::string SolutionIndexDirectory::UserCachePath(std::string const& libraryFile)
+    {
+        std::filesystem::path dir;
+        if(char const* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+            dir = xdg;
+        else if(char const* home = std::getenv("HOME"); home && *home)
+            dir = std::filesystem::path(home) / ".cache";
+        else
+            return "";
+
+        // Libraries of different installs share a name, so the path is part of the key
+        std::error_code ec;
+        auto            absolute = std::filesystem::absolute(libraryFile, ec).string();
+        if(ec)
+            absolute = libraryFile;
+
+        std::ostringstream name;
+        name << std::filesystem::path(libraryFile).filename().string() << "." << std::hex
+             << fnv1a(absolute.data(), absolute.size()) << ".index";
+        return (dir / "hipblaslt" / name.str()).string();
+    }
+} // namespace TensileLite
@@ -74,5 +74,12 @@ namespace TensileLite
         {
             return std::make_shared<HipAMDGPU>(prop);
         }
+
+        std::shared_ptr<Hardware> GetDevice(hipDeviceProp_t const& prop, int availableCUs)
+        {
+            auto device                       = std::make_shared<HipAMDGPU>(prop);
+            device->availableComputeUnitCount = availableCUs;
+            return device;
+        }
     } // namespace hip
 } // namespace TensileLite
@@ -27,10 +27,17 @@
 #include <hip/hip_ext.h>
 #include <hip/hip_runtime.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 
 #include <Tensile/Debug.hpp>
 #include <Tensile/EmbeddedData.hpp>
+#include <Tensile/Metrics.hpp>
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
 
@@ -44,14 +51,106 @@ namespace TensileLite
 {
     namespace hip
     {
+        namespace
+        {
+            using LoadClock = std::chrono::steady_clock;
+
+            double elapsedMs(LoadClock::time_point start, LoadClock::time_point stop)
+            {
+                return std::chrono::duration<double, std::milli>(stop - start).count();
+            }
+
+            // Loading is bound by the runtime more than by the cores, so more threads than
+            // this only add contention unless TENSILE_CODE_OBJECT_LOAD_THREADS asks for them
+            constexpr size_t DefaultLoadThreads = 16;
+
+            // Calls body(i) for every i in [0, count) from a pool of threads bound to the
+            // caller's device, and returns the number of threads used. Code objects differ a
+            // lot in size, so the threads take one index at a time. body records the errors of
+            // its item; an exception it lets through is rethrown on the calling thread once
+            // every thread has finished, instead of terminating the process.
+            template <typename Body>
+            size_t parallelLoad(size_t count, Body&& body)
+            {
+                size_t limit = Debug::Instance().getCodeObjectLoadThreads();
+                if(limit == 0)
+                    limit = std::min<size_t>(std::thread::hardware_concurrency(),
+                                             DefaultLoadThreads);
+                size_t threads = std::min(count, limit);
+                if(threads <= 1)
+                {
+                    for(size_t i = 0; i < count; i++)
+                        body(i);
+                    return 1;
+                }
+
+                int device = 0;
+                HIP_CHECK_PRINT(hipGetDevice(&device));
+
+                std::atomic<size_t>      next{0};
+                std::mutex               errorAccess;
+                std::exception_ptr       error;
+                std::vector<std::thread> pool;
+                pool.reserve(threads);
+                for(size_t t = 0; t < threads; t++)
+                    pool.emplace_back([&] {
+                        HIP_CHECK_PRINT(hipSetDevice(device));
+                        for(size_t i = next++; i < count; i = next++)
+                        {
+                            try
+                            {
+                                body(i);
+                            }
+                            catch(...)
+                            {
+                                std::lock_guard<std::mutex> guard(errorAccess);
+                                if(!error)
+                                    error = std::current_exception();
+                            }
+                        }
+                    });
+                for(auto& thread : pool)
+                    thread.join();
+                if(error)
+                    std::rethrow_exception(error);
+                return threads;
+            }
+
+            // Paths of the xnack variants of a code object file that exist, in the order
+            // they should be tried. Falls back to the plain name so loading reports the error.
+            std::vector<std::string> xnackVariants(std::string const& dir,
+                                                   std::string const& name)
+            {
+                size_t loc = name.rfind('.');
+                if(loc == std::string::npos)
+                    loc = name.size();
+
+                std::vector<std::string> rv;
+                for(auto ver : {"", "-xnack-", "-xnack+"})
+                {
+                    std::string candidate = name;
+                    candidate.insert(loc, ver);
+
+                    std::error_code ec;
+                    if(std::filesystem::exists(dir + candidate, ec))
+                        rv.push_back(dir + candidate);
+                }
+                if(rv.empty())
+                    rv.push_back(dir + name);
+                return rv;
+            }
+        }
+
         SolutionAdapter::SolutionAdapter()
             : m_debug(Debug::Instance().printKernelArguments())
             , m_debugSkipLaunch(Debug::Instance().skipKernelLaunch())
+            , m_codeObjectBudget(Debug::Instance().getCodeObjectBudget())
         {
         }
 
         SolutionAdapter::SolutionAdapter(bool debug)
             : m_debug(debug)
+            , m_codeObjectBudget(Debug::Instance().getCodeObjectBudget())
         {
             m_debug = debug || Debug::Instance().printKernelArguments();
         }
@@ -59,6 +158,7 @@ namespace TensileLite
         SolutionAdapter::SolutionAdapter(bool debug, std::string const& name)
             : m_debug(debug)
             , m_name(name)
+            , m_codeObjectBudget(Debug::Instance().getCodeObjectBudget())
         {
             m_debug = debug || Debug::Instance().printKernelArguments();
         }
@@ -66,8 +166,10 @@ namespace TensileLite
         SolutionAdapter::~SolutionAdapter()
         {
             Debug::Instance().markerStart("UnloadCodeObjectFiles");
-            for(auto module : m_modules)
-                HIP_CHECK_PRINT(hipModuleUnload(module));
+            for(auto const& event : m_streamEvents)
+                HIP_CHECK_PRINT(hipEventDestroy(event.second));
+            for(auto const& loaded : m_modules)
+                HIP_CHECK_PRINT(hipModuleUnload(loaded.module));
             Debug::Instance().markerStop();
         }
 
@@ -83,28 +185,272 @@ namespace TensileLite
 
         hipError_t SolutionAdapter::loadCodeObjectFile(std::string const& path)
         {
-            Debug::Instance().markerStart("loadCodeObjectFile", path);
-            hipModule_t module;
+            return loadCodeObjectFile(path, false);
+        }
 
-            HIP_CHECK_RETURN(hipModuleLoad(&module, path.c_str()));
+        hipError_t SolutionAdapter::loadCodeObjectFile(std::string const& path,
+                                                       bool               evictable,
+                                                       bool               canEvict)
+        {
+            ScopedMarker marker("loadCodeObjectFile", path);
+            hipModule_t  module;
+
+            {
+                ScopedMetricTimer timer(MetricTimer::CodeObjectLoading);
+                HIP_CHECK_RETURN(hipModuleLoad(&module, path.c_str()));
+            }
+            Metrics::Instance().increment(MetricCounter::CodeObjectsLoaded);
 
             if(m_debug)
                 std::cout << "loaded code object " << path << std::endl;
 
+            //Isolate filename
+            size_t start = path.rfind('/');
+            start        = (start == std::string::npos) ? 0 : start + 1;
+
+            std::string coFile = removeXnack(std::string(path.begin() + start, path.end()));
+
+            std::error_code ec;
+            size_t          bytes = std::filesystem::file_size(path, ec);
+            if(ec)
+                bytes = 0;
+
+            LoadedModule const* added = nullptr;
             {
                 std::lock_guard<std::mutex> guard(m_access);
-                m_modules.push_back(module);
-                m_loadedModuleNames.push_back(concatenate("File ", path));
+                if(evictable && m_loadedCOFiles.count(coFile))
+                {
+                    // Another thread loaded the same file while we were loading it.
+                    HIP_CHECK_PRINT(hipModuleUnload(module));
+                    return hipSuccess;
+                }
 
-                //Isolate filename
-                size_t start = path.rfind('/');
-                start        = (start == std::string::npos) ? 0 : start + 1;
-                m_loadedCOFiles.insert(removeXnack(std::string(path.begin() + start, path.end())));
+                added = addModule(module, coFile, bytes, evictable);
+                m_loadedModuleNames.push_back(concatenate("File ", path));
             }
-            Debug::Instance().markerStop();
+
+            if(evictable && canEvict && m_codeObjectBudget > 0)
+                enforceBudget(added);
+
             return hipSuccess;
         }
 
+        hipError_t SolutionAdapter::loadCodeObjectFiles(std::vector<std::string> const& paths)
+        {
+            ScopedMarker marker("loadCodeObjectFiles");
+
+            struct Loaded
+            {
+                hipModule_t module = nullptr;
+                hipError_t  error  = hipSuccess;
+                size_t      bytes  = 0;
+                double      readMs = 0;
+                double      loadMs = 0;
+            };
+
+            auto                start = LoadClock::now();
+            std::vector<Loaded> loaded(paths.size());
+
+            size_t threads = parallelLoad(paths.size(), [&](size_t i) {
+                auto& result = loaded[i];
+                auto  t0     = LoadClock::now();
+
+                try
+                {
+                    std::ifstream file(paths[i], std::ios::binary | std::ios::ate);
+                    if(!file)
+                    {
+                        result.error = hipErrorFileNotFound;
+                        return;
+                    }
+                    std::vector<char> image(file.tellg());
+                    file.seekg(0);
+                    file.read(image.data(), image.size());
+                    result.bytes = image.size();
+
+                    auto t1 = LoadClock::now();
+                    {
+                        ScopedMetricTimer timer(MetricTimer::CodeObjectLoading);
+                        result.error = hipModuleLoadData(&result.module, image.data());
+                    }
+                    auto t2 = LoadClock::now();
+
+                    result.readMs = elapsedMs(t0, t1);
+                    result.loadMs = elapsedMs(t1, t2);
+                    if(result.error == hipSuccess)
+                        Metrics::Instance().increment(MetricCounter::CodeObjectsLoaded);
+                }
+                catch(std::bad_alloc const&)
+                {
+                    result.error = hipErrorOutOfMemory;
+                }
+                catch(...)
+                {
+                    result.error = hipErrorUnknown;
+                }
+            });
+
+            hipError_t rv      = hipSuccess;
+            size_t     modules = 0;
+            {
+                std::lock_guard<std::mutex> guard(m_access);
+                for(size_t i = 0; i < paths.size(); i++)
+                {
+                    if(loaded[i].error != hipSuccess)
+                    {
+                        if(rv == hipSuccess)
+                            rv = loaded[i].error;
+                        continue;
+                    }
+
+                    //Isolate filename
+                    size_t start = paths[i].rfind('/');
+                    start        = (start == std::string::npos) ? 0 : start + 1;
+
+                    addModule(loaded[i].module,
+                              removeXnack(paths[i].substr(start)),
+                              loaded[i].bytes,
+                              false);
+                    m_loadedModuleNames.push_back(concatenate("File ",
+                                                              paths[i],
+                                                              " (read ",
+                                                              loaded[i].readMs,
+                                                              " ms, load ",
+                                                              loaded[i].loadMs,
+                                                              " ms)"));
+                    modules++;
+                }
+            }
+
+            if(m_debug || Debug::Instance().printCodeObjectInfo())
+            {
+                for(size_t i = 0; i < paths.size(); i++)
+                {
+                    if(loaded[i].error != hipSuccess)
+                        std::cout << "failed to load code object " << paths[i] << ": "
+                                  << hipGetErrorString(loaded[i].error) << std::endl;
+                    else
+                        std::cout << "loaded code object " << paths[i] << ": " << loaded[i].bytes
+                                  << " bytes, read " << loaded[i].readMs << " ms, load "
+                                  << loaded[i].loadMs << " ms" << std::endl;
+                }
+                std::cout << "loaded " << modules << " of " << paths.size() << " code objects in "
+                          << elapsedMs(start, LoadClock::now()) << " ms on " << threads
+                          << " threads" << std::endl;
+            }
+
+            return rv;
+        }
+
+        SolutionAdapter::LoadedModule* SolutionAdapter::addModule(hipModule_t        module,
+                                                                  std::string const& coFile,
+                                                                  size_t             bytes,
+                                                                  bool               evictable)
+        {
+            LoadedModule loaded;
+            loaded.module    = module;
+            loaded.coFile    = coFile;
+            loaded.bytes     = bytes;
+            loaded.lastUse   = ++m_useTick;
+            loaded.evictable = evictable;
+            m_modules.push_back(std::move(loaded));
+
+            if(!coFile.empty())
+                m_loadedCOFiles.insert(coFile);
+
+            m_stats.loadedModules++;
+            m_stats.residentBytes += bytes;
+            if(evictable && m_evictedCOFiles.erase(coFile))
+                m_stats.reloads++;
+
+            return &m_modules.back();
+        }
+
+        void SolutionAdapter::enforceBudget(LoadedModule const* keep)
+        {
+            // Unloading is rare and already on the slow load path: block launches from
+            // this adapter and wait for its last launch on every stream it used, so no
+            // evicted kernel is still in flight. Work from other libraries is not waited for.
+            std::unique_lock<std::shared_mutex> residency(m_residency);
+            std::lock_guard<std::mutex>         guard(m_access);
+
+            if(m_stats.residentBytes <= m_codeObjectBudget)
+                return;
+
+            for(auto const& event : m_streamEvents)
+                HIP_CHECK_PRINT(hipEventSynchronize(event.second));
+
+            while(m_stats.residentBytes > m_codeObjectBudget)
+            {
+                auto victim = m_modules.end();
+                for(auto it = m_modules.begin(); it != m_modules.end(); it++)
+                {
+                    if(!it->evictable || &*it == keep)
+                        continue;
+                    if(victim == m_modules.end() || it->lastUse < victim->lastUse)
+                        victim = it;
+                }
+
+                if(victim == m_modules.end())
+                    break;
+
+                for(auto it = m_kernels.begin(); it != m_kernels.end();)
+                {
+                    if(it->second.owner == &*victim)
+                        it = m_kernels.erase(it);
+                    else
+                        it++;
+                }
+
+                HIP_CHECK_PRINT(hipModuleUnload(victim->module));
+                Metrics::Instance().increment(MetricCounter::CodeObjectsEvicted);
+
+                if(m_debug)
+                    std::cout << "evicted code object " << victim->coFile << std::endl;
+
+                m_loadedCOFiles.erase(victim->coFile);
+                m_evictedCOFiles.insert(victim->coFile);
+
+                m_stats.loadedModules--;
+                m_stats.residentBytes -= victim->bytes;
+                m_stats.evictedModules++;
+                m_stats.evictedBytes += victim->bytes;
+
+                m_modules.erase(victim);
+            }
+        }
+
+        SolutionAdapter::ResidencyStats SolutionAdapter::residencyStats() const
+        {
+            std::lock_guard<std::mutex> guard(m_access);
+            return m_stats;
+        }
+
+        void SolutionAdapter::setCodeObjectBudget(size_t bytes)
+        {
+            m_codeObjectBudget = bytes;
+        }
+
+        void SolutionAdapter::recordLaunch(LoadedModule* owner, hipStream_t stream)
+        {
+            hipStreamCaptureStatus status = hipStreamCaptureStatusNone;
+            HIP_CHECK_PRINT(hipStreamIsCapturing(stream, &status));
+
+            std::lock_guard<std::mutex> guard(m_access);
+            if(status != hipStreamCaptureStatusNone)
+            {
+                // A graph now holds this kernel handle and may be replayed at any time
+                if(owner)
+                    owner->evictable = false;
+                return;
+            }
+
+            auto& event = m_streamEvents[stream];
+            if(event == nullptr)
+                HIP_CHECK_PRINT(hipEventCreateWithFlags(&event, hipEventDisableTiming));
+            HIP_CHECK_PRINT(hipEventRecord(event, stream));
+        }
+
         hipError_t SolutionAdapter::loadCodeObjectBytes(std::vector<uint8_t> const& bytes)
         {
             return loadCodeObject(bytes.data());
@@ -112,16 +458,21 @@ namespace TensileLite
 
         hipError_t SolutionAdapter::loadCodeObject(const void* image)
         {
-            hipModule_t module;
+            ScopedMarker marker("loadCodeObject");
+            hipModule_t  module;
 
-            HIP_CHECK_RETURN(hipModuleLoadData(&module, image));
+            {
+                ScopedMetricTimer timer(MetricTimer::CodeObjectLoading);
+                HIP_CHECK_RETURN(hipModuleLoadData(&module, image));
+            }
+            Metrics::Instance().increment(MetricCounter::CodeObjectsLoaded);
 
             if(m_debug)
                 std::cout << "loaded code object data." << std::endl;
 
             {
                 std::lock_guard<std::mutex> guard(m_access);
-                m_modules.push_back(module);
+                addModule(module, "", 0, false);
                 m_loadedModuleNames.push_back("Module from bytes");
             }
             return hipSuccess;
@@ -149,39 +500,72 @@ namespace TensileLite
                 return;
             }
 
-            std::vector<hipModule_t> newModules;
-            newModules.reserve(embeddedData.size());
+            auto                     start = LoadClock::now();
+            std::vector<hipModule_t> newModules(embeddedData.size(), nullptr);
+            std::vector<double>      loadMs(embeddedData.size(), 0);
 
-            for(size_t i = 0; i < embeddedData.size(); i++)
-            {
-                hipModule_t nextModule;
+            size_t threads = parallelLoad(embeddedData.size(), [&](size_t i) {
+                auto t0 = LoadClock::now();
                 try
                 {
-                    auto error = hipModuleLoadData(&nextModule, embeddedData[i].data());
+                    hipModule_t nextModule;
+                    hipError_t  error;
+                    {
+                        ScopedMetricTimer timer(MetricTimer::CodeObjectLoading);
+                        error = hipModuleLoadData(&nextModule, embeddedData[i].data());
+                    }
 
                     if(error == hipErrorUnknown || error == hipErrorSharedObjectInitFailed)
-                        continue;
-                    newModules.push_back(nextModule);
+                        return;
                     HIP_CHECK_EXC(error);
-
-                    if(m_debug)
-                        std::cout << "Loaded code object for key " << key << std::endl;
+                    newModules[i] = nextModule;
+                    Metrics::Instance().increment(MetricCounter::CodeObjectsLoaded);
                 }
-                catch(std::runtime_error const& exc)
+                catch(std::exception const& exc)
                 {
                     std::cout << exc.what() << std::endl;
                 }
-            }
+                catch(...)
+                {
+                    std::cout << "Unknown error loading embedded code object " << i << std::endl;
+                }
+                loadMs[i] = elapsedMs(t0, LoadClock::now());
+            });
 
+            size_t modules = 0;
             {
                 std::lock_guard<std::mutex> guard(m_access);
-                m_modules.insert(m_modules.end(), newModules.begin(), newModules.end());
+                for(auto module : newModules)
+                {
+                    if(module == nullptr)
+                        continue;
+                    addModule(module, "", 0, false);
+                    modules++;
+                }
                 m_loadedModuleNames.push_back(
-                    concatenate("Embedded code object ", key, " (", newModules.size(), ")"));
+                    concatenate("Embedded code object ", key, " (", modules, ")"));
+            }
+
+            if(m_debug || Debug::Instance().printCodeObjectInfo())
+            {
+                for(size_t i = 0; i < newModules.size(); i++)
+                {
+                    if(newModules[i] != nullptr)
+                        std::cout << "Loaded embedded code object " << i << " for key " << key
+                                  << " in " << loadMs[i] << " ms" << std::endl;
+                }
+                std::cout << "Loaded " << modules << " of " << newModules.size()
+                          << " embedded code objects in " << elapsedMs(start, LoadClock::now())
+                          << " ms on " << threads << " threads" << std::endl;
             }
         }
 
         bool SolutionAdapter::FindCodeObject(std::string const& codeObjectFile)
+        {
+            return FindCodeObject(codeObjectFile, true);
+        }
+
+        bool SolutionAdapter::FindCodeObject(std::string const& codeObjectFile, bool canEvict)
         {
             //If required code object file hasn't yet been loaded, load it now
             m_access.lock();
@@ -192,17 +576,10 @@ namespace TensileLite
 
             if(!loaded)
             {
-                //Try other xnack versions
-                size_t     loc = codeObjectFile.rfind('.');
-                hipError_t err;
-
-                for(auto ver : {"", "-xnack-", "-xnack+"})
+                //Try the xnack versions that exist
+                for(auto const& path : xnackVariants(codeObjectDir, codeObjectFile))
                 {
-                    std::string modifiedCOName = codeObjectFile;
-                    modifiedCOName.insert(loc, ver);
-                    err = loadCodeObjectFile(codeObjectDir + modifiedCOName);
-
-                    if(err == hipSuccess)
+                    if(loadCodeObjectFile(path, true, canEvict) == hipSuccess)
                         break;
                 }
                 return false;
@@ -231,7 +608,9 @@ namespace TensileLite
             return hipSuccess;
         }
 
-        hipError_t SolutionAdapter::getKernel(hipFunction_t& rv, std::string const& name)
+        hipError_t SolutionAdapter::getKernel(hipFunction_t&     rv,
+                                              std::string const& name,
+                                              LoadedModule**     owner)
         {
             std::unique_lock<std::mutex> guard(m_access);
             hipError_t                   err = hipErrorNotFound;
@@ -239,17 +618,24 @@ namespace TensileLite
             auto it = m_kernels.find(name);
             if(it != m_kernels.end())
             {
-                rv = it->second;
+                rv = it->second.function;
+                if(it->second.owner)
+                    it->second.owner->lastUse = ++m_useTick;
+                if(owner)
+                    *owner = it->second.owner;
                 return hipSuccess;
             }
 
-            for(auto module : m_modules)
+            for(auto& loaded : m_modules)
             {
-                err = hipModuleGetFunction(&rv, module, name.c_str());
+                err = hipModuleGetFunction(&rv, loaded.module, name.c_str());
 
                 if(err == hipSuccess)
                 {
-                    m_kernels[name] = rv;
+                    loaded.lastUse  = ++m_useTick;
+                    m_kernels[name] = {rv, &loaded};
+                    if(owner)
+                        *owner = &loaded;
                     return err;
                 }
                 else if(err != hipErrorNotFound)
@@ -285,12 +671,11 @@ namespace TensileLite
 
             if(!loaded)
             {
-                hipError_t err;
-                //Try xnack variations
-                for(auto ver : {"", "-xnack-", "-xnack+"})
+                hipError_t err = hipErrorFileNotFound;
+                //Try the xnack variations that exist
+                for(auto const& path : xnackVariants(codeObjectDir, helperKernelName + ".hsaco"))
                 {
-                    std::string modifiedCOName = helperKernelName + ver + ".hsaco";
-                    err                        = loadCodeObjectFile(codeObjectDir + modifiedCOName);
+                    err = loadCodeObjectFile(path);
 
                     if(err == hipSuccess)
                         return err;
@@ -313,9 +698,23 @@ namespace TensileLite
                                                  hipEvent_t              stopEvent,
                                                  bool                    isKernelLoaded)
         {
-            if(!isKernelLoaded && !kernel.codeObjectFile.empty())
+            ScopedMarker marker("launchKernel", kernel.kernelName);
+
+            // With a residency budget the code object may have been evicted since it was
+            // last checked, so the caller's isKernelLoaded hint cannot be trusted. Nothing is
+            // evicted while the stream is capturing: waiting for other work would invalidate
+            // the capture.
+            bool budgeted  = m_codeObjectBudget > 0;
+            bool capturing = false;
+            if(budgeted)
             {
-                FindCodeObject(kernel.codeObjectFile);
+                hipStreamCaptureStatus status = hipStreamCaptureStatusNone;
+                HIP_CHECK_RETURN(hipStreamIsCapturing(stream, &status));
+                capturing = status != hipStreamCaptureStatusNone;
+            }
+            if((budgeted || !isKernelLoaded) && !kernel.codeObjectFile.empty())
+            {
+                FindCodeObject(kernel.codeObjectFile, !capturing);
             }
 
             if(m_debug)
@@ -335,8 +734,22 @@ namespace TensileLite
                 return hipSuccess;
             }
 
+            std::shared_lock<std::shared_mutex> residency(m_residency, std::defer_lock);
+            if(budgeted)
+                residency.lock();
+
             hipFunction_t function;
-            HIP_CHECK_RETURN(getKernel(function, kernel.kernelName));
+            LoadedModule* owner = nullptr;
+            hipError_t    err   = getKernel(function, kernel.kernelName, &owner);
+            if(err == hipErrorNotFound && budgeted && !kernel.codeObjectFile.empty())
+            {
+                // Evicted by another thread between FindCodeObject and the lookup
+                residency.unlock();
+                FindCodeObject(kernel.codeObjectFile, !capturing);
+                residency.lock();
+                err = getKernel(function, kernel.kernelName, &owner);
+            }
+            HIP_CHECK_RETURN(err);
 
             void*  kernelArgs = const_cast<void*>(kernel.args.data());
             size_t argsSize   = kernel.args.size();
@@ -349,20 +762,26 @@ namespace TensileLite
 
             if(startEvent != nullptr)
                 HIP_CHECK_RETURN(hipEventRecord(startEvent, stream));
-            HIP_CHECK_RETURN(hipExtModuleLaunchKernel(function,
-                                                      kernel.numWorkItems.x,
-                                                      kernel.numWorkItems.y,
-                                                      kernel.numWorkItems.z,
-                                                      kernel.workGroupSize.x,
-                                                      kernel.workGroupSize.y,
-                                                      kernel.workGroupSize.z,
-                                                      kernel.sharedMemBytes, // sharedMem
-                                                      stream, // stream
-                                                      nullptr,
-                                                      (void**)&hipLaunchParams,
-                                                      nullptr, // event
-                                                      nullptr // event
-                                                      ));
+            {
+                ScopedMetricTimer timer(MetricTimer::KernelLaunch);
+                HIP_CHECK_RETURN(hipExtModuleLaunchKernel(function,
+                                                          kernel.numWorkItems.x,
+                                                          kernel.numWorkItems.y,
+                                                          kernel.numWorkItems.z,
+                                                          kernel.workGroupSize.x,
+                                                          kernel.workGroupSize.y,
+                                                          kernel.workGroupSize.z,
+                                                          kernel.sharedMemBytes, // sharedMem
+                                                          stream, // stream
+                                                          nullptr,
+                                                          (void**)&hipLaunchParams,
+                                                          nullptr, // event
+                                                          nullptr // event
+                                                          ));
+                Metrics::Instance().increment(MetricCounter::KernelsLaunched);
+            }
+            if(budgeted)
+                recordLaunch(owner, stream);
             if(stopEvent != nullptr)
                 HIP_CHECK_RETURN(hipEventRecord(stopEvent, stream));
             return hipSuccess;
@@ -370,6 +789,7 @@ namespace TensileLite
 
         hipError_t SolutionAdapter::launchKernels(std::vector<KernelInvocation> const& kernels)
         {
+            ScopedMarker marker("launchKernels");
             for(auto const& k : kernels)
             {
                 HIP_CHECK_RETURN(launchKernel(k));
@@ -383,6 +803,8 @@ namespace TensileLite
                                                   hipEvent_t                           stopEvent,
                                                   bool                                 isKernelLoaded)
         {
+            ScopedMarker marker("launchKernels");
+
             auto first = kernels.begin();
             auto last  = kernels.end() - 1;
 
@@ -406,6 +828,7 @@ namespace TensileLite
                                                   std::vector<hipEvent_t> const&       startEvents,
                                                   std::vector<hipEvent_t> const&       stopEvents)
         {
+            ScopedMarker marker("launchKernels");
             if(kernels.size() != startEvents.size() || kernels.size() != stopEvents.size())
                 throw std::runtime_error(concatenate("Must have an equal number of kernels (",
                                                      kernels.size(),
@@ -435,8 +858,13 @@ namespace TensileLite
                 stream << "]";
             }
 
-            stream << " (" << adapter.name() << ", " << adapter.m_modules.size()
-                   << " total modules)" << std::endl;
+            auto stats = adapter.residencyStats();
+            stream << " (" << adapter.name() << ", " << stats.loadedModules << " total modules";
+            if(adapter.m_codeObjectBudget > 0 || stats.evictedModules > 0)
+                stream << ", " << stats.residentBytes << " resident bytes, "
+                       << stats.evictedModules << " evicted (" << stats.evictedBytes
+                       << " bytes), " << stats.reloads << " reloads";
+            stream << ")" << std::endl;
 
             return stream;
         }